@@ -0,0 +1,76 @@
+//
+// Host stand-in for the FatFs API, backed by stdio. Only the calls made by
+// the engine are provided; paths are passed straight to the host filesystem.
+//
+
+#ifndef SIDPOD_HOST_FF_H
+#define SIDPOD_HOST_FF_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define FF_LFN_BUF  255
+#define FF_SFN_BUF  12
+
+typedef char TCHAR;
+typedef unsigned char BYTE;
+typedef unsigned int UINT;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef uint32_t FSIZE_t;
+
+typedef enum {
+    FR_OK = 0,
+    FR_DISK_ERR,
+    FR_INT_ERR,
+    FR_NOT_READY,
+    FR_NO_FILE,
+    FR_NO_PATH,
+    FR_INVALID_NAME,
+    FR_DENIED,
+    FR_EXIST,
+    FR_INVALID_OBJECT
+} FRESULT;
+
+#define FA_READ             0x01
+#define FA_WRITE            0x02
+#define FA_OPEN_EXISTING    0x00
+#define FA_CREATE_NEW       0x04
+#define FA_CREATE_ALWAYS    0x08
+#define FA_OPEN_ALWAYS      0x10
+#define FA_OPEN_APPEND      0x30
+
+#define AM_DIR              0x10
+#define AM_HID              0x02
+
+typedef struct {
+    FILE *fp;
+    FSIZE_t fsize;
+} FIL;
+
+typedef struct {
+    void *handle;
+} DIR;
+
+typedef struct {
+    FSIZE_t fsize;
+    BYTE fattrib;
+    TCHAR altname[FF_SFN_BUF + 1];
+    TCHAR fname[FF_LFN_BUF + 1];
+} FILINFO;
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode);
+
+FRESULT f_close(FIL *fp);
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br);
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw);
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs);
+
+FSIZE_t f_tell(FIL *fp);
+
+#define f_size(fp) ((fp)->fsize)
+
+#endif //SIDPOD_HOST_FF_H
@@ -0,0 +1,14 @@
+//
+// Host stand-in for hardware/flash.h, giving platform_config.h its constants.
+//
+
+#ifndef SIDPOD_HOST_HARDWARE_FLASH_H
+#define SIDPOD_HOST_HARDWARE_FLASH_H
+
+#define FLASH_SECTOR_SIZE       (1u << 12)
+#define XIP_BASE                0x10000000
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES   (8 * 1024 * 1024)
+#endif
+
+#endif //SIDPOD_HOST_HARDWARE_FLASH_H
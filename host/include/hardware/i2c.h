@@ -0,0 +1,23 @@
+//
+// Host stand-in for the I2C API. sidpod-render -d implements the write with
+// a mock SSD1306 that keeps the display RAM, to check what the driver sends.
+//
+
+#ifndef SIDPOD_HOST_HARDWARE_I2C_H
+#define SIDPOD_HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct i2c_inst i2c_inst_t;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIDPOD_HOST_HARDWARE_I2C_H
@@ -0,0 +1,38 @@
+//
+// Host stand-in for the RP2040 IRQ API. Only the SIO FIFO interrupt used for
+// cross-core rendering is modelled.
+//
+
+#ifndef SIDPOD_HOST_HARDWARE_IRQ_H
+#define SIDPOD_HOST_HARDWARE_IRQ_H
+
+typedef void (*irq_handler_t)();
+
+enum {
+    SIO_IRQ_PROC0 = 15,
+    SIO_IRQ_PROC1 = 16
+};
+
+inline irq_handler_t sio_irq_proc0_handler = nullptr;
+inline bool sio_irq_proc0_enabled = false;
+
+inline void irq_set_exclusive_handler(unsigned num, irq_handler_t handler) {
+    if (num == SIO_IRQ_PROC0) {
+        sio_irq_proc0_handler = handler;
+    }
+}
+
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+inline void irq_add_shared_handler(unsigned num, irq_handler_t handler, unsigned order_priority) {
+    (void) order_priority;
+    irq_set_exclusive_handler(num, handler);
+}
+
+inline void irq_set_enabled(unsigned num, bool enabled) {
+    if (num == SIO_IRQ_PROC0) {
+        sio_irq_proc0_enabled = enabled;
+    }
+}
+
+#endif //SIDPOD_HOST_HARDWARE_IRQ_H
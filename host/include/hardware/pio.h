@@ -0,0 +1,8 @@
+//
+// Host stand-in for hardware/pio.h. Nothing in the engine needs it.
+//
+
+#ifndef SIDPOD_HOST_HARDWARE_PIO_H
+#define SIDPOD_HOST_HARDWARE_PIO_H
+
+#endif //SIDPOD_HOST_HARDWARE_PIO_H
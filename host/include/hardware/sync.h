@@ -0,0 +1,38 @@
+//
+// Host stand-in for the RP2040 memory barrier and spin locks. There is only
+// one thread, so a spin lock is never contended.
+//
+
+#ifndef SIDPOD_HOST_HARDWARE_SYNC_H
+#define SIDPOD_HOST_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+inline void __dmb() {
+    __sync_synchronize();
+}
+
+typedef volatile uint32_t spin_lock_t;
+
+inline spin_lock_t host_spin_locks[32];
+
+inline int spin_lock_claim_unused(bool required) {
+    (void) required;
+    return 0;
+}
+
+inline spin_lock_t *spin_lock_init(unsigned lock_num) {
+    return &host_spin_locks[lock_num];
+}
+
+inline uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    *lock = 1;
+    return 0;
+}
+
+inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq) {
+    (void) saved_irq;
+    *lock = 0;
+}
+
+#endif //SIDPOD_HOST_HARDWARE_SYNC_H
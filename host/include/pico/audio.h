@@ -0,0 +1,39 @@
+//
+// Host stand-in for the pico-extras audio buffer types used by the engine.
+//
+
+#ifndef SIDPOD_HOST_PICO_AUDIO_H
+#define SIDPOD_HOST_PICO_AUDIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AUDIO_BUFFER_FORMAT_PCM_S16 1
+
+typedef struct mem_buffer {
+    size_t size;
+    uint8_t *bytes;
+    uint8_t flags;
+} mem_buffer_t;
+
+typedef struct audio_format {
+    uint32_t sample_freq;
+    uint16_t format;
+    uint16_t channel_count;
+} audio_format_t;
+
+typedef struct audio_buffer_format {
+    const audio_format_t *format;
+    uint16_t sample_stride;
+} audio_buffer_format_t;
+
+typedef struct audio_buffer {
+    mem_buffer_t *buffer;
+    const audio_buffer_format_t *format;
+    uint32_t sample_count;
+    uint32_t max_sample_count;
+    uint32_t user_data;
+    struct audio_buffer *next;
+} audio_buffer_t;
+
+#endif //SIDPOD_HOST_PICO_AUDIO_H
@@ -0,0 +1,8 @@
+//
+// Host stand-in for the binary info macros, which have nothing to record.
+//
+
+#ifndef SIDPOD_HOST_PICO_BINARY_INFO_H
+#define SIDPOD_HOST_PICO_BINARY_INFO_H
+
+#endif //SIDPOD_HOST_PICO_BINARY_INFO_H
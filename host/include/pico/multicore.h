@@ -0,0 +1,58 @@
+//
+// Host stand-in for the RP2040 inter-core FIFOs. There is only one thread, so
+// a push from core 1 runs the core 0 SIO interrupt handler right away, and
+// then core0_loop, as if core 0 got to its main loop before core 1 carried on.
+// Whatever core 0 pushes back is waiting when core 1 pops.
+//
+
+#ifndef SIDPOD_HOST_PICO_MULTICORE_H
+#define SIDPOD_HOST_PICO_MULTICORE_H
+
+#include <stdint.h>
+#include <deque>
+
+#include "hardware/irq.h"
+
+inline std::deque<uint32_t> fifo_to_core0;
+inline std::deque<uint32_t> fifo_to_core1;
+inline bool running_on_core0 = false;
+inline void (*core0_loop)() = nullptr;
+
+inline bool multicore_fifo_rvalid() {
+    return !(running_on_core0 ? fifo_to_core0 : fifo_to_core1).empty();
+}
+
+inline void multicore_fifo_clear_irq() {
+}
+
+inline bool multicore_fifo_wready() {
+    return true;
+}
+
+inline void multicore_fifo_push_blocking(uint32_t data) {
+    if (running_on_core0) {
+        fifo_to_core1.push_back(data);
+        return;
+    }
+    fifo_to_core0.push_back(data);
+    if (sio_irq_proc0_enabled && sio_irq_proc0_handler) {
+        running_on_core0 = true;
+        sio_irq_proc0_handler();
+        if (core0_loop) {
+            core0_loop();
+        }
+        running_on_core0 = false;
+    }
+}
+
+inline uint32_t multicore_fifo_pop_blocking() {
+    std::deque<uint32_t> &fifo = running_on_core0 ? fifo_to_core0 : fifo_to_core1;
+    if (fifo.empty()) {
+        return 0;
+    }
+    const uint32_t data = fifo.front();
+    fifo.pop_front();
+    return data;
+}
+
+#endif //SIDPOD_HOST_PICO_MULTICORE_H
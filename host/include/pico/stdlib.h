@@ -0,0 +1,18 @@
+//
+// Host stand-in for the parts of the pico standard library the display
+// driver uses. There is no scratch RAM bank to place data in.
+//
+
+#ifndef SIDPOD_HOST_PICO_STDLIB_H
+#define SIDPOD_HOST_PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+#define __scratch_y(group)
+
+#endif //SIDPOD_HOST_PICO_STDLIB_H
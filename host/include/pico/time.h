@@ -0,0 +1,17 @@
+//
+// Host stand-in for the microsecond timer of the pico time API.
+//
+
+#ifndef SIDPOD_HOST_PICO_TIME_H
+#define SIDPOD_HOST_PICO_TIME_H
+
+#include <stdint.h>
+#include <chrono>
+
+inline uint32_t time_us_32() {
+    static const auto start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+#endif //SIDPOD_HOST_PICO_TIME_H
@@ -0,0 +1,28 @@
+//
+// Host implementation of the System calls the engine depends on.
+//
+
+#include <chrono>
+
+#include "System.h"
+
+uint32_t System::millis_now() {
+    static const auto start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+// There is only one thread, which is core0 as far as the file system goes.
+bool System::runOnCore0(bool (*job)(void *), void *arg) {
+    return job(arg);
+}
+
+static bool jobResult = false;
+
+void System::startOnCore0(bool (*job)(void *), void *arg) {
+    jobResult = job(arg);
+}
+
+bool System::waitForCore0() {
+    return jobResult;
+}
@@ -0,0 +1,57 @@
+//
+// stdio implementation of the FatFs subset declared in host/include/ff.h.
+//
+
+#include "ff.h"
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode) {
+    const char *stdioMode = "rb";
+    if (mode & FA_WRITE) {
+        if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+            stdioMode = "ab";
+        } else if (mode & (FA_CREATE_ALWAYS | FA_CREATE_NEW | FA_OPEN_ALWAYS)) {
+            stdioMode = (mode & FA_READ) ? "w+b" : "wb";
+        } else {
+            stdioMode = "r+b";
+        }
+    }
+    fp->fp = fopen(path, stdioMode);
+    if (!fp->fp) {
+        return FR_NO_FILE;
+    }
+    fseek(fp->fp, 0, SEEK_END);
+    fp->fsize = static_cast<FSIZE_t>(ftell(fp->fp));
+    fseek(fp->fp, 0, SEEK_SET);
+    return FR_OK;
+}
+
+FRESULT f_close(FIL *fp) {
+    if (!fp->fp) {
+        return FR_INVALID_OBJECT;
+    }
+    fclose(fp->fp);
+    fp->fp = nullptr;
+    return FR_OK;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br) {
+    *br = static_cast<UINT>(fread(buff, 1, btr, fp->fp));
+    return ferror(fp->fp) ? FR_DISK_ERR : FR_OK;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw) {
+    *bw = static_cast<UINT>(fwrite(buff, 1, btw, fp->fp));
+    const long position = ftell(fp->fp);
+    if (position > static_cast<long>(fp->fsize)) {
+        fp->fsize = static_cast<FSIZE_t>(position);
+    }
+    return *bw == btw ? FR_OK : FR_DISK_ERR;
+}
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs) {
+    return fseek(fp->fp, static_cast<long>(ofs), SEEK_SET) == 0 ? FR_OK : FR_DISK_ERR;
+}
+
+FSIZE_t f_tell(FIL *fp) {
+    return static_cast<FSIZE_t>(ftell(fp->fp));
+}
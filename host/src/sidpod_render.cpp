@@ -0,0 +1,1034 @@
+//
+// sidpod-render: runs the SIDPod C64/reSID engine natively, renders a tune
+// to a WAV file and reports what the play routine and the SID emulation cost.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "AudioLead.h"
+#include "AudioStats.h"
+#include "C64.h"
+#include "kiss_fftr.h"
+#include "Mixer.h"
+#include "pico/multicore.h"
+#include "platform_config.h"
+#include "reSID/wave.h"
+#include "reSID/wave_resolve.h"
+#include "ssd1306.h"
+#include "VisualizationCapture.h"
+#include "visualization/FixedFFT.h"
+#include "visualization/RegisterSpectrum.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t MAX_WATCHDOG_ABORTS = 50;
+
+    struct Options {
+        char *sidFile = nullptr;
+        const char *wavFile = nullptr;
+        int song = 0;
+        double seconds = 60;
+        bool samplingForced = false;
+        sampling_method sampling = SAMPLE_FAST;
+        bool benchmark = false;
+        bool compare = false;
+        bool waveforms = false;
+        bool display = false;
+        bool audioStats = false;
+        bool spectrum = false;
+        const char *traceFile = nullptr;
+        const char *poolTrace = nullptr;
+        double traceScale = 1;
+        uint32_t sampleRate = 0;
+        const char *recordStream = nullptr;
+        const char *playStream = nullptr;
+        double seekSeconds = 0;
+        const char *saveSnapshot = nullptr;
+        const char *loadSnapshot = nullptr;
+    };
+
+    // One buffer of a render trace: its length and how long it took to render.
+    struct TraceEntry {
+        uint32_t samples;
+        double renderUs;
+    };
+
+    struct SamplingMethodName {
+        const char *name;
+        sampling_method method;
+    };
+
+    constexpr SamplingMethodName SAMPLING_METHODS[] = {
+        {"fast", SAMPLE_FAST},
+        {"interpolate", SAMPLE_INTERPOLATE},
+        {"resample", SAMPLE_RESAMPLE},
+    };
+
+    struct RenderStats {
+        double playSeconds = 0;
+        double renderSeconds = 0;
+        double totalSeconds = 0;
+        uint64_t instructions = 0;
+        uint64_t cpuCycles = 0;
+        uint32_t maxInstructions = 0;
+        uint32_t frames = 0;
+        uint64_t playCalls = 0;
+        uint32_t watchdogAborts = 0;
+        std::vector<TraceEntry> trace;
+        // Spectrum windows the visualization could take, how long the
+        // register spectrum of each took, and how often its loudest bar was
+        // within two bins of the loudest bar of the FFT, as drawn and by
+        // magnitude. Also how often the FFT was loudest in its lowest bar,
+        // which the register spectrum has no DC or envelope steps for.
+        uint32_t spectrumWindows = 0;
+        double registerSpectrumSeconds = 0;
+        uint32_t peaksMatched = 0;
+        uint32_t magnitudePeaksMatched = 0;
+        uint32_t fftPeaksLowest = 0;
+    };
+
+    void usage() {
+        fprintf(stderr, "usage: sidpod-render [-o out.wav] [-s song] [-t seconds] "
+                        "[-m fast|interpolate|resample] [-f rate] [-j seconds] [-a] [-b] [-c] [-v]\n"
+                        "                     [-r trace.txt] [-R out.sidstream | -P in.sidstream] [-S out.snapshot] file.sid\n"
+                        "       sidpod-render [-o out.wav] [-t seconds] [-S out.snapshot] -L in.snapshot\n"
+                        "       sidpod-render -w\n"
+                        "       sidpod-render -d\n"
+                        "       sidpod-render [-f rate] [-x scale] -p trace.txt\n"
+                        "  -f  output sample rate: 22050, 32000, 44100 or 48000\n"
+                        "  -j  seek this far into the song before rendering, and report the seek speed\n"
+                        "  -a  print the audio core statistics the firmware dumps over UART\n"
+                        "  -b  benchmark every sampling method instead of rendering once\n"
+                        "  -c  check that block clocking renders the same samples as per sample clocking\n"
+                        "  -v  check and benchmark the fixed point spectrum FFT on the rendered song\n"
+                        "  -w  check and benchmark the packed combined waveform tables\n"
+                        "  -d  check the display driver's partial updates against a mock controller\n"
+                        "  -r  write the render time of every buffer to a trace\n"
+                        "  -p  play a render trace through I2S queues of every depth, with render times scaled by -x\n"
+                        "  -R  record the SID writes of the song to a register stream\n"
+                        "  -P  play the song from a register stream instead of running the 6502\n"
+                        "  -S  save a snapshot of the emulation once rendering is done\n"
+                        "  -L  carry on from a snapshot instead of loading a tune\n");
+    }
+
+    bool parseSamplingMethod(const char *name, sampling_method &method) {
+        for (const auto &entry: SAMPLING_METHODS) {
+            if (!strcmp(name, entry.name)) {
+                method = entry.method;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseArguments(int argc, char **argv, Options &options) {
+        for (int i = 1; i < argc; i++) {
+            if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+                options.wavFile = argv[++i];
+            } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+                options.song = atoi(argv[++i]);
+            } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+                options.seconds = atof(argv[++i]);
+            } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+                if (!parseSamplingMethod(argv[++i], options.sampling)) {
+                    return false;
+                }
+                options.samplingForced = true;
+            } else if (!strcmp(argv[i], "-a")) {
+                options.audioStats = true;
+            } else if (!strcmp(argv[i], "-b")) {
+                options.benchmark = true;
+            } else if (!strcmp(argv[i], "-c")) {
+                options.compare = true;
+            } else if (!strcmp(argv[i], "-v")) {
+                options.spectrum = true;
+            } else if (!strcmp(argv[i], "-w")) {
+                options.waveforms = true;
+            } else if (!strcmp(argv[i], "-d")) {
+                options.display = true;
+            } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+                options.traceFile = argv[++i];
+            } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+                options.poolTrace = argv[++i];
+            } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+                options.sampleRate = strtoul(argv[++i], nullptr, 10);
+                if (!C64::setSampleRate(options.sampleRate)) {
+                    return false;
+                }
+            } else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+                options.seekSeconds = atof(argv[++i]);
+            } else if (!strcmp(argv[i], "-S") && i + 1 < argc) {
+                options.saveSnapshot = argv[++i];
+            } else if (!strcmp(argv[i], "-L") && i + 1 < argc) {
+                options.loadSnapshot = argv[++i];
+            } else if (!strcmp(argv[i], "-R") && i + 1 < argc) {
+                options.recordStream = argv[++i];
+            } else if (!strcmp(argv[i], "-P") && i + 1 < argc) {
+                options.playStream = argv[++i];
+            } else if (!strcmp(argv[i], "-x") && i + 1 < argc) {
+                options.traceScale = atof(argv[++i]);
+            } else if (argv[i][0] != '-' && !options.sidFile) {
+                options.sidFile = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return options.sidFile != nullptr || options.waveforms || options.display || options.poolTrace ||
+               options.loadSnapshot;
+    }
+
+    void writeLE(FILE *file, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            fputc(static_cast<int>(value >> (8 * i) & 0xff), file);
+        }
+    }
+
+    bool writeWav(const char *fileName, const std::vector<short> &samples, uint32_t sampleRate, int channels) {
+        FILE *file = fopen(fileName, "wb");
+        if (!file) {
+            return false;
+        }
+        const auto dataBytes = static_cast<uint32_t>(samples.size() * sizeof(short));
+        fwrite("RIFF", 1, 4, file);
+        writeLE(file, 36 + dataBytes, 4);
+        fwrite("WAVEfmt ", 1, 8, file);
+        writeLE(file, 16, 4);
+        writeLE(file, 1, 2);
+        writeLE(file, channels, 2);
+        writeLE(file, sampleRate, 4);
+        writeLE(file, sampleRate * channels * sizeof(short), 4);
+        writeLE(file, channels * sizeof(short), 2);
+        writeLE(file, 16, 2);
+        fwrite("data", 1, 4, file);
+        writeLE(file, dataBytes, 4);
+        for (const short sample: samples) {
+            writeLE(file, static_cast<uint16_t>(sample), 2);
+        }
+        fclose(file);
+        return true;
+    }
+
+    double secondsSince(const Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // The snapshot knows the tune it was taken from, and where it had got to.
+    bool restoreSnapshot(Options &options, char *tunePath) {
+        AudioStats::reset();
+        const Clock::time_point start = Clock::now();
+        if (!C64::loadSnapshot(options.loadSnapshot, tunePath)) {
+            fprintf(stderr, "Could not restore %s\n", options.loadSnapshot);
+            return false;
+        }
+        printf("Restored %s in %.3f ms\n", tunePath, secondsSince(start) * 1000);
+        options.sidFile = tunePath;
+        if (options.playStream && !C64::playStream(options.playStream)) {
+            fprintf(stderr, "Could not play %s\n", options.playStream);
+            return false;
+        }
+        return true;
+    }
+
+    bool loadTune(const Options &options) {
+        AudioStats::reset();
+        C64::c64Init();
+        // Armed before the load, so that the writes made by init are recorded.
+        if (options.recordStream && !C64::startRecording(options.recordStream)) {
+            fprintf(stderr, "Could not create %s\n", options.recordStream);
+            return false;
+        }
+        if (!C64::sid_load_from_file(options.sidFile)) {
+            fprintf(stderr, "Could not load %s\n", options.sidFile);
+            return false;
+        }
+        // The initial song was started by the load, so a forced sampling
+        // method needs the song to be restarted.
+        const int song = options.song > 0 ? options.song - 1 : C64::getCurrentSong();
+        if ((options.song > 0 || options.samplingForced) && !C64::playSong(song)) {
+            fprintf(stderr, "Song %d is out of range\n", options.song);
+            return false;
+        }
+        if (options.playStream && !C64::playStream(options.playStream)) {
+            fprintf(stderr, "Could not play %s\n", options.playStream);
+            return false;
+        }
+        return true;
+    }
+
+    // The spectrum bars DanceFloor draws from a pair of bins.
+    int spectrumBar(const Visualization::SpectrumBin *bins, int i) {
+        return (bins[i].r + bins[i].i + bins[i + 1].r + bins[i + 1].i) * DEFAULT_SPECTRUM_COMPENSATION >> 16;
+    }
+
+    // The same bars from the magnitudes of the bins. The sum of the signed
+    // parts goes up and down with the phase of each partial in the window,
+    // which the register spectrum, all real, knows nothing about.
+    int magnitudeBar(const Visualization::SpectrumBin *bins, int i) {
+        return (std::abs(bins[i].r) + std::abs(bins[i].i) + std::abs(bins[i + 1].r) + std::abs(bins[i + 1].i)) *
+               DEFAULT_SPECTRUM_COMPENSATION >> 16;
+    }
+
+    int loudestBar(const Visualization::SpectrumBin *bins,
+                   int (*bar)(const Visualization::SpectrumBin *, int) = spectrumBar) {
+        int loudest = LOW_FREQ_DOMINANCE_COMP_OFFSET;
+        for (int x = LOW_FREQ_DOMINANCE_COMP_OFFSET; x < 127 + LOW_FREQ_DOMINANCE_COMP_OFFSET; x++) {
+            if (bar(bins, x) > bar(bins, loudest)) {
+                loudest = x;
+            }
+        }
+        return loudest;
+    }
+
+    // Takes the register spectrum when the capture has a new window, as the
+    // visualization would, and checks it against the FFT of the window.
+    void sampleSpectrum(uint32_t &lastSequence, RenderStats &stats) {
+        uint32_t sequence;
+        const short *window = VisualizationCapture::latest(sequence);
+        if (!window || sequence == lastSequence) {
+            return;
+        }
+        lastSequence = sequence;
+        Visualization::SpectrumBin fftBins[FFT_BINS];
+        Visualization::SpectrumBin registerBins[FFT_BINS];
+        Visualization::FixedFFT::transform(window, fftBins);
+        const Clock::time_point t = Clock::now();
+        Visualization::RegisterSpectrum::transform(registerBins);
+        stats.registerSpectrumSeconds += secondsSince(t);
+        stats.spectrumWindows++;
+        const int registerPeak = loudestBar(registerBins);
+        if (std::abs(loudestBar(fftBins) - registerPeak) <= 2) {
+            stats.peaksMatched++;
+        }
+        const int fftPeak = loudestBar(fftBins, magnitudeBar);
+        if (std::abs(fftPeak - registerPeak) <= 2) {
+            stats.magnitudePeaksMatched++;
+        }
+        if (fftPeak == LOW_FREQ_DOMINANCE_COMP_OFFSET) {
+            stats.fftPeaksLowest++;
+        }
+    }
+
+    RenderStats render(const Options &options, std::vector<short> &output) {
+        RenderStats stats;
+        const auto targetSamples = static_cast<size_t>(options.seconds * C64::getSampleRate()) * 2;
+        output.clear();
+        output.reserve(targetSamples + 2 * MAX_SAMPLES_PER_BUFFER);
+        short buffer[2 * MAX_SAMPLES_PER_BUFFER];
+
+        if (options.spectrum) {
+            Visualization::FixedFFT::init();
+        }
+        uint32_t spectrumSequence = 0;
+        const Clock::time_point start = Clock::now();
+        while (output.size() < targetSamples) {
+            const Clock::time_point bufferStart = Clock::now();
+            Clock::time_point t = bufferStart;
+            AudioStats::bufferStarted();
+            const bool played = C64::runFrame();
+            stats.playSeconds += secondsSince(t);
+            if (!played) {
+                AudioStats::watchdogAborted();
+                if (++stats.watchdogAborts > MAX_WATCHDOG_ABORTS) {
+                    fprintf(stderr, "Giving up after %u watchdog aborts\n", stats.watchdogAborts);
+                    break;
+                }
+                continue;
+            }
+            const uint32_t frameInstructions = C64::getInstructionCount();
+            stats.instructions += frameInstructions;
+            stats.cpuCycles += C64::getCycleCount();
+            stats.playCalls += C64::getPlayCallCount();
+            if (frameInstructions > stats.maxInstructions) {
+                stats.maxInstructions = frameInstructions;
+            }
+
+            AudioStats::playRoutineDone();
+            t = Clock::now();
+            const int samples = C64::renderAndMix(buffer, MAX_SAMPLES_PER_BUFFER);
+            stats.renderSeconds += secondsSince(t);
+            AudioStats::bufferRendered(samples, C64::getSampleRate());
+            if (options.traceFile) {
+                stats.trace.push_back({static_cast<uint32_t>(samples), secondsSince(bufferStart) * 1e6});
+            }
+
+            output.insert(output.end(), buffer, buffer + samples * 2);
+            stats.frames++;
+            if (options.spectrum) {
+                sampleSpectrum(spectrumSequence, stats);
+            }
+        }
+        stats.totalSeconds = secondsSince(start);
+        return stats;
+    }
+
+    // Renders the tune once per sampling method and compares how many samples
+    // each one produces per millisecond of SID rendering.
+    int benchmark(Options options) {
+        constexpr int methodCount = sizeof(SAMPLING_METHODS) / sizeof(SAMPLING_METHODS[0]);
+        std::vector<short> output;
+        double samplesPerMs[methodCount];
+        for (int i = 0; i < methodCount; i++) {
+            options.sampling = SAMPLING_METHODS[i].method;
+            options.samplingForced = true;
+            C64::setSamplingMethod(options.sampling);
+            if (!loadTune(options)) {
+                return 1;
+            }
+            const RenderStats stats = render(options, output);
+            samplesPerMs[i] = stats.renderSeconds > 0
+                                  ? static_cast<double>(output.size() / 2) / (stats.renderSeconds * 1000)
+                                  : 0;
+        }
+
+        printf("\n%-12s %12s %9s\n", "Sampling", "Samples/ms", "vs fast");
+        for (int i = 0; i < methodCount; i++) {
+            printf("%-12s %12.1f %8.2fx\n", SAMPLING_METHODS[i].name, samplesPerMs[i],
+                   samplesPerMs[0] > 0 ? samplesPerMs[i] / samplesPerMs[0] : 0);
+        }
+        printf("Realtime needs %.1f samples/ms per chip\n", C64::getSampleRate() / 1000.0);
+        return 0;
+    }
+
+    // Renders the tune with SAMPLE_FAST three times: clocking the SID per
+    // sample with the original reSID envelope and noise loops, per sample with
+    // the shortcuts, and in blocks. Both of the latter are diffed against the
+    // first, which must be identical.
+    int compare(Options options) {
+        static const char *const CLOCKINGS[] = {"Reference:", "Per sample:", "Block:"};
+        std::vector<short> output[3];
+        double samplesPerMs[3];
+        options.sampling = SAMPLE_FAST;
+        options.samplingForced = true;
+        C64::setSamplingMethod(SAMPLE_FAST);
+        for (int clocking = 0; clocking < 3; clocking++) {
+            resid_reference_clocking = clocking == 0;
+            C64::enableBlockClocking(clocking == 2);
+            if (!loadTune(options)) {
+                return 1;
+            }
+            const RenderStats stats = render(options, output[clocking]);
+            samplesPerMs[clocking] = stats.renderSeconds > 0
+                                         ? static_cast<double>(output[clocking].size() / 2) /
+                                           (stats.renderSeconds * 1000)
+                                         : 0;
+        }
+        resid_reference_clocking = false;
+
+        printf("\n");
+        bool identical = true;
+        for (int clocking = 0; clocking < 3; clocking++) {
+            printf("%-12s %.1f samples/ms", CLOCKINGS[clocking], samplesPerMs[clocking]);
+            if (!clocking) {
+                printf("\n");
+                continue;
+            }
+            printf(" (%.2fx)\n", samplesPerMs[0] > 0 ? samplesPerMs[clocking] / samplesPerMs[0] : 0);
+            const size_t length = std::min(output[0].size(), output[clocking].size());
+            size_t differences = 0;
+            int maxDifference = 0;
+            for (size_t i = 0; i < length; i++) {
+                const int difference = abs(output[0][i] - output[clocking][i]);
+                if (difference) {
+                    differences++;
+                    maxDifference = std::max(maxDifference, difference);
+                }
+            }
+            if (output[0].size() != output[clocking].size() || differences) {
+                printf("MISMATCH: %zu of %zu samples differ, by up to %d\n", differences, length, maxDifference);
+                identical = false;
+            }
+        }
+        if (!identical) {
+            return 1;
+        }
+        printf("Identical output (%zu samples)\n", output[0].size() / 2);
+        return 0;
+    }
+
+    bool writeTrace(const char *fileName, const std::vector<TraceEntry> &trace) {
+        FILE *file = fopen(fileName, "w");
+        if (!file) {
+            return false;
+        }
+        for (const TraceEntry &entry: trace) {
+            fprintf(file, "%u %.0f\n", entry.samples, entry.renderUs);
+        }
+        fclose(file);
+        return true;
+    }
+
+    struct PoolResult {
+        uint32_t underruns = 0;
+        double silentMs = 0;
+        double meanLeadMs = 0;
+    };
+
+    // Plays a render trace through an I2S queue of the given depth, either
+    // filling the queue whenever there's room or holding back to the lead
+    // AudioLead aims for, the way the audio core does. Time is continuous
+    // here, where the audio core only sees the lead drop a whole I2S buffer at
+    // a time.
+    PoolResult simulatePool(const std::vector<TraceEntry> &trace, uint32_t sampleRate, uint32_t buffers,
+                            uint32_t bufferSamples, bool adaptive) {
+        const auto capacity = static_cast<double>(buffers * bufferSamples);
+        AudioLead::reset(buffers * bufferSamples, sampleRate);
+        PoolResult result;
+        double lead = 0;
+        uint64_t given = 0;
+        double leadSum = 0;
+        for (const TraceEntry &entry: trace) {
+            lead = std::min(lead, adaptive ? static_cast<double>(AudioLead::targetSamples()) : capacity);
+            leadSum += lead;
+            // The buffer being filled isn't played until it is full.
+            const auto filling = static_cast<double>(given % bufferSamples);
+            const double played = entry.renderUs * sampleRate / 1e6;
+            if (given && played > lead - filling) {
+                result.underruns++;
+                result.silentMs += (played - (lead - filling)) * 1000 / sampleRate;
+                lead = filling;
+            } else {
+                lead -= played;
+            }
+            // Giving a buffer blocks until it fits.
+            lead = std::min(lead + entry.samples, capacity);
+            given += entry.samples;
+            AudioLead::bufferRendered(entry.samples, static_cast<uint32_t>(entry.renderUs));
+        }
+        result.meanLeadMs = trace.empty() ? 0 : leadSum / static_cast<double>(trace.size()) * 1000 / sampleRate;
+        return result;
+    }
+
+    int simulatePools(const Options &options) {
+        FILE *file = fopen(options.poolTrace, "r");
+        if (!file) {
+            fprintf(stderr, "Could not read %s\n", options.poolTrace);
+            return 1;
+        }
+        std::vector<TraceEntry> trace;
+        unsigned int samples;
+        double renderUs;
+        while (fscanf(file, "%u %lf", &samples, &renderUs) == 2) {
+            trace.push_back({samples, renderUs * options.traceScale});
+        }
+        fclose(file);
+        if (trace.empty()) {
+            fprintf(stderr, "No buffers in %s\n", options.poolTrace);
+            return 1;
+        }
+
+        // A trace doesn't say what rate it was recorded at.
+        const uint32_t sampleRate = options.sampleRate ? options.sampleRate : SAMPLE_RATE;
+        uint64_t totalSamples = 0;
+        double totalUs = 0;
+        double maxUs = 0;
+        for (const TraceEntry &entry: trace) {
+            totalSamples += entry.samples;
+            totalUs += entry.renderUs;
+            maxUs = std::max(maxUs, entry.renderUs);
+        }
+        printf("%zu buffers, %.1f s, render time %.2f ms mean, %.2f ms max\n\n", trace.size(),
+               static_cast<double>(totalSamples) / sampleRate, totalUs / 1000 / trace.size(), maxUs / 1000);
+        printf("%-12s %28s %28s\n", "", "Full queue", "Adaptive lead");
+        printf("%-12s %9s %9s %8s %9s %9s %8s\n", "I2S queue", "underruns", "silent ms", "lead ms",
+               "underruns", "silent ms", "lead ms");
+
+        // The queue pico-extras sets up by default, then the configured buffer
+        // size at every depth.
+        struct Queue {
+            uint32_t buffers;
+            uint32_t samples;
+        };
+        std::vector<Queue> queues = {{2, 256}};
+        for (uint32_t buffers = 2; buffers <= 12; buffers++) {
+            queues.push_back({buffers, AUDIO_I2S_BUFFER_SAMPLES});
+        }
+        for (const Queue &queue: queues) {
+            const PoolResult full = simulatePool(trace, sampleRate, queue.buffers, queue.samples, false);
+            char name[32];
+            snprintf(name, sizeof(name), "%u x %u%s", queue.buffers, queue.samples,
+                     queue.buffers == AUDIO_I2S_BUFFER_COUNT && queue.samples == AUDIO_I2S_BUFFER_SAMPLES ? " *" : "");
+            printf("%-12s %9u %9.1f %8.1f", name, full.underruns, full.silentMs, full.meanLeadMs);
+            if (queue.samples == AUDIO_I2S_BUFFER_SAMPLES) {
+                const PoolResult adaptive = simulatePool(trace, sampleRate, queue.buffers, queue.samples, true);
+                printf(" %9u %9.1f %8.1f", adaptive.underruns, adaptive.silentMs, adaptive.meanLeadMs);
+            }
+            printf("\n");
+        }
+        return 0;
+    }
+
+    // An SSD1306 in horizontal addressing mode, as far as the driver uses it:
+    // commands set the column and page window, and data fills the display RAM
+    // through it, wrapping at the end of the window.
+    struct MockDisplay {
+        uint8_t ram[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8] = {};
+        int firstColumn = 0;
+        int lastColumn = DISPLAY_WIDTH - 1;
+        int firstPage = 0;
+        int lastPage = DISPLAY_HEIGHT / 8 - 1;
+        int column = 0;
+        int page = 0;
+        // The command waiting for arguments, and the arguments it has so far.
+        int command = -1;
+        int arguments[2] = {};
+        int argumentCount = 0;
+        // Bytes on the bus, the address byte included.
+        size_t bytes = 0;
+        // Writes to go before one is not acknowledged, if any, and whether one was.
+        int failIn = 0;
+        bool failed = false;
+    };
+
+    MockDisplay mockDisplay;
+
+    int commandArguments(uint8_t command) {
+        switch (command) {
+            case SET_COL_ADDR:
+            case SET_PAGE_ADDR:
+                return 2;
+            case SET_MEM_ADDR:
+            case SET_CONTRAST:
+            case SET_CHARGE_PUMP:
+            case SET_MUX_RATIO:
+            case SET_DISP_OFFSET:
+            case SET_DISP_CLK_DIV:
+            case SET_PRECHARGE:
+            case SET_COM_PIN_CFG:
+            case SET_VCOM_DESEL:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    void mockCommand(MockDisplay &mock, uint8_t byte) {
+        if (mock.command < 0) {
+            if (commandArguments(byte)) {
+                mock.command = byte;
+                mock.argumentCount = 0;
+            }
+            return;
+        }
+        mock.arguments[mock.argumentCount++] = byte;
+        if (mock.argumentCount < commandArguments(mock.command)) {
+            return;
+        }
+        if (mock.command == SET_COL_ADDR) {
+            mock.firstColumn = mock.column = mock.arguments[0];
+            mock.lastColumn = mock.arguments[1];
+        } else if (mock.command == SET_PAGE_ADDR) {
+            mock.firstPage = mock.page = mock.arguments[0];
+            mock.lastPage = mock.arguments[1];
+        }
+        mock.command = -1;
+    }
+
+    void mockData(MockDisplay &mock, uint8_t byte) {
+        mock.ram[mock.page * DISPLAY_WIDTH + mock.column] = byte;
+        if (++mock.column > mock.lastColumn) {
+            mock.column = mock.firstColumn;
+            if (++mock.page > mock.lastPage) {
+                mock.page = mock.firstPage;
+            }
+        }
+    }
+
+    /* Draws frames like the UI does into the display driver, which sends them
+       to the mock controller, and checks that the controller then holds the
+       frame and that the driver counted the bytes on the bus. Every so often a
+       write is not acknowledged, and the next frame has to put it right.
+
+       Each kind of frame is drawn a run of frames in a row, and its cost is
+       that of every frame but the first, which changes over from another
+       kind, and but those after a failed write, which go out whole. */
+    int checkDisplay() {
+        constexpr int FRAMES = 5000;
+        constexpr int RUN = 10;
+        constexpr int KINDS = 5;
+        static const char *const KIND_NAMES[KINDS] = {
+            "random", "a few pixels", "a line of text", "a line", "a list line"
+        };
+        // A song list with its header, where the selected title scrolls.
+        static const char *const LIST[] = {"Commando", "Delta", "Last Ninja 2 - Central Park Loader", "Lightforce"};
+        constexpr int LIST_ROWS = DISPLAY_HEIGHT / FONT_HEIGHT;
+        constexpr int SELECTED = 2;
+        const int scrollLength = static_cast<int>(strlen(LIST[SELECTED]));
+        int scroll = 0;
+        ssd1306_t display{};
+        if (!ssd1306_init(&display, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0x3c, nullptr)) {
+            fprintf(stderr, "Could not set up the display\n");
+            return 1;
+        }
+        srand(1);
+        int mismatches = 0;
+        int miscounts = 0;
+        int failures = 0;
+        size_t kindBytes[KINDS] = {};
+        int kindFrames[KINDS] = {};
+        bool sentWhole = false;
+        for (int frame = 0; frame < FRAMES; frame++) {
+            const int kind = frame / RUN % KINDS;
+            switch (kind) {
+                case 0:
+                    for (size_t i = 0; i < display.bufsize; i++) {
+                        display.buffer[i] = static_cast<uint8_t>(rand());
+                    }
+                    break;
+                case 1:
+                    for (int i = rand() % 5; i > 0; i--) {
+                        display.buffer[rand() % display.bufsize] ^= 1 << rand() % 8;
+                    }
+                    break;
+                case 2:
+                    ssd1306_clear(&display);
+                    ssd1306_draw_string(&display, rand() % 100, rand() % (DISPLAY_HEIGHT - 8), 1, "SIDPod");
+                    break;
+                case 3: {
+                    const int y = rand() % DISPLAY_HEIGHT;
+                    for (int x = 10; x < 60; x++) {
+                        ssd1306_draw_pixel(&display, x, y);
+                    }
+                    break;
+                }
+                default:
+                    ssd1306_clear(&display);
+                    for (int row = 0; row < LIST_ROWS; row++) {
+                        const char *text = row == SELECTED ? LIST[row] + scroll : LIST[row];
+                        ssd1306_draw_string(&display, row ? SONG_LIST_LEFT_MARGIN : 0, row * FONT_HEIGHT, 1, text);
+                    }
+                    scroll = (scroll + 1) % scrollLength;
+            }
+            mockDisplay.bytes = 0;
+            mockDisplay.failed = false;
+            mockDisplay.failIn = frame % 97 == 50 ? 1 + rand() % 3 : 0;
+            ssd1306_show(&display);
+            if (mockDisplay.failed) {
+                failures++;
+                sentWhole = true;
+                continue;
+            }
+            if (memcmp(mockDisplay.ram, display.buffer, display.bufsize) != 0) {
+                mismatches++;
+            }
+            if (display.show_bytes != mockDisplay.bytes) {
+                miscounts++;
+            }
+            if (frame % RUN && !sentWhole) {
+                kindBytes[kind] += display.show_bytes;
+                kindFrames[kind]++;
+            }
+            sentWhole = false;
+        }
+        mockDisplay.bytes = 0;
+        ssd1306_show(&display);
+        const size_t unchangedBytes = mockDisplay.bytes;
+        ssd1306_clear(&display);
+        display.shown_valid = false;
+        ssd1306_show(&display);
+        const size_t wholeBytes = mockDisplay.bytes;
+        ssd1306_deinit(&display);
+
+        printf("\nDisplay frames of %dx%d, bytes on the bus per frame:\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        for (int kind = 0; kind < KINDS; kind++) {
+            printf("  %-16s %6.1f\n", KIND_NAMES[kind],
+                   kindFrames[kind] ? static_cast<double>(kindBytes[kind]) / kindFrames[kind] : 0);
+        }
+        printf("  %-16s %6zu\n", "unchanged", unchangedBytes);
+        printf("  %-16s %6zu\n", "whole frame", wholeBytes);
+        printf("%d frames with a failed write\n", failures);
+        if (mismatches || miscounts) {
+            printf("MISMATCH: the display differs after %d of %d frames, the byte count after %d\n", mismatches,
+                   FRAMES - failures, miscounts);
+            return 1;
+        }
+        printf("The display matches every frame sent without a failed write\n");
+        return 0;
+    }
+
+    // Checks the packed combined waveform tables against the switch statements
+    // they are built from, for every input, and times lookups with both.
+    int benchmarkWaveforms() {
+        struct ChipModelTables {
+            const char *name;
+            chip_model model;
+            reg12 (*resolve[WaveformGenerator::WAVE_TABLES])(reg12);
+        };
+        const ChipModelTables chipModels[] = {
+            {"6581", MOS6581, {wave6581__STresolve, wave6581_P_Tresolve, wave6581_PS_resolve, wave6581_PSTresolve}},
+            {"8580", MOS8580, {wave8580__STresolve, wave8580_P_Tresolve, wave8580_PS_resolve, wave8580_PSTresolve}},
+        };
+
+        // Random inputs, the worst case for both the branches of the switch
+        // statements and the cache.
+        constexpr int LOOKUPS = 1 << 22;
+        std::vector<reg12> inputs(LOOKUPS);
+        uint32_t random = 1;
+        for (auto &input: inputs) {
+            random = random * 1664525 + 1013904223;
+            input = random >> 20;
+        }
+
+        int mismatches = 0;
+        printf("%-6s %10s %12s %12s\n", "Model", "Bytes", "Switch ns", "Packed ns");
+        for (const auto &chipModel: chipModels) {
+            const uint8_t *tables = WaveformGenerator::combined_tables(chipModel.model);
+            for (int table = 0; table < WaveformGenerator::WAVE_TABLES; table++) {
+                for (reg12 output = 0; output < 4096; output++) {
+                    if (WaveformGenerator::combined(tables, table, output) != chipModel.resolve[table](output)) {
+                        mismatches++;
+                    }
+                }
+            }
+
+            unsigned int sum[2] = {0, 0};
+            double seconds[2] = {0, 0};
+            for (int table = 0; table < WaveformGenerator::WAVE_TABLES; table++) {
+                reg12 (*resolve)(reg12) = chipModel.resolve[table];
+                Clock::time_point t = Clock::now();
+                for (const reg12 input: inputs) {
+                    sum[0] += resolve(input);
+                }
+                seconds[0] += secondsSince(t);
+                t = Clock::now();
+                for (const reg12 input: inputs) {
+                    sum[1] += WaveformGenerator::combined(tables, table, input);
+                }
+                seconds[1] += secondsSince(t);
+            }
+            if (sum[0] != sum[1]) {
+                mismatches++;
+            }
+            constexpr double lookups = WaveformGenerator::WAVE_TABLES * static_cast<double>(LOOKUPS);
+            printf("%-6s %10d %12.2f %12.2f\n", chipModel.name,
+                   WaveformGenerator::combined_tables_size(chipModel.model),
+                   seconds[0] * 1e9 / lookups, seconds[1] * 1e9 / lookups);
+        }
+        if (mismatches) {
+            printf("MISMATCH: %d lookups differ from the switch statements\n", mismatches);
+            return 1;
+        }
+        printf("Packed tables match the switch statements\n");
+        return 0;
+    }
+    /* Runs the mono mix of the song through FixedFFT a frame at a time, checks
+       it against kiss_fftr in floats on the same windowed samples, and times
+       both next to the float transform of 1000 samples DanceFloor used to do.
+       A desktop has an FPU, so the float timings are far kinder than on the
+       RP2040. The register spectrum was taken while rendering. */
+    int benchmarkSpectrum(const std::vector<short> &output, const RenderStats &stats) {
+        constexpr int REPEATS = 20;
+        constexpr int LEGACY_SAMPLES = 1000;
+        const size_t frames = output.size() / 2 / FFT_SAMPLES;
+        if (!frames) {
+            fprintf(stderr, "Too little audio for a spectrum\n");
+            return 1;
+        }
+        kiss_fftr_cfg reference = kiss_fftr_alloc(FFT_SAMPLES, false, nullptr, nullptr);
+        kiss_fftr_cfg legacy = kiss_fftr_alloc(LEGACY_SAMPLES, false, nullptr, nullptr);
+        std::vector<short> mono(FFT_SAMPLES);
+        std::vector<kiss_fft_scalar> windowed(FFT_SAMPLES);
+        std::vector<kiss_fft_scalar> raw(LEGACY_SAMPLES);
+        std::vector<kiss_fft_cpx> floatBins(FFT_SAMPLES / 2 + 1);
+        std::vector<kiss_fft_cpx> legacyBins(LEGACY_SAMPLES / 2 + 1);
+        Visualization::SpectrumBin fixedBins[FFT_BINS];
+        Visualization::SpectrumBin referenceBins[FFT_BINS];
+
+        double fixedSeconds = 0;
+        double floatSeconds = 0;
+        double errorSum = 0;
+        int maxError = 0;
+        int peak = 0;
+        uint64_t bars = 0;
+        uint64_t barsOff = 0;
+        for (size_t frame = 0; frame < frames; frame++) {
+            for (int n = 0; n < FFT_SAMPLES; n++) {
+                const size_t at = (frame * FFT_SAMPLES + n) * 2;
+                mono[n] = static_cast<short>((output[at] + output[at + 1]) / 2);
+                windowed[n] = mono[n] * 0.5f * (1 - cosf(2 * M_PI * n / FFT_SAMPLES));
+            }
+            for (int n = 0; n < LEGACY_SAMPLES; n++) {
+                raw[n] = mono[n];
+            }
+
+            Clock::time_point t = Clock::now();
+            for (int i = 0; i < REPEATS; i++) {
+                Visualization::FixedFFT::transform(mono.data(), fixedBins);
+            }
+            fixedSeconds += secondsSince(t);
+            t = Clock::now();
+            for (int i = 0; i < REPEATS; i++) {
+                kiss_fftr(legacy, raw.data(), legacyBins.data());
+            }
+            floatSeconds += secondsSince(t);
+
+            kiss_fftr(reference, windowed.data(), floatBins.data());
+            for (int k = 0; k < FFT_BINS; k++) {
+                referenceBins[k] = {
+                    static_cast<int16_t>(lroundf(floatBins[k].r / FFT_SAMPLES)),
+                    static_cast<int16_t>(lroundf(floatBins[k].i / FFT_SAMPLES))
+                };
+                const int error = std::max(std::abs(fixedBins[k].r - referenceBins[k].r),
+                                           std::abs(fixedBins[k].i - referenceBins[k].i));
+                maxError = std::max(maxError, error);
+                errorSum += error;
+                peak = std::max({peak, std::abs(static_cast<int>(referenceBins[k].r)),
+                                 std::abs(static_cast<int>(referenceBins[k].i))});
+            }
+            for (int x = LOW_FREQ_DOMINANCE_COMP_OFFSET; x < 127 + LOW_FREQ_DOMINANCE_COMP_OFFSET; x++) {
+                bars++;
+                if (std::abs(spectrumBar(fixedBins, x) - spectrumBar(referenceBins, x)) > 1) {
+                    barsOff++;
+                }
+            }
+        }
+        kiss_fftr_free(reference);
+        kiss_fftr_free(legacy);
+
+        const double transforms = static_cast<double>(frames) * REPEATS;
+        printf("\nSpectrum of %zu frames of %d samples\n", frames, FFT_SAMPLES);
+        printf("Float, %d samples:    %.2f us/frame\n", LEGACY_SAMPLES, floatSeconds * 1e6 / transforms);
+        printf("Q15, %d samples:      %.2f us/frame\n", FFT_SAMPLES, fixedSeconds * 1e6 / transforms);
+        printf("Q15 error:            %.2f mean, %d max (peak bin %d)\n",
+               errorSum / (static_cast<double>(frames) * FFT_BINS), maxError, peak);
+        printf("Bars off by more than one: %llu of %llu\n", static_cast<unsigned long long>(barsOff),
+               static_cast<unsigned long long>(bars));
+        if (stats.spectrumWindows) {
+            const double percent = 100.0 / stats.spectrumWindows;
+            printf("Register spectrum:    %.2f us/frame over %u windows\n",
+                   stats.registerSpectrumSeconds * 1e6 / stats.spectrumWindows, stats.spectrumWindows);
+            printf("Loudest bar within two of the FFT's: %.1f%% as drawn, %.1f%% by magnitude\n",
+                   stats.peaksMatched * percent, stats.magnitudePeaksMatched * percent);
+            printf("FFT loudest in its lowest bar:       %.1f%%\n", stats.fftPeaksLowest * percent);
+        }
+        return 0;
+    }
+}
+
+// The display driver's bus, see MockDisplay.
+extern "C" int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void) i2c;
+    (void) addr;
+    (void) nostop;
+    if (mockDisplay.failIn && !--mockDisplay.failIn) {
+        mockDisplay.failed = true;
+        return PICO_ERROR_GENERIC;
+    }
+    mockDisplay.bytes += len + 1;
+    const bool data = src[0] == 0x40;
+    for (size_t i = 1; i < len; i++) {
+        if (data) {
+            mockData(mockDisplay, src[i]);
+        } else {
+            mockCommand(mockDisplay, src[i]);
+        }
+    }
+    return static_cast<int>(len);
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+
+    if (options.waveforms) {
+        return benchmarkWaveforms();
+    }
+    if (options.display) {
+        return checkDisplay();
+    }
+    if (options.poolTrace) {
+        return simulatePools(options);
+    }
+
+    C64::enableParallelRendering();
+    core0_loop = C64::serviceParallelRendering;
+    Mixer::setVolume(VOLUME_STEPS);
+    if (options.benchmark) {
+        return benchmark(options);
+    }
+    if (options.compare) {
+        return compare(options);
+    }
+    if (options.samplingForced) {
+        C64::setSamplingMethod(options.sampling);
+    }
+    char restoredTune[MAX_PATH_LENGTH];
+    if (options.loadSnapshot ? !restoreSnapshot(options, restoredTune) : !loadTune(options)) {
+        return 1;
+    }
+
+    const SidInfo *info = C64::getSidInfo();
+    const double cpuFrequency = info->isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
+
+    if (options.seekSeconds > 0) {
+        const Clock::time_point seekStart = Clock::now();
+        const bool returned = C64::seek(static_cast<uint32_t>(options.seekSeconds * 1000));
+        const double seekSeconds = secondsSince(seekStart);
+        printf("Seeked %.2f s in %.3f s (%.1fx realtime)%s\n", options.seekSeconds, seekSeconds,
+               options.seekSeconds / seekSeconds, returned ? "" : ", with watchdog aborts");
+    }
+
+    std::vector<short> output;
+    const RenderStats stats = render(options, output);
+    if (options.recordStream && !C64::stopRecording()) {
+        fprintf(stderr, "Could not write %s\n", options.recordStream);
+        return 1;
+    }
+    if (options.saveSnapshot && !C64::saveSnapshot(options.saveSnapshot, options.sidFile)) {
+        fprintf(stderr, "Could not write %s\n", options.saveSnapshot);
+        return 1;
+    }
+
+    const size_t renderedSamples = output.size() / 2;
+    const uint32_t sampleRate = C64::getSampleRate();
+    const double renderedSeconds = static_cast<double>(renderedSamples) / sampleRate;
+    const double sidCycles = renderedSeconds * cpuFrequency;
+    const uint32_t frames = stats.frames;
+    printf("\nRendered %.2f s (%zu samples, %u buffers) in %.3f s\n",
+           renderedSeconds, renderedSamples, frames, stats.totalSeconds);
+    printf("Samples/sec:          %.0f (%.1fx realtime)\n",
+           static_cast<double>(renderedSamples) / stats.totalSeconds, renderedSeconds / stats.totalSeconds);
+    printf("Samples/buffer:       %.1f avg\n",
+           frames ? static_cast<double>(renderedSamples) / frames : 0);
+    if (stats.playCalls) {
+        printf("Play calls:           %llu (%.2f Hz)\n",
+               static_cast<unsigned long long>(stats.playCalls), stats.playCalls / renderedSeconds);
+    }
+    printf("6502 instr/buffer:    %.1f avg, %u max\n",
+           frames ? static_cast<double>(stats.instructions) / frames : 0, stats.maxInstructions);
+    printf("6502 cycles/buffer:   %.1f avg\n",
+           frames ? static_cast<double>(stats.cpuCycles) / frames : 0);
+    printf("Play routine:         %.3f s (%.2f us/buffer)\n",
+           stats.playSeconds, frames ? stats.playSeconds * 1e6 / frames : 0);
+    printf("SID render and mix:   %.3f s (%.2f ns/SID cycle, %.1f samples/ms)\n",
+           stats.renderSeconds, sidCycles > 0 ? stats.renderSeconds * 1e9 / sidCycles : 0,
+           stats.renderSeconds > 0 ? renderedSamples / (stats.renderSeconds * 1000) : 0);
+    if (stats.watchdogAborts) {
+        printf("Watchdog aborts:      %u\n", stats.watchdogAborts);
+    }
+    if (options.audioStats) {
+        printf("\n");
+        AudioStats::print();
+    }
+    if (options.spectrum && benchmarkSpectrum(output, stats)) {
+        return 1;
+    }
+
+    if (options.traceFile && !writeTrace(options.traceFile, stats.trace)) {
+        fprintf(stderr, "Could not write %s\n", options.traceFile);
+        return 1;
+    }
+    if (options.wavFile && !writeWav(options.wavFile, output, sampleRate, 2)) {
+        fprintf(stderr, "Could not write %s\n", options.wavFile);
+        return 1;
+    }
+    return 0;
+}
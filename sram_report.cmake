@@ -0,0 +1,56 @@
+# Prints how much SRAM the code and tables marked HOT_FUNC and HOT_DATA (see
+# src/platform_config.h) take, read from the linker map of the firmware.
+# Run as a post build step:
+#   cmake -DMAP_FILE=<firmware>.elf.map -P sram_report.cmake
+
+if (NOT EXISTS "${MAP_FILE}")
+    message("SRAM hot set: no linker map at ${MAP_FILE}")
+    return()
+endif ()
+
+file(READ "${MAP_FILE}" MAP)
+# Only the memory map itself, not the list of discarded sections before it.
+string(FIND "${MAP}" "Linker script and memory map" MAP_START)
+if (MAP_START GREATER -1)
+    string(SUBSTRING "${MAP}" ${MAP_START} -1 MAP)
+endif ()
+
+# An input section is listed by name, then address, size and object file,
+# with a line break after the name when it is long.
+string(REGEX MATCHALL
+        "[\r\n][ \t]*\\.time_critical\\.sidpod[^ \t\r\n]*[ \t\r\n]+0x[0-9a-fA-F]+[ \t]+0x[0-9a-fA-F]+[ \t]+[^\r\n]+"
+        SECTIONS "${MAP}")
+
+set(CODE_BYTES 0)
+set(DATA_BYTES 0)
+set(HANDLER_BYTES 0)
+set(REPORT "")
+foreach (SECTION ${SECTIONS})
+    string(REGEX MATCH "^[\r\n][ \t]*\\.time_critical\\.([^ \t\r\n]*)[ \t\r\n]+0x[0-9a-fA-F]+[ \t]+(0x[0-9a-fA-F]+)[ \t]+([^\r\n]+)"
+            UNUSED "${SECTION}")
+    set(NAME "${CMAKE_MATCH_1}")
+    math(EXPR SIZE "${CMAKE_MATCH_2}")
+    get_filename_component(OBJECT "${CMAKE_MATCH_3}" NAME)
+    if (SIZE EQUAL 0)
+        continue()
+    endif ()
+    if (NAME STREQUAL "sidpod_data")
+        math(EXPR DATA_BYTES "${DATA_BYTES} + ${SIZE}")
+        set(NAME "tables")
+    elseif (NAME MATCHES "^sidpod\\.execute_")
+        # The 256 6502 instruction handlers are reported as one.
+        math(EXPR CODE_BYTES "${CODE_BYTES} + ${SIZE}")
+        math(EXPR HANDLER_BYTES "${HANDLER_BYTES} + ${SIZE}")
+        continue()
+    else ()
+        math(EXPR CODE_BYTES "${CODE_BYTES} + ${SIZE}")
+        string(REPLACE "sidpod." "" NAME "${NAME}")
+    endif ()
+    string(APPEND REPORT "  ${SIZE}\t${NAME} (${OBJECT})\n")
+endforeach ()
+if (HANDLER_BYTES GREATER 0)
+    string(APPEND REPORT "  ${HANDLER_BYTES}\t6502 instruction handlers\n")
+endif ()
+
+math(EXPR TOTAL_BYTES "${CODE_BYTES} + ${DATA_BYTES}")
+message("SRAM hot set: ${TOTAL_BYTES} bytes, ${CODE_BYTES} code and ${DATA_BYTES} tables\n${REPORT}")
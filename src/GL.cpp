@@ -4,6 +4,7 @@
 
 #include "GL.h"
 
+#include <array>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -15,6 +16,66 @@
 using std::sin;
 using std::cos;
 
+/*
+ * The points of the pixel sphere, 0.3 radians apart in longitude and
+ * latitude, on a unit sphere in Q15. Both tables are worked out by the
+ * compiler and end up in flash, so drawing the sphere is integer math only.
+ */
+struct SphereVertex {
+    int16_t x, y, z;
+};
+
+#define SPHERE_STEP         0.3
+#define SPHERE_LONGITUDES   21  // ceil(2 * pi / SPHERE_STEP)
+#define SPHERE_LATITUDES    11  // ceil(pi / SPHERE_STEP)
+
+// Taylor series, good to well below a Q15 step for |angle| <= pi.
+static constexpr double constexprSine(double angle) {
+    while (angle > M_PI) angle -= 2 * M_PI;
+    while (angle < -M_PI) angle += 2 * M_PI;
+    double term = angle;
+    double sum = angle;
+    for (int n = 1; n < 12; n++) {
+        term *= -angle * angle / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+static constexpr int16_t toQ15(const double value) {
+    return static_cast<int16_t>(value * 32767 + (value < 0 ? -0.5 : 0.5));
+}
+
+static constexpr std::array<SphereVertex, SPHERE_LONGITUDES * SPHERE_LATITUDES> sphereVertices = [] {
+    std::array<SphereVertex, SPHERE_LONGITUDES * SPHERE_LATITUDES> vertices{};
+    for (int longitude = 0; longitude < SPHERE_LONGITUDES; longitude++) {
+        const double theta = longitude * SPHERE_STEP;
+        for (int latitude = 0; latitude < SPHERE_LATITUDES; latitude++) {
+            const double phi = latitude * SPHERE_STEP;
+            const double sinPhi = constexprSine(phi);
+            vertices[longitude * SPHERE_LATITUDES + latitude] = {
+                toQ15(sinPhi * constexprSine(theta + M_PI / 2)),
+                toQ15(sinPhi * constexprSine(theta)),
+                toQ15(constexprSine(phi + M_PI / 2))
+            };
+        }
+    }
+    return vertices;
+}();
+
+static constexpr std::array<int16_t, 360> sineTable = [] {
+    std::array<int16_t, 360> table{};
+    for (int degrees = 0; degrees < 360; degrees++) {
+        table[degrees] = toQ15(constexprSine(degrees * M_PI / 180));
+    }
+    return table;
+}();
+
+static int32_t sineOf(const int32_t degrees) {
+    const int32_t wrapped = degrees % 360;
+    return sineTable[wrapped < 0 ? wrapped + 360 : wrapped];
+}
+
 void GL::drawPixel(const int32_t x, const int32_t y, const int32_t clip) const {
     if (clip) {
         if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT && y < clip) {
@@ -141,7 +202,7 @@ void GL::drawFilledCircle(const int32_t x, const int32_t y, const int32_t radius
 
 void GL::draw3DPixelSphere(const int32_t x,
                            const int32_t y,
-                           const float size,
+                           const int32_t size,
                            const int16_t xAxisRotation,
                            const int16_t yAxisRotation,
                            const int32_t clip) const {
@@ -150,35 +211,21 @@ void GL::draw3DPixelSphere(const int32_t x,
         return;
     }
     if (size <= 6) {
-        drawFilledCircle(x, y, static_cast<int>(size));
+        drawFilledCircle(x, y, size);
         return;
     }
-    float theta = 0;
-    while (theta < 2 * M_PI) {
-        float phi = 0;
-        while (phi < M_PI) {
-            // Latitude
-            // Calculate 3D sphere coordinates
-            auto x3D = size * sin(phi) * cos(theta);
-            auto y3D = size * sin(phi) * sin(theta);
-            auto z3D = size * cos(phi);
-
-            // Apply rotation around the X-axis
-            const auto tempY = y3D * cos(xAxisRotation * M_PI / 180) - z3D
-                               * sin(xAxisRotation * M_PI / 180);
-            z3D = y3D * sin(xAxisRotation * M_PI / 180) + z3D * cos(xAxisRotation * M_PI / 180);
-            y3D = tempY;
-
-            // Apply rotation around the Y-axis
-            x3D = x3D * cos(yAxisRotation * M_PI / 180) + z3D * sin(yAxisRotation * M_PI / 180);
-
-            // Project 3D coordinates onto 2D plane
-            drawPixel(static_cast<int32_t>(x + x3D),
-                      static_cast<int32_t>(y + y3D), clip);
-
-            phi += 0.3;
-        }
-        theta += 0.3;
+    const int32_t sinX = sineOf(xAxisRotation);
+    const int32_t cosX = sineOf(xAxisRotation + 90);
+    const int32_t sinY = sineOf(yAxisRotation);
+    const int32_t cosY = sineOf(yAxisRotation + 90);
+    for (const auto &[x3D, y3D, z3D]: sphereVertices) {
+        // Rotate around the X-axis, then the Y-axis, rounding to the nearest Q15 step
+        const int32_t rotatedY = (y3D * cosX - z3D * sinX + (1 << 14)) >> 15;
+        const int32_t rotatedZ = (y3D * sinX + z3D * cosX + (1 << 14)) >> 15;
+        const int32_t rotatedX = (x3D * cosY + rotatedZ * sinY + (1 << 14)) >> 15;
+
+        // Project onto the 2D plane
+        drawPixel(x + (rotatedX * size >> 15), y + (rotatedY * size >> 15), clip);
     }
 }
 
@@ -52,7 +52,7 @@ public:
 
     void draw3DPixelSphere(int32_t x,
                            int32_t y,
-                           float size,
+                           int32_t size,
                            int16_t xAxisRotation,
                            int16_t yAxisRotation,
                            int32_t clip = 0) const;
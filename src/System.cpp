@@ -1,5 +1,6 @@
 #include <device/usbd.h>
 #include <pico/multicore.h>
+#include <hardware/sync.h>
 #include <hardware/watchdog.h>
 #include <pico/sleep.h>
 #include "System.h"
@@ -9,6 +10,8 @@
 #endif
 #ifdef USE_SDCARD
 #include "sd_card.h"
+#else
+#include "diskio.h"
 #endif
 
 #include "UI.h"
@@ -23,9 +26,17 @@ repeating_timer tudTaskTimer{};
 bool connected = false;
 bool mounted = false;
 uint32_t lastVBLTimestamp = 0;
+static bool (*volatile core1Job)(void *) = nullptr;
+static void *volatile core1JobArg = nullptr;
+static volatile bool core1JobResult = false;
 
 void tud_mount_cb() {
+#ifndef USE_SDCARD
+    disk_enable_core1_lockout(false);
+#endif
     multicore_reset_core1();
+    // A read core1 asked for ahead of time is of no use now.
+    core1Job = nullptr;
     UI::stop();
     f_unmount("");
     connected = true;
@@ -44,9 +55,12 @@ void System::hardReset() {
     watchdog_enable(1, true);
 }
 
+// Core0 spends the wait rendering the extra SID chips for the audio core, and
+// on its file system writes.
 void System::virtualVBLSync() {
-    if (const int compDelay = SYNC_INTERVAL_MS - static_cast<int>(millis_now() - lastVBLTimestamp); compDelay > 0) {
-        busy_wait_ms(compDelay);
+    while (static_cast<int>(millis_now() - lastVBLTimestamp) < SYNC_INTERVAL_MS) {
+        C64::serviceParallelRendering();
+        serviceCore1Jobs();
     }
     lastVBLTimestamp = millis_now();
 }
@@ -94,6 +108,39 @@ bool System::openSettingsFile(FIL *fil, const char *fileName) {
     return fr == FR_OK;
 }
 
+bool System::runOnCore0(bool (*job)(void *), void *arg) {
+    startOnCore0(job, arg);
+    return waitForCore0();
+}
+
+void System::startOnCore0(bool (*job)(void *), void *arg) {
+    waitForCore0();
+    if (get_core_num() == 0) {
+        core1JobResult = job(arg);
+        return;
+    }
+    core1JobArg = arg;
+    __dmb();
+    core1Job = job;
+}
+
+bool System::waitForCore0() {
+    while (core1Job) {
+        tight_loop_contents();
+    }
+    __dmb();
+    return core1JobResult;
+}
+
+void System::serviceCore1Jobs() {
+    bool (*job)(void *) = core1Job;
+    if (!job) return;
+    __dmb();
+    core1JobResult = job(core1JobArg);
+    __dmb();
+    core1Job = nullptr;
+}
+
 bool System::createSettingsDirectoryIfNotExists() {
     DIR *dp = new DIR;
     FRESULT fr = f_opendir(dp, SETTINGS_DIRECTORY);
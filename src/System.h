@@ -25,6 +25,21 @@ public:
 
     static bool prepareFilesystem();
 
+    // Runs job on core0, from its main loop, and returns what it returned.
+    // Core1 writes to the file system through this, as core0 has to park it
+    // while the flash is programmed. Called on core0, job just runs.
+    static bool runOnCore0(bool (*job)(void *), void *arg);
+
+    // Hands job to core0 like runOnCore0, but returns without waiting for it,
+    // so core1 can have reads done ahead of need. Waits for the job before.
+    static void startOnCore0(bool (*job)(void *), void *arg);
+
+    // Waits for the last job handed to core0 and returns what it returned.
+    static bool waitForCore0();
+
+    // Runs the job core1 is waiting on, if any.
+    static void serviceCore1Jobs();
+
 private:
     // ReSharper disable once CppRedundantElaboratedTypeSpecifier
     static bool repeatingTudTask(struct repeating_timer *t);
@@ -29,6 +29,7 @@ float longTitleScrollOffset, headerScrollOffset, playingSymbolAnimationCounter =
 auto danceFloor = new Visualization::DanceFloor(&gl);
 UI::State currentState = UI::splash;
 UI::State lastState = currentState;
+static volatile bool sleepRequested = false;
 #ifdef USE_BUDDY
 auto *buddy = Buddy::getInstance();
 #endif
@@ -71,6 +72,11 @@ void UI::startDanceFloor() {
 }
 
 void UI::updateUI() {
+    // Asked for by the long press alarm, but run from here, as saving the
+    // snapshot waits for the audio core and writes to the flash.
+    if (sleepRequested) {
+        goToSleep();
+    }
     switch (currentState) {
         case visualization:
             if (catalog->hasOpenPlaylist()) {
@@ -428,6 +434,10 @@ void UI::screenshotToPBM() {
     ssd1306_dump_pbm(&disp);
 }
 
+void UI::printDisplayStats() {
+    ssd1306_print_stats(&disp);
+}
+
 void UI::verticalMovement(const int delta) {
     danceFloor->stop();
 #if (!USE_BUDDY)
@@ -564,7 +574,9 @@ int64_t UI::longPressCallback(alarm_id_t id, void *user_data) {
     while (!gpio_get(SWITCH_PIN)) {
         busy_wait_ms(1);
         if (i++ > DORMANT_ADDITIONAL_DURATION_MS) {
-            goToSleep();
+            sleepRequested = true;
+            danceFloor->stop();
+            break;
         }
     }
     return 0;
@@ -669,6 +681,7 @@ void UI::animateShutdown() {
 void UI::goToSleep() {
     cancel_repeating_timer(&userControlTimer);
     danceFloor->stop();
+    SIDPlayer::saveSnapshot();
     SIDPlayer::resetState();
     animateShutdown();
     System::goDormant();
@@ -49,6 +49,8 @@ public:
 
     static void screenshotToPBM();
 
+    static void printDisplayStats();
+
 #if USE_BUDDY
     static void adjustVolume(bool up);
 
@@ -0,0 +1,32 @@
+#include "AudioLead.h"
+
+#include "../platform_config.h"
+
+uint32_t AudioLead::capacity = AUDIO_I2S_BUFFER_COUNT * AUDIO_I2S_BUFFER_SAMPLES;
+uint32_t AudioLead::rate = SAMPLE_RATE;
+uint32_t AudioLead::debtUs = 0;
+uint32_t AudioLead::needUs = 0;
+
+// Until the tune has shown what it needs, it gets a full buffer of lead.
+void AudioLead::reset(uint32_t capacitySamples, uint32_t sampleRate) {
+    capacity = capacitySamples;
+    rate = sampleRate;
+    debtUs = 0;
+    needUs = 1000000 / BUFFERS_PER_SECOND;
+}
+
+void AudioLead::bufferRendered(uint32_t samples, uint32_t renderUs) {
+    const uint32_t need = debtUs + renderUs;
+    const uint32_t playUs = static_cast<uint32_t>(static_cast<uint64_t>(samples) * 1000000 / rate);
+    debtUs = need > playUs ? need - playUs : 0;
+    needUs -= needUs >> AUDIO_LEAD_DECAY_SHIFT;
+    if (need > needUs) {
+        needUs = need;
+    }
+}
+
+uint32_t AudioLead::targetSamples() {
+    const uint32_t target = static_cast<uint32_t>(static_cast<uint64_t>(needUs) * rate / 1000000)
+                            + AUDIO_I2S_BUFFER_SAMPLES;
+    return target < capacity ? target : capacity;
+}
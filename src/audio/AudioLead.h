@@ -0,0 +1,35 @@
+#ifndef SIDPOD_AUDIOLEAD_H
+#define SIDPOD_AUDIOLEAD_H
+
+#include <cstdint>
+
+// The lead the audio core aims for is allowed to fall by 1/1024 per buffer once
+// the expensive stretch that raised it has passed, which halves it in about
+// fourteen seconds.
+#define AUDIO_LEAD_DECAY_SHIFT  10
+
+/*
+ * How far ahead of the I2S output the audio core renders. Running ahead costs
+ * latency, since the volume and the visualization are applied when a buffer is
+ * mixed, so the target is the lead the tune has been seen to need rather than
+ * the whole queue: the longest time a buffer took to render, plus whatever a
+ * run of buffers that took longer to render than to play had already eaten
+ * into the lead before it. One I2S buffer is added on top, as the buffer being
+ * filled isn't played until it is full.
+ */
+class AudioLead {
+public:
+    static void reset(uint32_t capacitySamples, uint32_t sampleRate);
+
+    static void bufferRendered(uint32_t samples, uint32_t renderUs);
+
+    static uint32_t targetSamples();
+
+private:
+    static uint32_t capacity;
+    static uint32_t rate;
+    static uint32_t debtUs;
+    static uint32_t needUs;
+};
+
+#endif //SIDPOD_AUDIOLEAD_H
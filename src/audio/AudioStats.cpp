@@ -0,0 +1,155 @@
+#include "AudioStats.h"
+
+#include <cstdio>
+#include <cstring>
+#include <hardware/sync.h>
+#include <pico/time.h>
+
+#include "../platform_config.h"
+
+static AudioStatsSnapshot working;
+static AudioStatsSnapshot published;
+static volatile uint32_t sequence = 0;
+static volatile uint32_t underruns = 0;
+static uint32_t bufferStart = 0;
+static uint32_t stageStart = 0;
+/* Written by core1 one word per buffer, outside the sequence counter, so a
+   trace printed while playing may have its newest entries overwritten by
+   newer ones still. */
+static volatile uint32_t trace[AUDIO_STATS_TRACE_LENGTH];
+static volatile uint32_t traceNext = 0;
+
+static const char *const stageNames[AUDIO_STAGE_COUNT] = {"play", "sid", "mix", "buffer"};
+
+static void addTime(AudioStageTime &stage, uint32_t us) {
+    stage.lastUs = us;
+    stage.totalUs += us;
+    if (us > stage.maxUs) {
+        stage.maxUs = us;
+    }
+}
+
+static void endStage(AudioStage stage) {
+    const uint32_t now = time_us_32();
+    addTime(working.stages[stage], now - stageStart);
+    stageStart = now;
+}
+
+void AudioStats::reset() {
+    memset(&working, 0, sizeof(working));
+    working.minSlackUs = INT32_MAX;
+    working.minLeadSamples = UINT32_MAX;
+    memset(const_cast<uint32_t *>(trace), 0, sizeof(trace));
+    traceNext = 0;
+    underruns = 0;
+    publish();
+}
+
+void AudioStats::leadSampled(uint32_t leadSamples, uint32_t targetSamples) {
+    working.leadSamples = leadSamples;
+    working.targetSamples = targetSamples;
+    if (leadSamples < working.minLeadSamples) {
+        working.minLeadSamples = leadSamples;
+    }
+}
+
+void AudioStats::bufferStarted() {
+    bufferStart = stageStart = time_us_32();
+}
+
+void AudioStats::playRoutineDone() {
+    endStage(AUDIO_STAGE_PLAY);
+}
+
+void AudioStats::sidsRendered() {
+    endStage(AUDIO_STAGE_SID);
+}
+
+void AudioStats::bufferRendered(uint32_t samples, uint32_t sampleRate) {
+    endStage(AUDIO_STAGE_MIX);
+    const uint32_t renderUs = stageStart - bufferStart;
+    addTime(working.stages[AUDIO_STAGE_BUFFER], renderUs);
+    working.buffers++;
+    if (samples) {
+        const uint32_t playUs = static_cast<uint32_t>(static_cast<uint64_t>(samples) * 1000000 / sampleRate);
+        working.lastSlackUs = static_cast<int32_t>(playUs - renderUs);
+        if (working.lastSlackUs < working.minSlackUs) {
+            working.minSlackUs = working.lastSlackUs;
+        }
+        const uint32_t bucket = static_cast<uint32_t>(static_cast<uint64_t>(renderUs) * 10 / playUs);
+        working.histogram[bucket < AUDIO_STATS_HISTOGRAM_BUCKETS ? bucket : AUDIO_STATS_HISTOGRAM_BUCKETS - 1]++;
+    }
+    trace[traceNext] = samples << 16 | (renderUs < 0xffff ? renderUs : 0xffff);
+    traceNext = (traceNext + 1) % AUDIO_STATS_TRACE_LENGTH;
+    publish();
+}
+
+void AudioStats::watchdogAborted() {
+    working.watchdogAborts++;
+    publish();
+}
+
+void AudioStats::underrun() {
+    underruns = underruns + 1;
+}
+
+void AudioStats::publish() {
+    sequence = sequence + 1;
+    __dmb();
+    published = working;
+    __dmb();
+    sequence = sequence + 1;
+}
+
+void AudioStats::snapshot(AudioStatsSnapshot &out) {
+    uint32_t start;
+    do {
+        while ((start = sequence) & 1) {
+        }
+        __dmb();
+        out = published;
+        __dmb();
+    } while (sequence != start);
+    out.underruns = underruns;
+}
+
+void AudioStats::print() {
+    AudioStatsSnapshot stats;
+    snapshot(stats);
+    printf("Buffers: %lu, watchdog aborts: %lu, I2S underruns: %lu\n",
+           static_cast<unsigned long>(stats.buffers), static_cast<unsigned long>(stats.watchdogAborts),
+           static_cast<unsigned long>(stats.underruns));
+    printf("%-8s %8s %8s %8s\n", "us", "last", "mean", "max");
+    for (int i = 0; i < AUDIO_STAGE_COUNT; i++) {
+        const AudioStageTime &stage = stats.stages[i];
+        printf("%-8s %8lu %8lu %8lu\n", stageNames[i], static_cast<unsigned long>(stage.lastUs),
+               static_cast<unsigned long>(stats.buffers ? stage.totalUs / stats.buffers : 0),
+               static_cast<unsigned long>(stage.maxUs));
+    }
+    if (stats.buffers) {
+        printf("Slack: %ld us, min %ld us\n", static_cast<long>(stats.lastSlackUs),
+               static_cast<long>(stats.minSlackUs));
+    }
+    if (stats.targetSamples) {
+        printf("Lead: %lu samples, min %lu, target %lu\n", static_cast<unsigned long>(stats.leadSamples),
+               static_cast<unsigned long>(stats.minLeadSamples), static_cast<unsigned long>(stats.targetSamples));
+    }
+    printf("Render time / play time:\n");
+    for (int i = 0; i < AUDIO_STATS_HISTOGRAM_BUCKETS; i++) {
+        if (i < AUDIO_STATS_HISTOGRAM_BUCKETS - 1) {
+            printf("  %3d-%3d%% %8lu\n", i * 10, i * 10 + 10, static_cast<unsigned long>(stats.histogram[i]));
+        } else {
+            printf("     >%3d%% %8lu\n", i * 10, static_cast<unsigned long>(stats.histogram[i]));
+        }
+    }
+}
+
+void AudioStats::printTrace() {
+    const uint32_t next = traceNext;
+    for (uint32_t i = 0; i < AUDIO_STATS_TRACE_LENGTH; i++) {
+        const uint32_t entry = trace[(next + i) % AUDIO_STATS_TRACE_LENGTH];
+        if (entry) {
+            printf("%lu %lu\n", static_cast<unsigned long>(entry >> 16), static_cast<unsigned long>(entry & 0xffff));
+        }
+    }
+}
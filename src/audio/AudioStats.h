@@ -0,0 +1,82 @@
+#ifndef SIDPOD_AUDIOSTATS_H
+#define SIDPOD_AUDIOSTATS_H
+
+#include <cstdint>
+
+// Render time histogram buckets, each a tenth of the time the buffer takes to
+// play. The last bucket takes everything slower than that.
+#define AUDIO_STATS_HISTOGRAM_BUCKETS   12
+// Buffers kept in the render trace, enough for five seconds of audio.
+#define AUDIO_STATS_TRACE_LENGTH        256
+
+enum AudioStage {
+    AUDIO_STAGE_PLAY,
+    AUDIO_STAGE_SID,
+    AUDIO_STAGE_MIX,
+    AUDIO_STAGE_BUFFER,
+    AUDIO_STAGE_COUNT
+};
+
+struct AudioStageTime {
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+struct AudioStatsSnapshot {
+    uint32_t buffers;
+    uint32_t watchdogAborts;
+    uint32_t underruns;
+    AudioStageTime stages[AUDIO_STAGE_COUNT];
+    // Play time of the last buffer minus the time it took to render, and the
+    // smallest such margin since the tune was loaded.
+    int32_t lastSlackUs;
+    int32_t minSlackUs;
+    // Audio queued for the I2S output when the last buffer was started, the
+    // least of it since the tune was loaded, and the lead aimed for.
+    uint32_t leadSamples;
+    uint32_t minLeadSamples;
+    uint32_t targetSamples;
+    uint32_t histogram[AUDIO_STATS_HISTOGRAM_BUCKETS];
+};
+
+/*
+ * Always on timing of the audio core. Core1 stamps the stages of every buffer
+ * it renders and publishes the totals once per buffer under a sequence
+ * counter, so core0 can take a consistent snapshot at any time without
+ * locking out the audio core. The counter is odd while an update is under
+ * way, and a reader that sees it odd or changed simply reads again.
+ */
+class AudioStats {
+public:
+    static void reset();
+
+    // Called by core1 in the order the stages of a buffer happen.
+    static void leadSampled(uint32_t leadSamples, uint32_t targetSamples);
+
+    static void bufferStarted();
+
+    static void playRoutineDone();
+
+    static void sidsRendered();
+
+    static void bufferRendered(uint32_t samples, uint32_t sampleRate);
+
+    static void watchdogAborted();
+
+    // Called from the I2S DMA interrupt on core0.
+    static void underrun();
+
+    static void snapshot(AudioStatsSnapshot &out);
+
+    static void print();
+
+    // One line per buffer, oldest first, with the number of samples and the
+    // render time in microseconds, as sidpod-render -p reads them.
+    static void printTrace();
+
+private:
+    static void publish();
+};
+
+#endif //SIDPOD_AUDIOSTATS_H
@@ -8,25 +8,38 @@
 
 #include "C64.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
-#include <hardware/dma.h>
-#include <hardware/interp.h>
+#include <hardware/irq.h>
 #include <hardware/pio.h>
+#include <hardware/sync.h>
+#include <pico/multicore.h>
 
 #include "../platform_config.h"
+#include "AudioStats.h"
+#include "Mixer.h"
 #include "reSID/sid.h"
+#include "roms.h"
 #include "sidendian.h"
 #include "SIDPlayer.h"
+#include "SidStream.h"
+#include "Snapshot.h"
 #include "System.h"
+#include "Timeline.h"
+#include "VisualizationCapture.h"
 
 #define ICODE_ATTR
 #define IDATA_ATTR
 #define ICONST_ATTR
 
+#define IO_FIRST_PAGE 0xd0
+#define IO_PAGE_COUNT (0xe0 - IO_FIRST_PAGE)
+
 #define FLAG_N 128
 #define FLAG_V 64
+#define FLAG_B 16
 #define FLAG_D 8
 #define FLAG_I 4
 #define FLAG_Z 2
@@ -56,6 +69,57 @@ enum {
 
 /* ------------------------------------------------------ C64 Emu Stuff */
 static long watchdog_counter = 0;
+static uint32_t cycle_counter = 0;
+static uint32_t frame_instructions = 0;
+static uint32_t busy_cycles = 0;
+static uint32_t play_calls = 0;
+
+/* Play calls are scheduled in 16.16 fixed point cycles, so neither the call
+   rate nor the buffer length loses its fraction from one buffer to the next.
+   A buffer holds a whole number of calls, or a whole fraction of one call when
+   a single call is longer than MAX_SAMPLES_PER_BUFFER. */
+static uint32_t cyclesPerCall = PAL_CYCLES_PER_FRAME;
+static uint64_t bufferCycles16 = 0;
+static uint64_t bufferRemainder16 = 0;
+static uint64_t nextCall16 = 0;
+
+/* RSID tunes, and PSID tunes without a play address, are run on the timeline:
+   the CPU runs continuously and the play routine is reached through the CIA
+   and VIC interrupts, just like on the real machine. */
+static bool timelineMode = false;
+static uint32_t frameStart = 0;
+static unsigned char cpuPort = 0x37;
+
+/* RAM contents after the KERNAL reset routine has run ($0000-$03ff). Every
+   entry is an offset byte (bit 7 set when a count byte follows) and a count
+   byte (bit 7 set when the run is a single repeated value), both off by one,
+   followed by the data. */
+static constexpr unsigned char powerOnRam[] = {
+#include "poweron.bin"
+};
+
+/* SID writes made by the play routine, stamped with the cycle in the frame
+   they happened on, so that renderAndMix can apply them at the right point. */
+struct SidWrite {
+    uint32_t cycle;
+    uint8_t chip;
+    uint8_t reg;
+    uint8_t value;
+};
+
+static SidWrite sidWriteQueue[SID_WRITE_QUEUE_SIZE];
+static int sidWriteCount = 0;
+static bool queueSidWrites = false;
+
+/* SID register streams. A recording stamps every write with its cycle since
+   the song was started. When a stream is played back, the writes of each
+   buffer are read into the queue above instead of being made by the CPU. */
+static bool recording = false;
+static bool streamPlayback = false;
+static uint32_t streamCycles = 0;
+static uint32_t streamLength = 0;
+static SidStreamWrite nextStreamWrite;
+static bool streamWritePending = false;
 
 static unsigned char bval IDATA_ATTR;
 static unsigned short wval IDATA_ATTR;
@@ -104,6 +168,27 @@ static constexpr int modes[256] ICONST_ATTR = {
     rel, indy, xxx, xxx, zpx, zpx, zpx, xxx, imp, absy, acc, xxx, xxx, absx, absx, xxx
 };
 
+// Base cycle counts. Page crossing and taken branch penalties are added by
+// the handlers.
+static constexpr int cycles[256] ICONST_ATTR = {
+    7, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 4, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+    6, 6, 2, 8, 3, 3, 5, 5, 4, 2, 2, 2, 4, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+    6, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 3, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+    6, 6, 2, 8, 3, 3, 5, 5, 4, 2, 2, 2, 5, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+    2, 6, 2, 6, 3, 3, 3, 3, 2, 2, 2, 2, 4, 4, 4, 4,
+    2, 6, 2, 6, 4, 4, 4, 4, 2, 5, 2, 5, 5, 5, 5, 5,
+    2, 6, 2, 6, 3, 3, 3, 3, 2, 2, 2, 2, 4, 4, 4, 4,
+    2, 5, 2, 5, 4, 4, 4, 4, 2, 4, 2, 4, 4, 4, 4, 4,
+    2, 6, 2, 8, 3, 3, 5, 5, 2, 2, 2, 2, 4, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+    2, 6, 2, 8, 3, 3, 5, 5, 2, 2, 2, 2, 4, 4, 6, 6,
+    2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7
+};
+
 SidInfo info;
 SID *firstSID = new SID;
 SID *secondSID = new SID;
@@ -113,24 +198,28 @@ unsigned short secondSidAddr = 0;
 unsigned short thirdSidAddr = 0;
 bool firstBuffer = true;
 uint16_t currentSong;
-int sampleCount = MAX_SAMPLES_PER_BUFFER * NTSC_SPEED_FACTOR;
-cycle_count initialCycleCount = 0;
-int visDMAChan = 0;
-dma_channel_config visDMACfg;
-int currentVisualizationBufferOffset = 0;
+cycle_count bufferCycles = 0;
+bool parallelRendering = false;
+short sidBuffers[MIXER_MAX_CHIPS][MAX_SAMPLES_PER_BUFFER];
+int sidSamples[MIXER_MAX_CHIPS];
+// How far into the buffer the chips were clocked by the last flush of a full
+// write queue, with the samples they had rendered by then in sidSamples.
+cycle_count flushedCycles = 0;
 uint32_t songStartMillis = 0;
 bool songLoaded = false;
+bool samplingMethodForced = false;
+sampling_method forcedSamplingMethod = SAMPLE_FAST;
+// The sampling method set for the tune and for each of its songs, plus one,
+// or 0 where none is set.
+static uint8_t tuneSamplingMethod = 0;
+static uint8_t songSamplingMethods[MAX_SONGS] = {};
+static sampling_method samplingMethod = SAMPLE_FAST;
+static constexpr uint32_t sampleRates[] = {22050, 32000, 44100, MAX_SAMPLE_RATE};
+uint32_t sampleRate = SAMPLE_RATE;
+uint32_t forcedSampleRate = 0;
 
 /* ------------------------------------------------------------- synthesis
    initialize SID and frequency dependant values */
-void C64::begin() {
-    visDMAChan = dma_claim_unused_channel(true);
-    visDMACfg = dma_channel_get_default_config(visDMAChan);
-    channel_config_set_transfer_data_size(&visDMACfg, DMA_SIZE_16);
-    channel_config_set_read_increment(&visDMACfg, true);
-    channel_config_set_write_increment(&visDMACfg, true);
-}
-
 void C64::synth_init() {
     firstSID->reset();
     firstSID->enable_filter(true);
@@ -143,76 +232,358 @@ void C64::synth_init() {
     thirdSID->reset();
     thirdSID->enable_filter(true);
     thirdSID->enable_external_filter(true);
+}
 
-    interp_config cfg = interp_default_config();
-    interp_config_set_blend(&cfg, true);
-    interp_config_set_signed(&cfg, true);
-    interp_set_config(interp0, 0, &cfg);
+/* Clocks one chip from cycle from of the frame up to cycle to, applying its
+   queued register writes at the cycle they were made on. */
+static int HOT_FUNC(clockChip)(SID *sid, uint8_t chip, short *buffer, int len, cycle_count from, cycle_count to) {
+    cycle_count clocked = from;
+    int samples = 0;
+    for (int i = 0; i <= sidWriteCount; i++) {
+        cycle_count until = to;
+        if (i < sidWriteCount) {
+            if (sidWriteQueue[i].chip != chip) continue;
+            until = std::min(static_cast<cycle_count>(sidWriteQueue[i].cycle), to);
+        }
+        cycle_count delta_t = until - clocked;
+        if (delta_t > 0) {
+            samples += sid->clock(delta_t, buffer + samples, len - samples);
+            clocked = until;
+        }
+        if (i < sidWriteCount) {
+            sid->write(sidWriteQueue[i].reg, sidWriteQueue[i].value);
+        }
+    }
+    return samples;
+}
 
-    cfg = interp_default_config();
-    interp_set_config(interp0, 1, &cfg);
+/* Clocks one chip through the frame like clockChip, only without sampling its
+   output, which leaves out the resampler and most of the cost. */
+static void HOT_FUNC(skipChip)(SID *sid, uint8_t chip) {
+    cycle_count clocked = flushedCycles;
+    for (int i = 0; i < sidWriteCount; i++) {
+        if (sidWriteQueue[i].chip != chip) continue;
+        const cycle_count until = std::min(static_cast<cycle_count>(sidWriteQueue[i].cycle), bufferCycles);
+        sid->skip(until - clocked);
+        clocked = until;
+        sid->write(sidWriteQueue[i].reg, sidWriteQueue[i].value);
+    }
+    sid->skip(bufferCycles - clocked);
 }
 
-inline int C64::renderAndMix(short *buffer, size_t len, float volumeFactor) {
-    cycle_count delta_t = initialCycleCount;
-    const int sampleCount = firstSID->clock(delta_t, buffer, static_cast<int>(len));
+static int HOT_FUNC(renderChip)(SID *sid, uint8_t chip, int len, cycle_count until) {
+    return sidSamples[chip] += clockChip(sid, chip, sidBuffers[chip] + sidSamples[chip], len - sidSamples[chip],
+                                         flushedCycles, until);
+}
 
+void HOT_FUNC(C64::renderExtraSids)() {
     if (secondSidAddr) {
-        delta_t = initialCycleCount;
-        secondSID->clock_and_mix(delta_t, buffer, static_cast<int>(len));
+        renderChip(secondSID, 1, MAX_SAMPLES_PER_BUFFER, bufferCycles);
+    }
+    if (thirdSidAddr) {
+        renderChip(thirdSID, 2, MAX_SAMPLES_PER_BUFFER, bufferCycles);
     }
+}
 
+// Writes made past the end of the buffer by an overrunning play call are
+// applied at its end, so that is where they are recorded.
+static void recordQueuedWrites() {
+    for (int i = 0; i < sidWriteCount; i++) {
+        const SidWrite &write = sidWriteQueue[i];
+        SidStream::write(streamCycles + std::min(write.cycle, static_cast<uint32_t>(bufferCycles)),
+                         write.chip, write.reg, write.value);
+    }
+}
+
+/* Makes room in a full write queue by clocking every chip of the tune up to
+   the cycle of the write that didn't fit, so that it and every write after it
+   still land in order. The chips are rendered on this core, which only
+   happens in the rare frame that writes more than the queue holds. */
+static void flushSidWrites(cycle_count until) {
+    until = std::min(until, bufferCycles);
+    renderChip(firstSID, 0, MAX_SAMPLES_PER_BUFFER, until);
+    if (secondSidAddr) {
+        renderChip(secondSID, 1, MAX_SAMPLES_PER_BUFFER, until);
+    }
     if (thirdSidAddr) {
-        delta_t = initialCycleCount;
-        thirdSID->clock_and_mix(delta_t, buffer, static_cast<int>(len));
+        renderChip(thirdSID, 2, MAX_SAMPLES_PER_BUFFER, until);
+    }
+    if (recording) {
+        recordQueuedWrites();
+    }
+    sidWriteCount = 0;
+    flushedCycles = until;
+}
+
+/* The second and third SID of a buffer are rendered on core0 when it gets to
+   them in time. Core1 posts the job and rings core0 through the inter-core
+   FIFO, whose interrupt only takes note, and core0 renders the chips from its
+   main loop. Whichever core claims the posted job under the spin lock renders
+   it, so if core0 hasn't got to it by the time core1 is done with the first
+   chip, core1 renders the other two as well rather than wait. */
+enum ExtraSidJob : uint8_t {
+    NO_JOB,
+    JOB_POSTED,
+    JOB_TAKEN,
+    JOB_DONE
+};
+
+static volatile uint8_t extraSidJob = NO_JOB;
+static volatile bool extraSidsRung = false;
+static spin_lock_t *extraSidLock = nullptr;
+
+static bool HOT_FUNC(claimExtraSids)() {
+    const uint32_t saved = spin_lock_blocking(extraSidLock);
+    const bool claimed = extraSidJob == JOB_POSTED;
+    if (claimed) {
+        extraSidJob = JOB_TAKEN;
+    }
+    spin_unlock(extraSidLock, saved);
+    return claimed;
+}
+
+static void HOT_FUNC(extraSidFifoHandler)() {
+    while (multicore_fifo_rvalid()) {
+        if (multicore_fifo_pop_blocking() == RENDER_EXTRA_SIDS_FIFO_FLAG) {
+            extraSidsRung = true;
+        }
+    }
+    multicore_fifo_clear_irq();
+}
+
+void C64::enableParallelRendering() {
+    extraSidLock = spin_lock_init(spin_lock_claim_unused(true));
+    irq_add_shared_handler(SIO_IRQ_PROC0, extraSidFifoHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(SIO_IRQ_PROC0, true);
+    parallelRendering = true;
+}
+
+void HOT_FUNC(C64::serviceParallelRendering)() {
+    if (!extraSidsRung) return;
+    extraSidsRung = false;
+    if (claimExtraSids()) {
+        renderExtraSids();
+        __dmb();
+        extraSidJob = JOB_DONE;
+    }
+}
+
+/* Renders every chip of the tune into its own buffer and hands them to the
+   mixer, which writes interleaved stereo frames to buffer and a mono copy to
+   the visualization capture. */
+int HOT_FUNC(C64::renderAndMix)(short *buffer, size_t len) {
+    const bool extraSids = secondSidAddr || thirdSidAddr;
+    const bool parallel = extraSids && parallelRendering;
+    if (parallel) {
+        __dmb();
+        extraSidJob = JOB_POSTED;
+        if (multicore_fifo_wready()) {
+            multicore_fifo_push_blocking(RENDER_EXTRA_SIDS_FIFO_FLAG);
+        }
     }
 
-    dma_channel_configure(
-        visDMAChan,
-        &visDMACfg,
-        visualizationBuffer + currentVisualizationBufferOffset,
-        buffer,
-        std::min(sampleCount, FFT_SAMPLES - currentVisualizationBufferOffset),
-        true
-    );
+    renderChip(firstSID, 0, std::min(static_cast<int>(len), MAX_SAMPLES_PER_BUFFER), bufferCycles);
 
-    currentVisualizationBufferOffset += sampleCount;
-    if (currentVisualizationBufferOffset >= FFT_SAMPLES) {
-        currentVisualizationBufferOffset = 0;
+    if (parallel) {
+        if (claimExtraSids()) {
+            renderExtraSids();
+        } else {
+            while (extraSidJob != JOB_DONE) {
+            }
+            __dmb();
+        }
+        extraSidJob = NO_JOB;
+    } else if (extraSids) {
+        renderExtraSids();
     }
 
-    for (int i = 0; i < sampleCount; i++) {
-        // TODO: Can bit shifting or integer division be used here?
-        buffer[i] = static_cast<short>(static_cast<float>(buffer[i]) * volumeFactor);
+    const short *chips[MIXER_MAX_CHIPS] = {sidBuffers[0]};
+    int chipSamples[MIXER_MAX_CHIPS] = {sidSamples[0]};
+    int chipCount = 1;
+    if (secondSidAddr) {
+        chips[chipCount] = sidBuffers[1];
+        chipSamples[chipCount++] = sidSamples[1];
     }
+    if (thirdSidAddr) {
+        chips[chipCount] = sidBuffers[2];
+        chipSamples[chipCount++] = sidSamples[2];
+    }
+
+    AudioStats::sidsRendered();
+    int tapRoom;
+    short *tap = VisualizationCapture::tap(tapRoom);
+    const int sampleCount = Mixer::mix(chips, chipSamples, buffer, tap, tapRoom);
+    VisualizationCapture::captured(sampleCount);
 
     return sampleCount;
 }
 
 /*
 * C64 Mem Routines
+*
+* The 64K address space is split into 256 pages. A page is either backed
+* directly by memory[] or a ROM image, which makes an access a single indexed
+* load or store, or by a handler. Only the I/O pages that actually host a chip
+* get handlers, and only as long as the 6510 port at $01 banks I/O in.
 */
+typedef unsigned char (*PageReadHandler)(unsigned short addr);
+
+typedef void (*PageWriteHandler)(unsigned short addr, unsigned char value);
+
+static const unsigned char *readPages[256];
+static unsigned char *writePages[256];
+static const unsigned char *codePages[256];
+static PageReadHandler readHandlers[256];
+static PageWriteHandler writeHandlers[256];
+
+// SID chip (or -1) for each $20 byte slot of the I/O pages $D0xx-$DFxx.
+static int8_t ioSidSlots[IO_PAGE_COUNT][8];
+
+// Instruction and operand fetches. I/O pages fetch from the RAM below them.
+static inline unsigned char fetch(unsigned short addr) {
+    return codePages[addr >> 8][addr & 0xff];
+}
+
 static inline unsigned char getmem(unsigned short addr) {
+    if (const unsigned char *page = readPages[addr >> 8]) {
+        return page[addr & 0xff];
+    }
+    return readHandlers[addr >> 8](addr);
+}
+
+static inline void setmem(unsigned short addr, unsigned char value) {
+    if (unsigned char *page = writePages[addr >> 8]) {
+        page[addr & 0xff] = value;
+    } else {
+        writeHandlers[addr >> 8](addr, value);
+    }
+}
+
+static inline int8_t sidAt(unsigned short addr) {
+    return ioSidSlots[(addr >> 8) - IO_FIRST_PAGE][(addr >> 5) & 7];
+}
+
+static unsigned char HOT_FUNC(ioPageRead)(unsigned short addr) {
+    const unsigned char page = addr >> 8;
+    if (const int8_t sid = sidAt(addr); sid >= 0) {
+        return C64::sidPeek(addr & 0x1f, sid);
+    }
+    if (page < 0xd4) {
+        return Timeline::vicRead(addr & 0x3f, cycle_counter);
+    }
+    if (page == 0xdc || page == 0xdd) {
+        return Timeline::ciaRead(page - 0xdc, addr & 0x0f, cycle_counter);
+    }
     return memory[addr];
 }
 
+static void HOT_FUNC(ioPageWrite)(unsigned short addr, unsigned char value) {
+    const unsigned char page = addr >> 8;
+    if (const int8_t sid = sidAt(addr); sid >= 0) {
+        if (queueSidWrites) {
+            const uint32_t cycle = cycle_counter - frameStart;
+            if (sidWriteCount == SID_WRITE_QUEUE_SIZE) {
+                flushSidWrites(static_cast<cycle_count>(std::min(cycle, static_cast<uint32_t>(bufferCycles))));
+            }
+            sidWriteQueue[sidWriteCount++] = {cycle, static_cast<uint8_t>(sid), static_cast<uint8_t>(addr & 0x1f), value};
+        } else {
+            C64::sidPoke(addr & 0x1f, value, sid);
+        }
+        return;
+    }
+    if (page < 0xd4) {
+        Timeline::vicWrite(addr & 0x3f, value, cycle_counter);
+    } else if (page == 0xdc || page == 0xdd) {
+        Timeline::ciaWrite(page - 0xdc, addr & 0x0f, value, cycle_counter);
+    }
+    memory[addr] = value;
+}
+
+static bool pageHasChip(unsigned char page) {
+    if (page < 0xd4 || page == 0xdc || page == 0xdd) {
+        return true;
+    }
+    for (const int8_t sid: ioSidSlots[page - IO_FIRST_PAGE]) {
+        if (sid >= 0) return true;
+    }
+    return false;
+}
+
+/* Maps BASIC, KERNAL, character ROM and I/O according to the LORAM, HIRAM and
+   CHAREN bits of the 6510 port. PSID tunes keep the old ROM-less layout, which
+   is the same as $35: RAM everywhere but the I/O area. */
+static void mapBanks() {
+    const unsigned char bank = timelineMode ? cpuPort & 7 : 5;
+    const bool basic = (bank & 3) == 3;
+    const bool kernal = bank & 2;
+    const bool io = bank & 3 && bank & 4;
+    const bool characters = bank & 3 && !(bank & 4);
+
+    for (int page = 0xa0; page < 0xc0; page++) {
+        readPages[page] = basic ? &rom_basic[(page - 0xa0) << 8] : &memory[page << 8];
+        codePages[page] = readPages[page];
+    }
+    for (int page = 0xe0; page < 0x100; page++) {
+        readPages[page] = kernal ? &rom_kernal[(page - 0xe0) << 8] : &memory[page << 8];
+        codePages[page] = readPages[page];
+    }
+    for (int page = 0xd0; page < 0xe0; page++) {
+        if (io && pageHasChip(page)) {
+            readPages[page] = nullptr;
+            writePages[page] = nullptr;
+            readHandlers[page] = ioPageRead;
+            writeHandlers[page] = ioPageWrite;
+        } else {
+            readPages[page] = characters ? &rom_characters[(page - 0xd0) << 8] : &memory[page << 8];
+            writePages[page] = &memory[page << 8];
+        }
+    }
+}
+
+// Only used on the timeline, where a write to $01 switches banks.
+static void HOT_FUNC(zeroPageWrite)(unsigned short addr, unsigned char value) {
+    memory[addr] = value;
+    if (addr == 0x0001) {
+        const unsigned char changed = (value ^ cpuPort) & 7;
+        cpuPort = value;
+        if (changed) mapBanks();
+    }
+}
+
+static void mapSid(unsigned short addr, int8_t sid) {
+    if (addr < IO_FIRST_PAGE << 8) {
+        return;
+    }
+    ioSidSlots[(addr >> 8) - IO_FIRST_PAGE][(addr >> 5) & 7] = sid;
+}
+
+void C64::mapMemory() {
+    for (int page = 0; page < 256; page++) {
+        readPages[page] = &memory[page << 8];
+        writePages[page] = &memory[page << 8];
+        codePages[page] = &memory[page << 8];
+    }
+    memset(ioSidSlots, -1, sizeof(ioSidSlots));
+    mapSid(firstSidAddr, 0);
+    if (secondSidAddr) mapSid(secondSidAddr, 1);
+    if (thirdSidAddr) mapSid(thirdSidAddr, 2);
+    if (timelineMode) {
+        writePages[0] = nullptr;
+        writeHandlers[0] = zeroPageWrite;
+    }
+    mapBanks();
+}
+
 void C64::dumpMem(unsigned short startAddr, unsigned short endAddr) {
     for (unsigned short addr = startAddr; addr <= endAddr; ++addr) {
         printf("0x%04X: 0x%02X\n", addr, getmem(addr));
     }
 }
 
-static void setmem(unsigned short addr, unsigned char value) {
-    if (addr >= firstSidAddr && addr < firstSidAddr + 0x20) {
-        C64::sidPoke(addr & 0x1f, value, 0);
-    } else if (secondSidAddr && (addr >= secondSidAddr && addr < secondSidAddr + 0x20)) {
-        C64::sidPoke(addr & 0x1f, value, 1);
-    } else if (thirdSidAddr && (addr >= thirdSidAddr && addr < thirdSidAddr + 0x20)) {
-        C64::sidPoke(addr & 0x1f, value, 2);
-    } else memory[addr] = value;
-}
-
 void C64::sidPoke(int reg, unsigned char val, int8_t sid) {
+    if (recording) {
+        SidStream::write(streamCycles, sid, reg, val);
+    }
     switch (sid) {
         case 0:
             firstSID->write(reg, val);
@@ -227,463 +598,436 @@ void C64::sidPoke(int reg, unsigned char val, int8_t sid) {
     }
 }
 
-reg8 C64::sidPeek(unsigned short reg) {
-    return firstSID->read(reg);
+reg8 C64::sidPeek(unsigned short reg, int8_t sid) {
+    switch (sid) {
+        case 1:
+            return secondSID->read(reg);
+        case 2:
+            return thirdSID->read(reg);
+        default:
+            return firstSID->read(reg);
+    }
 }
 
-static inline unsigned char getaddr(int mode) {
+/*
+* Addressing modes. Every instruction handler below is instantiated for its
+* own mode, so the mode is resolved at compile time and the operand access is
+* inlined into the handler instead of being switched on at run time.
+*/
+template<int Mode>
+static inline unsigned short operandAddress() {
     unsigned short ad, ad2;
-    switch (mode) {
-        case imp:
-            return 0;
-        case imm:
-            return getmem(pc++);
-        case _abs:
-            ad = getmem(pc++);
-            ad |= 256 * getmem(pc++);
-            return getmem(ad);
-        case absx:
-            ad = getmem(pc++);
-            ad |= 256 * getmem(pc++);
-            ad2 = ad + x;
-            return getmem(ad2);
-        case absy:
-            ad = getmem(pc++);
-            ad |= 256 * getmem(pc++);
-            ad2 = ad + y;
-            return getmem(ad2);
-        case zp:
-            ad = getmem(pc++);
-            return getmem(ad);
-        case zpx:
-            ad = getmem(pc++);
-            ad += x;
-            return getmem(ad & 0xff);
-        case zpy:
-            ad = getmem(pc++);
-            ad += y;
-            return getmem(ad & 0xff);
-        case indx:
-            ad = getmem(pc++);
-            ad += x;
-            ad2 = getmem(ad & 0xff);
-            ad++;
-            ad2 |= getmem(ad & 0xff) << 8;
-            return getmem(ad2);
-        case indy:
-            ad = getmem(pc++);
-            ad2 = getmem(ad);
-            ad2 |= getmem((ad + 1) & 0xff) << 8;
-            ad = ad2 + y;
-            return getmem(ad);
-        case acc:
-            return a;
-        default:
-            return 0;
+    if constexpr (Mode == _abs) {
+        ad = fetch(pc++);
+        ad |= fetch(pc++) << 8;
+        return ad;
+    } else if constexpr (Mode == absx || Mode == absy) {
+        ad = fetch(pc++);
+        ad |= fetch(pc++) << 8;
+        return ad + (Mode == absx ? x : y);
+    } else if constexpr (Mode == zp) {
+        return fetch(pc++);
+    } else if constexpr (Mode == zpx || Mode == zpy) {
+        ad = fetch(pc++);
+        ad += Mode == zpx ? x : y;
+        return ad & 0xff;
+    } else if constexpr (Mode == indx) {
+        ad = fetch(pc++);
+        ad += x;
+        ad2 = getmem(ad & 0xff);
+        ad++;
+        ad2 |= getmem(ad & 0xff) << 8;
+        return ad2;
+    } else if constexpr (Mode == indy) {
+        ad = fetch(pc++);
+        ad2 = getmem(ad);
+        ad2 |= getmem((ad + 1) & 0xff) << 8;
+        return ad2 + y;
+    } else {
+        return 0;
     }
 }
 
-static void setaddr(int mode, unsigned char val) {
-    unsigned short ad, ad2;
-    switch (mode) {
-        case _abs:
-            ad = getmem(pc - 2);
-            ad |= 256 * getmem(pc - 1);
-            setmem(ad, val);
-            return;
-        case absx:
-            ad = getmem(pc - 2);
-            ad |= 256 * getmem(pc - 1);
-            ad2 = ad + x;
-            setmem(ad2, val);
-            return;
-        case zp:
-            ad = getmem(pc - 1);
-            setmem(ad, val);
-            return;
-        case zpx:
-            ad = getmem(pc - 1);
-            ad += x;
-            setmem(ad & 0xff, val);
-            return;
-        case acc:
-            a = val;
-        default: ;
-    }
-}
-
-
-static void putaddr(int mode, unsigned char val) {
-    unsigned short ad, ad2;
-    switch (mode) {
-        case _abs:
-            ad = getmem(pc++);
-            ad |= getmem(pc++) << 8;
-            setmem(ad, val);
-            return;
-        case absx:
-            ad = getmem(pc++);
-            ad |= getmem(pc++) << 8;
-            ad2 = ad + x;
-            setmem(ad2, val);
-            return;
-        case absy:
-            ad = getmem(pc++);
-            ad |= getmem(pc++) << 8;
-            ad2 = ad + y;
-            setmem(ad2, val);
-            return;
-        case zp:
-            ad = getmem(pc++);
-            setmem(ad, val);
-            return;
-        case zpx:
-            ad = getmem(pc++);
-            ad += x;
-            setmem(ad & 0xff, val);
-            return;
-        case zpy:
-            ad = getmem(pc++);
-            ad += y;
-            setmem(ad & 0xff, val);
-            return;
-        case indx:
-            ad = getmem(pc++);
-            ad += x;
-            ad2 = getmem(ad & 0xff);
-            ad++;
-            ad2 |= getmem(ad & 0xff) << 8;
-            setmem(ad2, val);
-            return;
-        case indy:
-            ad = getmem(pc++);
-            ad2 = getmem(ad);
-            ad2 |= getmem((ad + 1) & 0xff) << 8;
-            ad = ad2 + y;
-            setmem(ad, val);
-            return;
-        case acc:
-            a = val;
-        default: ;
-    }
-}
-
-
-static void setflags(int flag, int cond) {
+template<int Mode>
+static constexpr bool isAddressable() {
+    return Mode == _abs || Mode == absx || Mode == absy || Mode == zp || Mode == zpx || Mode == zpy
+           || Mode == indx || Mode == indy;
+}
+
+template<int Mode>
+static inline unsigned char getaddr() {
+    if constexpr (Mode == imm) {
+        return fetch(pc++);
+    } else if constexpr (Mode == acc) {
+        return a;
+    } else if constexpr (Mode == absx || Mode == absy || Mode == indy) {
+        // Indexed reads take an extra cycle when the index crosses a page.
+        const unsigned short ad = operandAddress<Mode>();
+        const unsigned char index = Mode == absx ? x : y;
+        cycle_counter += (ad & 0xff) < index;
+        return getmem(ad);
+    } else if constexpr (isAddressable<Mode>()) {
+        return getmem(operandAddress<Mode>());
+    } else {
+        return 0;
+    }
+}
+
+template<int Mode>
+static inline void putaddr(unsigned char val) {
+    if constexpr (Mode == acc) {
+        a = val;
+    } else if constexpr (isAddressable<Mode>()) {
+        setmem(operandAddress<Mode>(), val);
+    }
+}
+
+// Read-modify-write instructions resolve their operand address once and use
+// it for both the load and the store.
+template<int Mode>
+static inline unsigned short modifyAddress() {
+    if constexpr (Mode == acc) {
+        return 0;
+    } else {
+        return operandAddress<Mode>();
+    }
+}
+
+template<int Mode>
+static inline unsigned char modifyLoad(unsigned short ad) {
+    if constexpr (Mode == acc) {
+        return a;
+    } else {
+        return getmem(ad);
+    }
+}
+
+template<int Mode>
+static inline void modifyStore(unsigned short ad, unsigned char val) {
+    if constexpr (Mode == acc) {
+        a = val;
+    } else {
+        setmem(ad, val);
+    }
+}
+
+
+static inline void setflags(int flag, int cond) {
     if (cond) p |= flag;
     else p &= ~flag;
 }
 
 
-static void push(unsigned char val) {
-    setmem(0x100 + s, val);
+// The stack page is always RAM, so it bypasses the page table.
+static inline void push(unsigned char val) {
+    memory[0x100 + s] = val;
     if (s) s--;
 }
 
-static unsigned char pop() {
+static inline unsigned char pop() {
     if (s < 0xff) s++;
-    return getmem(0x100 + s);
+    return memory[0x100 + s];
 }
 
-static void branch(int flag) {
+static inline void branch(int flag) {
     signed char dist;
-    dist = (signed char) getaddr(imm);
+    dist = (signed char) getaddr<imm>();
     wval = pc + dist;
-    if (flag) pc = wval;
+    if (flag) {
+        cycle_counter += 1 + ((pc ^ wval) >> 8 != 0);
+        pc = wval;
+    }
+}
+
+static void HOT_FUNC(interrupt)(unsigned short vector) {
+    push(pc >> 8);
+    push(pc & 0xff);
+    push((p & ~FLAG_B) | 0x20);
+    p |= FLAG_I;
+    pc = getmem(vector);
+    pc |= getmem(vector + 1) << 8;
+    cycle_counter += 7;
 }
 
 void C64::cpuReset() {
     a = x = y = 0;
     p = 0;
     s = 255;
-    pc = getaddr(0xfffc);
+    pc = getmem(0xfffc) | getmem(0xfffd) << 8;
 }
 
-static void cpuParse() {
-    unsigned char opc = getmem(pc++);
-    int cmd = opcodes[opc];
-    int addr = modes[opc];
+template<int Cmd, int Mode, int Cycles>
+__attribute__((always_inline)) static inline void execute() {
     int c;
-    switch (cmd) {
-        case adc:
-            wval = (unsigned short) a + getaddr(addr) + ((p & FLAG_C) ? 1 : 0);
-            setflags(FLAG_C, wval & 0x100);
-            a = (unsigned char) wval;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            setflags(FLAG_V, (!!(p & FLAG_C)) ^ (!!(p & FLAG_N)));
-            break;
-        case _and:
-            bval = getaddr(addr);
-            a &= bval;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case asl:
-            wval = getaddr(addr);
-            wval <<= 1;
-            setaddr(addr, (unsigned char) wval);
-            setflags(FLAG_Z, !wval);
-            setflags(FLAG_N, wval & 0x80);
-            setflags(FLAG_C, wval & 0x100);
-            break;
-        case bcc:
-            branch(!(p & FLAG_C));
-            break;
-        case bcs:
-            branch(p & FLAG_C);
-            break;
-        case bne:
-            branch(!(p & FLAG_Z));
-            break;
-        case beq:
-            branch(p & FLAG_Z);
-            break;
-        case bpl:
-            branch(!(p & FLAG_N));
-            break;
-        case bmi:
-            branch(p & FLAG_N);
-            break;
-        case bvc:
-            branch(!(p & FLAG_V));
-            break;
-        case bvs:
-            branch(p & FLAG_V);
-            break;
-        case bit:
-            bval = getaddr(addr);
-            setflags(FLAG_Z, !(a & bval));
-            setflags(FLAG_N, bval & 0x80);
-            setflags(FLAG_V, bval & 0x40);
-            break;
-        case _brk:
-            pc = 0; /* Just quit the emulation */
-            break;
-        case clc:
-            setflags(FLAG_C, 0);
-            break;
-        case cld:
-            setflags(FLAG_D, 0);
-            break;
-        case cli:
-            setflags(FLAG_I, 0);
-            break;
-        case clv:
-            setflags(FLAG_V, 0);
-            break;
-        case cmp:
-            bval = getaddr(addr);
-            wval = static_cast<unsigned short>(a) - bval;
-            setflags(FLAG_Z, !wval);
-            setflags(FLAG_N, wval & 0x80);
-            setflags(FLAG_C, a >= bval);
-            break;
-        case cpx:
-            bval = getaddr(addr);
-            wval = static_cast<unsigned short>(x) - bval;
-            setflags(FLAG_Z, !wval);
-            setflags(FLAG_N, wval & 0x80);
-            setflags(FLAG_C, x >= bval);
-            break;
-        case cpy:
-            bval = getaddr(addr);
-            wval = static_cast<unsigned short>(y) - bval;
-            setflags(FLAG_Z, !wval);
-            setflags(FLAG_N, wval & 0x80);
-            setflags(FLAG_C, y >= bval);
-            break;
-        case dec:
-            bval = getaddr(addr);
-            bval--;
-            setaddr(addr, bval);
-            setflags(FLAG_Z, !bval);
-            setflags(FLAG_N, bval & 0x80);
-            break;
-        case dex:
-            x--;
-            setflags(FLAG_Z, !x);
-            setflags(FLAG_N, x & 0x80);
-            break;
-        case dey:
-            y--;
-            setflags(FLAG_Z, !y);
-            setflags(FLAG_N, y & 0x80);
-            break;
-        case eor:
-            bval = getaddr(addr);
-            a ^= bval;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case inc:
-            bval = getaddr(addr);
-            bval++;
-            setaddr(addr, bval);
-            setflags(FLAG_Z, !bval);
-            setflags(FLAG_N, bval & 0x80);
-            break;
-        case inx:
-            x++;
-            setflags(FLAG_Z, !x);
-            setflags(FLAG_N, x & 0x80);
-            break;
-        case iny:
-            y++;
-            setflags(FLAG_Z, !y);
-            setflags(FLAG_N, y & 0x80);
-            break;
-        case jmp:
-            wval = getmem(pc++);
-            wval |= 256 * getmem(pc++);
-            switch (addr) {
-                case _abs:
-                    pc = wval;
-                    break;
-                case ind:
-                    pc = getmem(wval);
-                    pc |= 256 * getmem(wval + 1);
-                    break;
-                default: ;
-            }
-            break;
-        case jsr:
-            push((pc + 1) >> 8);
-            push((pc + 1));
-            wval = getmem(pc++);
-            wval |= 256 * getmem(pc++);
+    cycle_counter += Cycles;
+    if constexpr (Cmd == adc) {
+        wval = (unsigned short) a + getaddr<Mode>() + ((p & FLAG_C) ? 1 : 0);
+        setflags(FLAG_C, wval & 0x100);
+        a = (unsigned char) wval;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+        setflags(FLAG_V, (!!(p & FLAG_C)) ^ (!!(p & FLAG_N)));
+    } else if constexpr (Cmd == _and) {
+        bval = getaddr<Mode>();
+        a &= bval;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == asl) {
+        const unsigned short ad = modifyAddress<Mode>();
+        wval = modifyLoad<Mode>(ad);
+        wval <<= 1;
+        modifyStore<Mode>(ad, (unsigned char) wval);
+        setflags(FLAG_Z, !wval);
+        setflags(FLAG_N, wval & 0x80);
+        setflags(FLAG_C, wval & 0x100);
+    } else if constexpr (Cmd == bcc) {
+        branch(!(p & FLAG_C));
+    } else if constexpr (Cmd == bcs) {
+        branch(p & FLAG_C);
+    } else if constexpr (Cmd == bne) {
+        branch(!(p & FLAG_Z));
+    } else if constexpr (Cmd == beq) {
+        branch(p & FLAG_Z);
+    } else if constexpr (Cmd == bpl) {
+        branch(!(p & FLAG_N));
+    } else if constexpr (Cmd == bmi) {
+        branch(p & FLAG_N);
+    } else if constexpr (Cmd == bvc) {
+        branch(!(p & FLAG_V));
+    } else if constexpr (Cmd == bvs) {
+        branch(p & FLAG_V);
+    } else if constexpr (Cmd == bit) {
+        bval = getaddr<Mode>();
+        setflags(FLAG_Z, !(a & bval));
+        setflags(FLAG_N, bval & 0x80);
+        setflags(FLAG_V, bval & 0x40);
+    } else if constexpr (Cmd == _brk) {
+        pc = 0; /* Just quit the emulation */
+    } else if constexpr (Cmd == clc) {
+        setflags(FLAG_C, 0);
+    } else if constexpr (Cmd == cld) {
+        setflags(FLAG_D, 0);
+    } else if constexpr (Cmd == cli) {
+        setflags(FLAG_I, 0);
+    } else if constexpr (Cmd == clv) {
+        setflags(FLAG_V, 0);
+    } else if constexpr (Cmd == cmp || Cmd == cpx || Cmd == cpy) {
+        const unsigned char reg = Cmd == cmp ? a : Cmd == cpx ? x : y;
+        bval = getaddr<Mode>();
+        wval = static_cast<unsigned short>(reg) - bval;
+        setflags(FLAG_Z, !wval);
+        setflags(FLAG_N, wval & 0x80);
+        setflags(FLAG_C, reg >= bval);
+    } else if constexpr (Cmd == dec || Cmd == inc) {
+        const unsigned short ad = modifyAddress<Mode>();
+        bval = modifyLoad<Mode>(ad);
+        bval += Cmd == inc ? 1 : -1;
+        modifyStore<Mode>(ad, bval);
+        setflags(FLAG_Z, !bval);
+        setflags(FLAG_N, bval & 0x80);
+    } else if constexpr (Cmd == dex) {
+        x--;
+        setflags(FLAG_Z, !x);
+        setflags(FLAG_N, x & 0x80);
+    } else if constexpr (Cmd == dey) {
+        y--;
+        setflags(FLAG_Z, !y);
+        setflags(FLAG_N, y & 0x80);
+    } else if constexpr (Cmd == eor) {
+        bval = getaddr<Mode>();
+        a ^= bval;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == inx) {
+        x++;
+        setflags(FLAG_Z, !x);
+        setflags(FLAG_N, x & 0x80);
+    } else if constexpr (Cmd == iny) {
+        y++;
+        setflags(FLAG_Z, !y);
+        setflags(FLAG_N, y & 0x80);
+    } else if constexpr (Cmd == jmp) {
+        wval = fetch(pc++);
+        wval |= 256 * fetch(pc++);
+        if constexpr (Mode == _abs) {
             pc = wval;
-            break;
-        case lda:
-            a = getaddr(addr);
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case ldx:
-            x = getaddr(addr);
-            setflags(FLAG_Z, !x);
-            setflags(FLAG_N, x & 0x80);
-            break;
-        case ldy:
-            y = getaddr(addr);
-            setflags(FLAG_Z, !y);
-            setflags(FLAG_N, y & 0x80);
-            break;
-        case lsr:
-            bval = getaddr(addr);
-            wval = (unsigned char) bval;
-            wval >>= 1;
-            setaddr(addr, (unsigned char) wval);
-            setflags(FLAG_Z, !wval);
-            setflags(FLAG_N, wval & 0x80);
-            setflags(FLAG_C, bval & 1);
-            break;
-        case _nop:
-            break;
-        case ora:
-            bval = getaddr(addr);
-            a |= bval;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case pha:
-            push(a);
-            break;
-        case php:
-            push(p);
-            break;
-        case pla:
-            a = pop();
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case plp:
+        } else if constexpr (Mode == ind) {
+            pc = getmem(wval);
+            pc |= 256 * getmem(wval + 1);
+        }
+    } else if constexpr (Cmd == jsr) {
+        push((pc + 1) >> 8);
+        push((pc + 1));
+        wval = fetch(pc++);
+        wval |= 256 * fetch(pc++);
+        pc = wval;
+    } else if constexpr (Cmd == lda) {
+        a = getaddr<Mode>();
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == ldx) {
+        x = getaddr<Mode>();
+        setflags(FLAG_Z, !x);
+        setflags(FLAG_N, x & 0x80);
+    } else if constexpr (Cmd == ldy) {
+        y = getaddr<Mode>();
+        setflags(FLAG_Z, !y);
+        setflags(FLAG_N, y & 0x80);
+    } else if constexpr (Cmd == lsr) {
+        const unsigned short ad = modifyAddress<Mode>();
+        bval = modifyLoad<Mode>(ad);
+        wval = (unsigned char) bval;
+        wval >>= 1;
+        modifyStore<Mode>(ad, (unsigned char) wval);
+        setflags(FLAG_Z, !wval);
+        setflags(FLAG_N, wval & 0x80);
+        setflags(FLAG_C, bval & 1);
+    } else if constexpr (Cmd == ora) {
+        bval = getaddr<Mode>();
+        a |= bval;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == pha) {
+        push(a);
+    } else if constexpr (Cmd == php) {
+        push(p);
+    } else if constexpr (Cmd == pla) {
+        a = pop();
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == plp) {
+        p = pop();
+    } else if constexpr (Cmd == rol) {
+        const unsigned short ad = modifyAddress<Mode>();
+        bval = modifyLoad<Mode>(ad);
+        c = !!(p & FLAG_C);
+        setflags(FLAG_C, bval & 0x80);
+        bval <<= 1;
+        bval |= c;
+        modifyStore<Mode>(ad, bval);
+        setflags(FLAG_N, bval & 0x80);
+        setflags(FLAG_Z, !bval);
+    } else if constexpr (Cmd == ror) {
+        const unsigned short ad = modifyAddress<Mode>();
+        bval = modifyLoad<Mode>(ad);
+        c = !!(p & FLAG_C);
+        setflags(FLAG_C, bval & 1);
+        bval >>= 1;
+        bval |= 128 * c;
+        modifyStore<Mode>(ad, bval);
+        setflags(FLAG_N, bval & 0x80);
+        setflags(FLAG_Z, !bval);
+    } else if constexpr (Cmd == rti) {
+        if (timelineMode) {
             p = pop();
-            break;
-        case rol:
-            bval = getaddr(addr);
-            c = !!(p & FLAG_C);
-            setflags(FLAG_C, bval & 0x80);
-            bval <<= 1;
-            bval |= c;
-            setaddr(addr, bval);
-            setflags(FLAG_N, bval & 0x80);
-            setflags(FLAG_Z, !bval);
-            break;
-        case ror:
-            bval = getaddr(addr);
-            c = !!(p & FLAG_C);
-            setflags(FLAG_C, bval & 1);
-            bval >>= 1;
-            bval |= 128 * c;
-            setaddr(addr, bval);
-            setflags(FLAG_N, bval & 0x80);
-            setflags(FLAG_Z, !bval);
-            break;
-        case rti:
-        /* Treat RTI like RTS */
-        case rts:
+            wval = pop();
+            wval |= pop() << 8;
+            pc = wval;
+        } else {
+            /* PSID play routines may end with RTI, treat it like RTS */
             wval = pop();
             wval |= pop() << 8;
             pc = wval + 1;
-            break;
-        case sbc:
-            bval = getaddr(addr) ^ 0xff;
-            wval = (unsigned short) a + bval + ((p & FLAG_C) ? 1 : 0);
-            setflags(FLAG_C, wval & 0x100);
-            a = (unsigned char) wval;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a > 127);
-            setflags(FLAG_V, (!!(p & FLAG_C)) ^ (!!(p & FLAG_N)));
-            break;
-        case sec:
-            setflags(FLAG_C, 1);
-            break;
-        case sed:
-            setflags(FLAG_D, 1);
-            break;
-        case sei:
-            setflags(FLAG_I, 1);
-            break;
-        case sta:
-            putaddr(addr, a);
-            break;
-        case stx:
-            putaddr(addr, x);
-            break;
-        case sty:
-            putaddr(addr, y);
-            break;
-        case tax:
-            x = a;
-            setflags(FLAG_Z, !x);
-            setflags(FLAG_N, x & 0x80);
-            break;
-        case tay:
-            y = a;
-            setflags(FLAG_Z, !y);
-            setflags(FLAG_N, y & 0x80);
-            break;
-        case tsx:
-            x = s;
-            setflags(FLAG_Z, !x);
-            setflags(FLAG_N, x & 0x80);
-            break;
-        case txa:
-            a = x;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        case txs:
-            s = x;
-            break;
-        case tya:
-            a = y;
-            setflags(FLAG_Z, !a);
-            setflags(FLAG_N, a & 0x80);
-            break;
-        default: ;
+        }
+    } else if constexpr (Cmd == rts) {
+        wval = pop();
+        wval |= pop() << 8;
+        pc = wval + 1;
+    } else if constexpr (Cmd == sbc) {
+        bval = getaddr<Mode>() ^ 0xff;
+        wval = (unsigned short) a + bval + ((p & FLAG_C) ? 1 : 0);
+        setflags(FLAG_C, wval & 0x100);
+        a = (unsigned char) wval;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a > 127);
+        setflags(FLAG_V, (!!(p & FLAG_C)) ^ (!!(p & FLAG_N)));
+    } else if constexpr (Cmd == sec) {
+        setflags(FLAG_C, 1);
+    } else if constexpr (Cmd == sed) {
+        setflags(FLAG_D, 1);
+    } else if constexpr (Cmd == sei) {
+        setflags(FLAG_I, 1);
+    } else if constexpr (Cmd == sta) {
+        putaddr<Mode>(a);
+    } else if constexpr (Cmd == stx) {
+        putaddr<Mode>(x);
+    } else if constexpr (Cmd == sty) {
+        putaddr<Mode>(y);
+    } else if constexpr (Cmd == tax) {
+        x = a;
+        setflags(FLAG_Z, !x);
+        setflags(FLAG_N, x & 0x80);
+    } else if constexpr (Cmd == tay) {
+        y = a;
+        setflags(FLAG_Z, !y);
+        setflags(FLAG_N, y & 0x80);
+    } else if constexpr (Cmd == tsx) {
+        x = s;
+        setflags(FLAG_Z, !x);
+        setflags(FLAG_N, x & 0x80);
+    } else if constexpr (Cmd == txa) {
+        a = x;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
+    } else if constexpr (Cmd == txs) {
+        s = x;
+    } else if constexpr (Cmd == tya) {
+        a = y;
+        setflags(FLAG_Z, !a);
+        setflags(FLAG_N, a & 0x80);
     }
+    (void) c;
+}
+
+/*
+* One handler per opcode, generated from the opcodes[], modes[] and cycles[]
+* tables at compile time. Dispatching an instruction is a single indirect call.
+*
+* The handlers are plain functions with the template inlined into them, as GCC
+* ignores the section attribute on function templates and HOT_FUNC has to be
+* able to move the handlers to SRAM.
+*/
+typedef void (*InstructionHandler)();
+
+#define INSTRUCTION_HANDLER(op) \
+    static void HOT_FUNC(execute_##op)() { execute<opcodes[op], modes[op], cycles[op]>(); }
+#define INSTRUCTION_HANDLERS(hi) \
+    INSTRUCTION_HANDLER(hi##0) INSTRUCTION_HANDLER(hi##1) INSTRUCTION_HANDLER(hi##2) INSTRUCTION_HANDLER(hi##3) \
+    INSTRUCTION_HANDLER(hi##4) INSTRUCTION_HANDLER(hi##5) INSTRUCTION_HANDLER(hi##6) INSTRUCTION_HANDLER(hi##7) \
+    INSTRUCTION_HANDLER(hi##8) INSTRUCTION_HANDLER(hi##9) INSTRUCTION_HANDLER(hi##a) INSTRUCTION_HANDLER(hi##b) \
+    INSTRUCTION_HANDLER(hi##c) INSTRUCTION_HANDLER(hi##d) INSTRUCTION_HANDLER(hi##e) INSTRUCTION_HANDLER(hi##f)
+#define DISPATCH_ENTRIES(hi) \
+    &execute_##hi##0, &execute_##hi##1, &execute_##hi##2, &execute_##hi##3, \
+    &execute_##hi##4, &execute_##hi##5, &execute_##hi##6, &execute_##hi##7, \
+    &execute_##hi##8, &execute_##hi##9, &execute_##hi##a, &execute_##hi##b, \
+    &execute_##hi##c, &execute_##hi##d, &execute_##hi##e, &execute_##hi##f
+
+INSTRUCTION_HANDLERS(0x0)
+INSTRUCTION_HANDLERS(0x1)
+INSTRUCTION_HANDLERS(0x2)
+INSTRUCTION_HANDLERS(0x3)
+INSTRUCTION_HANDLERS(0x4)
+INSTRUCTION_HANDLERS(0x5)
+INSTRUCTION_HANDLERS(0x6)
+INSTRUCTION_HANDLERS(0x7)
+INSTRUCTION_HANDLERS(0x8)
+INSTRUCTION_HANDLERS(0x9)
+INSTRUCTION_HANDLERS(0xa)
+INSTRUCTION_HANDLERS(0xb)
+INSTRUCTION_HANDLERS(0xc)
+INSTRUCTION_HANDLERS(0xd)
+INSTRUCTION_HANDLERS(0xe)
+INSTRUCTION_HANDLERS(0xf)
+
+HOT_DATA static constexpr InstructionHandler dispatchTable[256] = {
+        DISPATCH_ENTRIES(0x0), DISPATCH_ENTRIES(0x1), DISPATCH_ENTRIES(0x2), DISPATCH_ENTRIES(0x3),
+        DISPATCH_ENTRIES(0x4), DISPATCH_ENTRIES(0x5), DISPATCH_ENTRIES(0x6), DISPATCH_ENTRIES(0x7),
+        DISPATCH_ENTRIES(0x8), DISPATCH_ENTRIES(0x9), DISPATCH_ENTRIES(0xa), DISPATCH_ENTRIES(0xb),
+        DISPATCH_ENTRIES(0xc), DISPATCH_ENTRIES(0xd), DISPATCH_ENTRIES(0xe), DISPATCH_ENTRIES(0xf)
+};
+
+static inline void cpuParse() {
+    dispatchTable[fetch(pc++)]();
 }
 
 void C64::cpuJSR(unsigned short npc, unsigned char na) {
@@ -700,7 +1044,19 @@ void C64::cpuJSR(unsigned short npc, unsigned char na) {
         cpuParse();
 }
 
-bool C64::cpuJSRWithWatchdog(unsigned short npc, unsigned char na) {
+uint32_t C64::getInstructionCount() {
+    return frame_instructions;
+}
+
+uint32_t C64::getCycleCount() {
+    return busy_cycles;
+}
+
+uint32_t C64::getPlayCallCount() {
+    return play_calls;
+}
+
+bool HOT_FUNC(C64::cpuJSRWithWatchdog)(unsigned short npc, unsigned char na) {
     watchdog_counter = 0;
     a = na;
     x = 0;
@@ -720,6 +1076,13 @@ bool C64::cpuJSRWithWatchdog(unsigned short npc, unsigned char na) {
 void C64::c64Init() {
     synth_init();
     memset(memory, 0, sizeof(memory));
+    secondSidAddr = 0;
+    thirdSidAddr = 0;
+    timelineMode = false;
+    frameStart = 0;
+    cpuPort = 0x37;
+    Timeline::reset(cycle_counter, true);
+    mapMemory();
     cpuReset();
 }
 
@@ -728,22 +1091,172 @@ bool C64::useCIA() {
 }
 
 // ReSharper disable once CppDFAUnreachableFunctionCall
-volatile bool C64::tryJSRToPlayAddr() {
-    if (!cpuJSRWithWatchdog(info.play, 0)) {
-        return false;
+volatile bool HOT_FUNC(C64::tryJSRToPlayAddr)() {
+    const uint32_t callStart = cycle_counter;
+    queueSidWrites = true;
+    const bool returned = cpuJSRWithWatchdog(info.play, 0);
+    queueSidWrites = false;
+    frame_instructions += watchdog_counter;
+    busy_cycles += cycle_counter - callStart;
+    play_calls++;
+    return returned;
+}
+
+/* Runs the CPU up to the end of the frame, taking interrupts as the timeline
+   raises them. Once the code has returned to the idle address (init returned
+   or BRK) the time up to the next event is skipped rather than emulated. */
+static void HOT_FUNC(runTimeline)(uint32_t frameEnd) {
+    uint32_t idleCycles = 0;
+    watchdog_counter = 0;
+    while (Timeline::isBefore(cycle_counter, frameEnd)) {
+        const uint32_t next = Timeline::nextEventTime(cycle_counter);
+        if (!Timeline::isBefore(cycle_counter, next)) {
+            Timeline::runEvents(cycle_counter);
+        } else if (Timeline::takeNmi()) {
+            interrupt(0xfffa);
+        } else if (Timeline::irq() && !(p & FLAG_I)) {
+            interrupt(0xfffe);
+        } else if (pc <= 1) {
+            const uint32_t until = Timeline::isBefore(next, frameEnd) ? next : frameEnd;
+            idleCycles += until - cycle_counter;
+            cycle_counter = until;
+            p &= ~FLAG_I;
+        } else {
+            cpuParse();
+            watchdog_counter++;
+        }
     }
-    return true;
+    frame_instructions = watchdog_counter;
+    busy_cycles = bufferCycles - idleCycles;
+}
+
+static void startTimeline(uint16_t song) {
+    a = song;
+    x = 0;
+    y = 0;
+    p = FLAG_I;
+    s = 255;
+    pc = info.init;
+    push(0);
+    push(0);
+}
+
+/* Fills the write queue from the stream up to the end of the next buffer,
+   flushing it whenever it is full. At the end of the recording the chips are
+   reset and the stream starts over. */
+static void HOT_FUNC(readStreamFrame)() {
+    if (streamCycles >= streamLength) {
+        C64::synth_init();
+        SidStream::rewind();
+        streamWritePending = SidStream::read(nextStreamWrite);
+        streamCycles = 0;
+    }
+    const uint32_t end = streamCycles + bufferCycles;
+    while (streamWritePending && nextStreamWrite.cycle < end) {
+        const SidStreamWrite &write = nextStreamWrite;
+        // A write from before the buffer, which only a stream picked up part
+        // way through can have, is made on its first cycle.
+        const int32_t cycle = std::max(static_cast<int32_t>(write.cycle - streamCycles), 0);
+        if (sidWriteCount == SID_WRITE_QUEUE_SIZE) {
+            flushSidWrites(cycle);
+        }
+        sidWriteQueue[sidWriteCount++] = {static_cast<uint32_t>(cycle), write.chip, write.reg, write.value};
+        streamWritePending = SidStream::read(nextStreamWrite);
+    }
+}
+
+/* Makes every play call that falls within the next buffer, each one starting
+   at its scheduled cycle. A call that overruns the next one delays it, just
+   like a late interrupt would on the real machine. */
+static bool HOT_FUNC(runPlayCalls)() {
+    bool returned = true;
+    while (nextCall16 >> 16 < static_cast<uint64_t>(bufferCycles)) {
+        const uint32_t callStart = frameStart + static_cast<uint32_t>(nextCall16 >> 16);
+        if (Timeline::isBefore(cycle_counter, callStart)) {
+            cycle_counter = callStart;
+        }
+        returned &= C64::tryJSRToPlayAddr();
+        nextCall16 += static_cast<uint64_t>(cyclesPerCall) << 16;
+    }
+    nextCall16 -= static_cast<uint64_t>(bufferCycles) << 16;
+    return returned;
+}
+
+volatile bool HOT_FUNC(C64::runFrame)() {
+    bufferRemainder16 += bufferCycles16;
+    bufferCycles = static_cast<cycle_count>(bufferRemainder16 >> 16);
+    bufferRemainder16 &= 0xffff;
+
+    sidWriteCount = 0;
+    flushedCycles = 0;
+    memset(sidSamples, 0, sizeof(sidSamples));
+    frame_instructions = 0;
+    busy_cycles = 0;
+    play_calls = 0;
+    bool returned = true;
+    if (streamPlayback) {
+        readStreamFrame();
+    } else if (timelineMode) {
+        queueSidWrites = true;
+        runTimeline(frameStart + bufferCycles);
+        queueSidWrites = false;
+    } else {
+        returned = runPlayCalls();
+    }
+    if (recording) {
+        recordQueuedWrites();
+    }
+    streamCycles += bufferCycles;
+    frameStart += bufferCycles;
+    return returned;
 }
 
-volatile bool C64::clock(audio_buffer *buffer, float volumeFactor) {
+volatile bool C64::clock(audio_buffer *buffer) {
     auto *samples = reinterpret_cast<int16_t *>(buffer->buffer->bytes);
-    if (tryJSRToPlayAddr()) {
-        buffer->sample_count = renderAndMix(samples, sampleCount, volumeFactor);
+    AudioStats::bufferStarted();
+    if (runFrame()) {
+        AudioStats::playRoutineDone();
+        buffer->sample_count = renderAndMix(samples, MAX_SAMPLES_PER_BUFFER);
+        AudioStats::bufferRendered(buffer->sample_count, sampleRate);
         return true;
     }
+    AudioStats::watchdogAborted();
     return false;
 }
 
+bool C64::skipFrame() {
+    const bool returned = runFrame();
+    skipChip(firstSID, 0);
+    if (secondSidAddr) {
+        skipChip(secondSID, 1);
+    }
+    if (thirdSidAddr) {
+        skipChip(thirdSID, 2);
+    }
+    return returned;
+}
+
+/* Gets to a point in the current song, in milliseconds from its start, by
+   running it there a buffer at a time without rendering any samples. Seeking
+   backwards starts the song over. The chips are clocked all the same, as a
+   tune may read back voice 3. Returns false if any play call hung, which
+   doesn't stop the seek, just as it doesn't stop playback. */
+bool C64::seek(uint32_t millis) {
+    const uint32_t position = millisSinceSongStart();
+    if (millis < position) {
+        playSong(currentSong);
+    }
+    const uint32_t cpuFrequency = info.isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
+    uint64_t cycles = static_cast<uint64_t>(millis - std::min(millis, millisSinceSongStart())) * cpuFrequency / 1000;
+    bool returned = true;
+    while (cycles > 0) {
+        returned &= skipFrame();
+        cycles -= std::min(cycles, static_cast<uint64_t>(bufferCycles));
+    }
+    songStartMillis = System::millis_now() - millis;
+    return returned;
+}
+
 uint32_t C64::millisSinceSongStart() {
     return System::millis_now() - songStartMillis;
 }
@@ -756,39 +1269,207 @@ int C64::songIsLoaded() {
     return songLoaded;
 }
 
+void C64::setSamplingMethod(sampling_method method) {
+    samplingMethodForced = true;
+    forcedSamplingMethod = method;
+}
+
+void C64::setSongSamplingMethod(int song, sampling_method method) {
+    if (song < 0) {
+        tuneSamplingMethod = method + 1;
+    } else if (song < MAX_SONGS) {
+        songSamplingMethods[song] = method + 1;
+    }
+}
+
+void C64::clearSongSamplingMethods() {
+    tuneSamplingMethod = 0;
+    memset(songSamplingMethods, 0, sizeof(songSamplingMethods));
+}
+
+bool C64::setSampleRate(uint32_t rate) {
+    if (rate && std::find(std::begin(sampleRates), std::end(sampleRates), rate) == std::end(sampleRates)) {
+        printf("Sample rate %u not supported\n", static_cast<unsigned int>(rate));
+        return false;
+    }
+    forcedSampleRate = rate;
+    return true;
+}
+
+uint32_t C64::getSampleRate() {
+    return sampleRate;
+}
+
+bool C64::startRecording(const TCHAR *path) {
+    streamPlayback = false;
+    recording = SidStream::create(path);
+    streamCycles = 0;
+    return recording;
+}
+
+bool C64::stopRecording() {
+    if (!recording) return false;
+    recording = false;
+    return SidStream::finish({static_cast<uint8_t>(currentSong), info.isPAL, info.load, info.init, info.play,
+                              info.songs, streamCycles});
+}
+
+bool C64::playStream(const TCHAR *path) {
+    SidStreamHeader header;
+    if (recording || !SidStream::open(path, header)) return false;
+    if (header.song != currentSong || header.isPAL != info.isPAL || header.load != info.load
+        || header.init != info.init || header.play != info.play || header.songs != info.songs
+        || !header.lengthCycles) {
+        printf("%s was not recorded from song %d of this tune\n", path, currentSong + 1);
+        SidStream::close();
+        return false;
+    }
+    /* The stream starts with the writes made by init, on chips fresh from a
+       reset. Further into the song, as after a seek or a snapshot, the chips
+       are already where the stream has them, and it is picked up from there. */
+    if (!streamCycles) {
+        synth_init();
+    }
+    streamLength = header.lengthCycles;
+    do {
+        streamWritePending = SidStream::read(nextStreamWrite);
+    } while (streamWritePending && nextStreamWrite.cycle < streamCycles);
+    streamPlayback = true;
+    printf("Playing song %d from %s\n", currentSong + 1, path);
+    return true;
+}
+
+bool C64::isPlayingStream() {
+    return streamPlayback;
+}
+
+void C64::enableBlockClocking(bool enable) {
+    firstSID->enable_block_clocking(enable);
+    secondSID->enable_block_clocking(enable);
+    thirdSID->enable_block_clocking(enable);
+}
+
+static void setSamplingParameters(SID *sid, float cpuFrequency, sampling_method method) {
+    if (!sid->set_sampling_parameters(cpuFrequency, method, sampleRate)) {
+        printf("Sampling method %d not supported, using fast sampling\n", method);
+        sid->set_sampling_parameters(cpuFrequency, SAMPLE_FAST, sampleRate);
+    }
+}
+
+/* A method forced on the host goes first, then the one set for the song, then
+   the one set for the tune, and then the default for the number of chips, as
+   resampling only fits the render budget of a single chip. */
+static sampling_method songSamplingMethod() {
+    if (samplingMethodForced) {
+        return forcedSamplingMethod;
+    }
+    if (currentSong < MAX_SONGS && songSamplingMethods[currentSong]) {
+        return static_cast<sampling_method>(songSamplingMethods[currentSong] - 1);
+    }
+    if (tuneSamplingMethod) {
+        return static_cast<sampling_method>(tuneSamplingMethod - 1);
+    }
+    return secondSidAddr || thirdSidAddr ? MULTI_SID_SAMPLING_METHOD : SINGLE_SID_SAMPLING_METHOD;
+}
+
+static void setUpSampling(sampling_method method) {
+    const float cpuFrequency = info.isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
+    const bool extraSids = secondSidAddr || thirdSidAddr;
+    sampleRate = forcedSampleRate ? forcedSampleRate : extraSids ? MULTI_SID_SAMPLE_RATE : SINGLE_SID_SAMPLE_RATE;
+    samplingMethod = method;
+    setSamplingParameters(firstSID, cpuFrequency, method);
+    if (secondSidAddr) {
+        setSamplingParameters(secondSID, cpuFrequency, method);
+    }
+    if (thirdSidAddr) {
+        setSamplingParameters(thirdSID, cpuFrequency, method);
+    }
+}
+
 bool C64::playSong(uint16_t song) {
     if (song >= info.songs) return false;
     currentSong = song;
-    cpuJSR(info.init, currentSong);
-    float cpuFrequency = PAL_CPU_FREQUENCY;
-    float speedFactor = info.isPAL ? PAL_SPEED_FACTOR : NTSC_SPEED_FACTOR;
-
-    if (useCIA()) {
-        uint_least64_t cia1TimerAValue = endian_little16(&memory[0xdc04]);
-        printf("CIA1 Timer A: %llu\n", cia1TimerAValue);
-        // TODO: This is a bit arbitrary. Figure out how to calculate this properly.
-        sampleCount = MAX_SAMPLES_PER_BUFFER * static_cast<float>(cia1TimerAValue) / (19500 / speedFactor);
+    // A stream only stands in for the song it was recorded from.
+    streamPlayback = false;
+    streamCycles = 0;
+    if (recording) {
+        SidStream::restart();
+    }
+    Timeline::reset(cycle_counter, info.isPAL);
+    if (timelineMode) {
+        startTimeline(currentSong);
     } else {
-        sampleCount = MAX_SAMPLES_PER_BUFFER * speedFactor;
+        cpuJSR(info.init, currentSong);
     }
+    const uint32_t cpuFrequency = info.isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
 
-    cpuFrequency = info.isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
-
-    firstSID->set_sampling_parameters(cpuFrequency, SAMPLE_FAST, SAMPLE_RATE);
-    if (secondSidAddr) {
-        secondSID->set_sampling_parameters(cpuFrequency, SAMPLE_FAST, SAMPLE_RATE);
+    // Timeline tunes have no play calls, their buffers are just sized to a frame.
+    if (useCIA() && !timelineMode) {
+        const uint16_t cia1TimerAValue = Timeline::ciaTimerLatch(0, 0);
+        printf("CIA1 Timer A: %u\n", cia1TimerAValue);
+        cyclesPerCall = cia1TimerAValue + 1;
+    } else {
+        cyclesPerCall = info.isPAL ? PAL_CYCLES_PER_FRAME : NTSC_CYCLES_PER_FRAME;
     }
-    if (thirdSidAddr) {
-        thirdSID->set_sampling_parameters(cpuFrequency, SAMPLE_FAST, SAMPLE_RATE);
+
+    const uint32_t maxBufferCycles = cpuFrequency / BUFFERS_PER_SECOND;
+    if (cyclesPerCall <= maxBufferCycles) {
+        bufferCycles16 = static_cast<uint64_t>(maxBufferCycles / cyclesPerCall * cyclesPerCall) << 16;
+    } else {
+        const uint32_t buffersPerCall = (cyclesPerCall + maxBufferCycles - 1) / maxBufferCycles;
+        bufferCycles16 = (static_cast<uint64_t>(cyclesPerCall) << 16) / buffersPerCall;
     }
-    initialCycleCount = static_cast<cycle_count>(cpuFrequency) / (
-                            static_cast<float>(SAMPLE_RATE) / static_cast<float>(sampleCount));
+    bufferRemainder16 = 0;
+    nextCall16 = 0;
+    frameStart = cycle_counter;
 
+    setUpSampling(songSamplingMethod());
     songStartMillis = System::millis_now();
 
     return true;
 }
 
+static void loadPowerOnRam() {
+    unsigned short addr = 0;
+    for (size_t i = 0; i < sizeof(powerOnRam);) {
+        unsigned char offset = powerOnRam[i++];
+        unsigned char count = 0;
+        bool repeated = false;
+        if (offset & 0x80) {
+            offset &= 0x7f;
+            count = powerOnRam[i++];
+            if (count & 0x80) {
+                count &= 0x7f;
+                repeated = true;
+            }
+        }
+        addr += offset;
+        for (int n = 0; n <= count; n++) {
+            memory[addr++] = repeated ? powerOnRam[i] : powerOnRam[i++];
+        }
+        if (repeated) i++;
+    }
+}
+
+// The bank a PSID tune expects, based on where its code lives.
+static unsigned char psidBank(unsigned short addr) {
+    if (addr < 0xa000) return 0x37;
+    if (addr < 0xd000) return 0x36;
+    if (addr >= 0xe000) return 0x35;
+    return 0x34;
+}
+
+// Maps and sets up the chips the tune asks for in its header.
+static void setUpChips() {
+    secondSidAddr = (info.sidChipBase2) ? (info.sidChipBase2 * 0x10) + 0xD000 : 0;
+    thirdSidAddr = (info.sidChipBase3) ? (info.sidChipBase3 * 0x10) + 0xD000 : 0;
+    C64::mapMemory();
+    Mixer::setChipCount(1 + (secondSidAddr != 0) + (thirdSidAddr != 0));
+
+    firstSID->set_chip_model(info.sid1is8580 ? MOS8580 : MOS6581);
+    secondSID->set_chip_model(info.sid2is8580 ? MOS8580 : MOS6581);
+}
+
 bool C64::sid_load_from_file(TCHAR file_name[]) {
     info = {};
     songLoaded = false;
@@ -803,40 +1484,157 @@ bool C64::sid_load_from_file(TCHAR file_name[]) {
 
     print_sid_info();
 
-    if (info.originalFileFormat) {
-        f_lseek(&pFile, info.data + 2);
+    timelineMode = !info.isPSID || info.play == 0;
+    if (timelineMode) {
+        loadPowerOnRam();
+        cpuPort = info.isPSID ? psidBank(info.init) : 0x37;
+        memory[0x0001] = cpuPort;
     }
-    uint16_t offset = info.load;
-    while (true) {
-        BYTE buffer[SID_LOAD_BUFFER_SIZE];
-        f_read(&pFile, buffer, SID_LOAD_BUFFER_SIZE, &bytesRead);
-        if (bytesRead == 0) break;
-        for (int i = 0; i < bytesRead; i++) {
-            setmem(offset++, buffer[i]);
-        }
+
+    /* The data goes straight into memory[] with one read, which FatFs passes on
+       to the disk a cluster at a time. The read is bounded by the data the file
+       holds, and by the top of memory: anything past $ffff is left in the file
+       rather than wrapping around into the zero page. */
+    const FSIZE_t dataStart = info.data + (info.originalFileFormat ? 2 : 0);
+    if (f_size(&pFile) <= dataStart) {
+        f_close(&pFile);
+        return false;
+    }
+    const UINT length = std::min(f_size(&pFile) - dataStart, static_cast<FSIZE_t>(sizeof(memory) - info.load));
+    if (f_lseek(&pFile, dataStart) != FR_OK || f_read(&pFile, &memory[info.load], length, &bytesRead) != FR_OK
+        || bytesRead != length) {
+        f_close(&pFile);
+        return false;
     }
     f_close(&pFile);
 
-    secondSidAddr = (info.sidChipBase2) ? (info.sidChipBase2 * 0x10) + 0xD000 : 0;
-    thirdSidAddr = (info.sidChipBase3) ? (info.sidChipBase3 * 0x10) + 0xD000 : 0;
+    setUpChips();
+    songLoaded = true;
 
-    firstSID->set_chip_model(info.sid1is8580 ? MOS8580 : MOS6581);
-    secondSID->set_chip_model(info.sid2is8580 ? MOS8580 : MOS6581);
+    return playSong(info.start);
+}
 
-    if (info.play == 0) {
-        if (!cpuJSRWithWatchdog(info.init, 0)) return false;
-        info.play = (memory[0xffff] << 8) | memory[0xfffe];
+/* Everything about the CPU and the song that isn't kept in memory[], the chips
+   or the timeline. */
+struct MachineState {
+    SidInfo info;
+    uint16_t currentSong;
+    uint32_t songMillis;
+    uint32_t songCycles;
+    uint8_t samplingMethod;
+    unsigned char a, x, y, s, p;
+    unsigned short pc;
+    unsigned char cpuPort;
+    bool timelineMode;
+    uint32_t cycleCounter;
+    uint32_t frameStart;
+    uint32_t cyclesPerCall;
+    uint64_t bufferCycles16;
+    uint64_t bufferRemainder16;
+    uint64_t nextCall16;
+};
+
+static constexpr uint32_t SNAPSHOT_STATE_SIZE = MAX_PATH_LENGTH + sizeof(MachineState) + sizeof(Timeline::State)
+                                                + 3 * sizeof(SID::State) + sizeof(memory);
+
+/* Taken between two buffers, so there are no queued writes to save. A song
+   played from a stream is saved at its place in the song, and the stream is
+   picked up from there once the snapshot is restored. */
+bool C64::saveSnapshot(const TCHAR *path, const TCHAR *tunePath) {
+    if (!songLoaded || !Snapshot::create(path, SNAPSHOT_STATE_SIZE)) return false;
+    TCHAR tune[MAX_PATH_LENGTH] = {};
+    strncpy(tune, tunePath, MAX_PATH_LENGTH - 1);
+    Snapshot::write(tune, MAX_PATH_LENGTH);
+    const MachineState machine = {
+        info, currentSong, millisSinceSongStart(), streamCycles, static_cast<uint8_t>(samplingMethod),
+        a, x, y, s, p, pc, cpuPort, timelineMode,
+        cycle_counter, frameStart, cyclesPerCall, bufferCycles16, bufferRemainder16, nextCall16
+    };
+    Snapshot::write(&machine, sizeof(machine));
+    Timeline::State timeline;
+    Timeline::readState(timeline);
+    Snapshot::write(&timeline, sizeof(timeline));
+    for (SID *sid: {firstSID, secondSID, thirdSID}) {
+        const SID::State chip = sid->read_state();
+        Snapshot::write(&chip, sizeof(chip));
     }
+    Snapshot::writeMemory(memory, sizeof(memory));
+    return Snapshot::finish();
+}
 
+/* Puts the machine back as it was when the snapshot was saved, without
+   loading the tune again, and gives back the path of the tune. A snapshot
+   that can't be read in full leaves no tune loaded. */
+bool C64::loadSnapshot(const TCHAR *path, TCHAR *tunePath) {
+    if (!Snapshot::open(path, SNAPSHOT_STATE_SIZE)) return false;
+    c64Init();
+    songLoaded = false;
+    MachineState machine;
+    bool ok = Snapshot::read(tunePath, MAX_PATH_LENGTH) && Snapshot::read(&machine, sizeof(machine));
+    if (ok) {
+        info = machine.info;
+        currentSong = machine.currentSong;
+        a = machine.a;
+        x = machine.x;
+        y = machine.y;
+        s = machine.s;
+        p = machine.p;
+        pc = machine.pc;
+        cpuPort = machine.cpuPort;
+        timelineMode = machine.timelineMode;
+        cycle_counter = machine.cycleCounter;
+        frameStart = machine.frameStart;
+        cyclesPerCall = machine.cyclesPerCall;
+        bufferCycles16 = machine.bufferCycles16;
+        bufferRemainder16 = machine.bufferRemainder16;
+        nextCall16 = machine.nextCall16;
+        streamCycles = machine.songCycles;
+        setUpChips();
+        // Sets up the resampler from scratch, so it goes before the chip state.
+        // The song carries on with the method it was saved with.
+        setUpSampling(static_cast<sampling_method>(machine.samplingMethod));
+
+        Timeline::State timeline;
+        ok = Snapshot::read(&timeline, sizeof(timeline));
+        Timeline::writeState(timeline);
+    }
+    for (SID *sid: {firstSID, secondSID, thirdSID}) {
+        SID::State chip;
+        if (ok && (ok = Snapshot::read(&chip, sizeof(chip)))) {
+            sid->write_state(chip);
+        }
+    }
+    ok = ok && Snapshot::readMemory(memory, sizeof(memory));
+    Snapshot::close();
+    if (!ok) {
+        c64Init();
+        return false;
+    }
+    tunePath[MAX_PATH_LENGTH - 1] = 0;
+    songStartMillis = System::millis_now() - machine.songMillis;
     songLoaded = true;
-
-    return playSong(info.start);
+    return true;
 }
 
 SidInfo *C64::getSidInfo() {
     return &info;
 }
 
+int C64::readVoices(VoiceReadout voices[MAX_VOICES]) {
+    int count = 0;
+    for (SID *sid: {firstSID, secondSID, thirdSID}) {
+        if ((sid == secondSID && !secondSidAddr) || (sid == thirdSID && !thirdSidAddr)) continue;
+        SID::VoiceState state[3];
+        sid->read_voices(state);
+        for (const SID::VoiceState &voice: state) {
+            voices[count++] = {
+                voice.freq, voice.pw, static_cast<uint8_t>(voice.waveform), static_cast<uint8_t>(voice.envelope)
+            };
+        }
+    }
+    return count;
+}
+
 void C64::print_sid_info() {
     printf("Version: %d\n", info.version);
     printf("Data: %d\n", info.data);
@@ -46,16 +46,24 @@ struct SidInfo {
     bool isPAL;
 };
 
+// What a SID voice is playing, for the visualization.
+struct VoiceReadout {
+    uint16_t freq;
+    uint16_t pw;
+    uint8_t waveform;
+    uint8_t envelope;
+};
+
+#define MAX_VOICES  9
+
 //----------------------------------------------
 class C64 {
 public:
-    static void begin();
-
     static void synth_init();
 
     static void sidPoke(int reg, unsigned char val, int8_t sid);
 
-    static reg8 sidPeek(unsigned short reg);
+    static reg8 sidPeek(unsigned short reg, int8_t sid = 0);
 
     static void cpuReset();
 
@@ -63,13 +71,28 @@ public:
 
     static bool cpuJSRWithWatchdog(unsigned short npc, unsigned char na);
 
+    static uint32_t getInstructionCount();
+
+    static uint32_t getCycleCount();
+
+    static uint32_t getPlayCallCount();
+
     static void c64Init();
 
+    static void mapMemory();
+
     static bool useCIA();
 
     static volatile bool tryJSRToPlayAddr();
 
-    static volatile bool clock(audio_buffer *buffer, float volumeFactor);
+    static volatile bool runFrame();
+
+    static volatile bool clock(audio_buffer *buffer);
+
+    // Runs a frame like clock, clocking the chips without rendering a sample.
+    static bool skipFrame();
+
+    static bool seek(uint32_t millis);
 
     static uint32_t millisSinceSongStart();
 
@@ -79,15 +102,62 @@ public:
 
     static bool playSong(uint16_t song);
 
+    // Overrides the per tune choice of sampling method from the next song on.
+    static void setSamplingMethod(sampling_method method);
+
+    // The sampling method chosen in the settings of the tune about to be
+    // loaded, for one song or, with a song below 0, for all of them.
+    static void setSongSamplingMethod(int song, sampling_method method);
+
+    static void clearSongSamplingMethods();
+
+    // Overrides the per tune choice of output sample rate from the next song
+    // on, or goes back to it with 0.
+    static bool setSampleRate(uint32_t rate);
+
+    static uint32_t getSampleRate();
+
+    // Records every SID write from the next song started on, until stopped.
+    // Starting another song starts the recording over.
+    static bool startRecording(const TCHAR *path);
+
+    static bool stopRecording();
+
+    // Plays the current song from a stream recorded from it instead of
+    // running the 6502, until another song is started.
+    static bool playStream(const TCHAR *path);
+
+    static bool isPlayingStream();
+
+    // The tune path is kept in the snapshot, and loadSnapshot gives it back
+    // in a buffer of MAX_PATH_LENGTH.
+    static bool saveSnapshot(const TCHAR *path, const TCHAR *tunePath);
+
+    static bool loadSnapshot(const TCHAR *path, TCHAR *tunePath);
+
+    static void enableBlockClocking(bool enable);
+
     static bool sid_load_from_file(TCHAR file_name[]);
 
     static SidInfo *getSidInfo();
 
+    // Fills in three voices per chip of the loaded tune and returns how many.
+    // Read from core0 while core1 plays, so a voice may be a write behind.
+    static int readVoices(VoiceReadout voices[MAX_VOICES]);
+
     static void print_sid_info();
 
     static void readHeader(BYTE *buffer, SidInfo &info);
 
-    static int renderAndMix(short *buffer, size_t len, float volumeFactor);
+    static int renderAndMix(short *buffer, size_t len);
+
+    static void renderExtraSids();
+
+    static void enableParallelRendering();
+
+    // Called by core0 whenever it can: renders the extra chips of the buffer
+    // core1 is working on, if they are still waiting for it.
+    static void serviceParallelRendering();
 
     static void dumpMem(unsigned short startAddr, unsigned short endAddr);
 };
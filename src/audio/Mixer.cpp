@@ -0,0 +1,111 @@
+#include "Mixer.h"
+
+#include "../platform_config.h"
+
+int Mixer::chipCount = 1;
+int16_t Mixer::chipGain[MIXER_MAX_CHIPS] = {MIXER_UNITY_GAIN, MIXER_UNITY_GAIN, MIXER_UNITY_GAIN};
+int16_t Mixer::chipPan[MIXER_MAX_CHIPS] = {MIXER_PAN_CENTER, MIXER_PAN_CENTER, MIXER_PAN_CENTER};
+int32_t Mixer::mixGain[MIXER_MAX_CHIPS] = {MIXER_UNITY_GAIN, MIXER_UNITY_GAIN, MIXER_UNITY_GAIN};
+volatile int32_t Mixer::requestedVolume = MIXER_UNITY_GAIN;
+int32_t Mixer::masterVolume = MIXER_UNITY_GAIN;
+int32_t Mixer::channelGain[MIXER_MAX_CHIPS][2] = {
+    {MIXER_UNITY_GAIN, MIXER_UNITY_GAIN},
+    {MIXER_UNITY_GAIN, MIXER_UNITY_GAIN},
+    {MIXER_UNITY_GAIN, MIXER_UNITY_GAIN}
+};
+
+static int16_t clamp16(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(value);
+}
+
+// The stereo layout 2SID and 3SID tunes are written for: the second chip on
+// the left, the third on the right, and the first in the middle of a 3SID.
+void Mixer::setChipCount(int chips) {
+    chipCount = chips < 1 ? 1 : chips > MIXER_MAX_CHIPS ? MIXER_MAX_CHIPS : chips;
+    switch (chipCount) {
+        case 2:
+            chipGain[0] = chipGain[1] = MIXER_UNITY_GAIN;
+            chipPan[0] = MIXER_PAN_LEFT;
+            chipPan[1] = MIXER_PAN_RIGHT;
+            break;
+        case 3:
+            chipGain[0] = chipGain[1] = chipGain[2] = MIXER_UNITY_GAIN / 2;
+            chipPan[0] = MIXER_PAN_CENTER;
+            chipPan[1] = MIXER_PAN_LEFT;
+            chipPan[2] = MIXER_PAN_RIGHT;
+            break;
+        default:
+            chipGain[0] = MIXER_UNITY_GAIN;
+            chipPan[0] = MIXER_PAN_CENTER;
+            break;
+    }
+    updateChannelGains();
+}
+
+void Mixer::setChip(int chip, int16_t gain, int16_t pan) {
+    if (chip < 0 || chip >= MIXER_MAX_CHIPS) return;
+    chipGain[chip] = gain;
+    chipPan[chip] = pan;
+    updateChannelGains();
+}
+
+void Mixer::setVolume(uint8_t volume) {
+    requestedVolume = volume >= VOLUME_STEPS ? MIXER_UNITY_GAIN : volume * MIXER_UNITY_GAIN / VOLUME_STEPS;
+}
+
+/* Balance panning: the channel the chip is panned towards keeps the full
+   gain and the other one is attenuated, so a centered chip is at full level
+   in both channels. */
+void Mixer::updateChannelGains() {
+    int32_t totalGain = 0;
+    for (int chip = 0; chip < chipCount; chip++) {
+        totalGain += chipGain[chip] < 0 ? -chipGain[chip] : chipGain[chip];
+    }
+    for (int chip = 0; chip < MIXER_MAX_CHIPS; chip++) {
+        mixGain[chip] = totalGain > MIXER_MAX_TOTAL_GAIN
+                            ? chipGain[chip] * MIXER_MAX_TOTAL_GAIN / totalGain
+                            : chipGain[chip];
+        const int32_t pan = chipPan[chip];
+        const int32_t left = pan > 0 ? MIXER_UNITY_GAIN - pan : MIXER_UNITY_GAIN;
+        const int32_t right = pan < 0 ? MIXER_UNITY_GAIN + pan : MIXER_UNITY_GAIN;
+        const int32_t gain = mixGain[chip] * masterVolume >> 15;
+        channelGain[chip][0] = gain * left >> 15;
+        channelGain[chip][1] = gain * right >> 15;
+    }
+}
+
+int HOT_FUNC(Mixer::mix)(const short *const chips[], const int chipSamples[], short *out, short *monoTap,
+               int monoTapSamples) {
+    if (const int32_t volume = requestedVolume; volume != masterVolume) {
+        masterVolume = volume;
+        updateChannelGains();
+    }
+
+    int samples = chipSamples[0];
+    for (int chip = 1; chip < chipCount; chip++) {
+        if (chipSamples[chip] < samples) samples = chipSamples[chip];
+    }
+
+    for (int i = 0; i < samples; i++) {
+        int32_t left = 0;
+        int32_t right = 0;
+        for (int chip = 0; chip < chipCount; chip++) {
+            const int32_t sample = chips[chip][i];
+            left += sample * channelGain[chip][0];
+            right += sample * channelGain[chip][1];
+        }
+        out[i * 2] = clamp16(left >> 15);
+        out[i * 2 + 1] = clamp16(right >> 15);
+        // The visualization follows the music, not the volume setting.
+        if (i < monoTapSamples) {
+            int32_t mono = 0;
+            for (int chip = 0; chip < chipCount; chip++) {
+                mono += chips[chip][i] * mixGain[chip];
+            }
+            monoTap[i] = clamp16(mono >> 15);
+        }
+    }
+    return samples;
+}
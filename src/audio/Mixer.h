@@ -0,0 +1,49 @@
+#ifndef SIDPOD_MIXER_H
+#define SIDPOD_MIXER_H
+
+#include <cstdint>
+
+#define MIXER_MAX_CHIPS     3
+#define MIXER_UNITY_GAIN    32767
+#define MIXER_PAN_LEFT      (-32767)
+#define MIXER_PAN_CENTER    0
+#define MIXER_PAN_RIGHT     32767
+// The most the chip gains may add up to, which keeps the sums in mix() within
+// 32 bits: 32768 * 65535 < 2^31.
+#define MIXER_MAX_TOTAL_GAIN    (2 * MIXER_UNITY_GAIN + 1)
+
+/*
+ * Mixes the output of up to three SID chips into interleaved stereo frames.
+ * Every chip has a Q15 gain and a Q15 pan position, and the master volume is
+ * folded into the per channel gains, so mixing a sample is a multiply and an
+ * add per chip and channel followed by a saturating shift. Gains that add up
+ * to more than MIXER_MAX_TOTAL_GAIN are scaled down to it.
+ *
+ * The chip layout is set up by the audio core, which mixes. The volume is set
+ * from core0, and only handed over as a single word that the audio core picks
+ * up before it mixes the next buffer.
+ */
+class Mixer {
+public:
+    static void setChipCount(int chips);
+
+    static void setChip(int chip, int16_t gain, int16_t pan);
+
+    static void setVolume(uint8_t volume);
+
+    static int mix(const short *const chips[], const int chipSamples[], short *out, short *monoTap,
+                   int monoTapSamples);
+
+private:
+    static int chipCount;
+    static int16_t chipGain[MIXER_MAX_CHIPS];
+    static int16_t chipPan[MIXER_MAX_CHIPS];
+    static int32_t mixGain[MIXER_MAX_CHIPS];
+    static volatile int32_t requestedVolume;
+    static int32_t masterVolume;
+    static int32_t channelGain[MIXER_MAX_CHIPS][2];
+
+    static void updateChannelGains();
+};
+
+#endif //SIDPOD_MIXER_H
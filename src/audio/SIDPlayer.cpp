@@ -3,6 +3,13 @@
 #include <cstring>
 #include <pico/util/queue.h>
 #include <hardware/gpio.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+#include <hardware/clocks.h>
+#include <hardware/pio.h>
+#include <cctype>
+#include <cstdlib>
 #include "SIDPlayer.h"
 
 #include <algorithm>
@@ -10,34 +17,45 @@
 #include <pico/audio_i2s.h>
 
 #include "../platform_config.h"
+#include "AudioLead.h"
+#include "AudioStats.h"
 #include "C64.h"
+#include "Mixer.h"
 #include "System.h"
+#include "VisualizationCapture.h"
 #include "../Catalog.h"
 
-#if FFT_SAMPLES <= 1024
-short __scratch_x("fft_samples") visualizationBuffer[FFT_SAMPLES];
-#else
-short visualizationBuffer[FFT_SAMPLES];
+#ifndef USE_SDCARD
+#include "diskio.h"
 #endif
+
 repeating_timer reapCommandTimer{};
 queue_t txQueue;
 uint8_t playPauseCommand = PLAY_PAUSE_COMMAND_CODE;
 uint8_t volume = INITIAL_VOLUME;
-float volumeFactor;
 volatile bool playPauseQueued = false;
+static volatile bool recordingQueued = false;
+static volatile uint32_t seekTarget = NO_SEEK;
+static volatile bool snapshotRequested = false;
+static volatile bool audioCoreParked = false;
+static TCHAR loadedPath[MAX_PATH_LENGTH];
 bool rendering = false;
 bool loadingSuccessful = true;
+static bool i2sStarved = true;
+static volatile uint32_t i2sBuffersStarted = 0;
+static uint32_t samplesQueued = 0;
 PlaylistEntry *lastCatalogEntry = {};
 static audio_format_t audio_format = {
     .sample_freq = SAMPLE_RATE,
     .format = AUDIO_BUFFER_FORMAT_PCM_S16,
-    .channel_count = 1,
+    .channel_count = 2,
 };
 static audio_buffer_format producer_format = {
     .format = &audio_format,
-    .sample_stride = 2
+    .sample_stride = 4
 };
-static audio_buffer_pool *audioBufferPool = audio_new_producer_pool(&producer_format, 2, MAX_SAMPLES_PER_BUFFER);
+static audio_buffer_pool *audioBufferPool = audio_new_producer_pool(&producer_format, AUDIO_I2S_BUFFER_COUNT,
+                                                                        MAX_SAMPLES_PER_BUFFER);
 audio_i2s_config config = {
     .data_pin = PICO_AUDIO_I2S_DATA_PIN,
     .clock_pin_base = PICO_AUDIO_I2S_CLOCK_PIN_BASE,
@@ -47,14 +65,54 @@ audio_i2s_config config = {
 
 // core0 functions
 
+/* The I2S connection copies every buffer core1 gives it into a queue of its own
+   buffers, each played once it is full. When the queue runs dry, pico-extras
+   keeps the I2S fed with a silence transfer that reads the same word over and
+   over. This handler runs after the library's own DMA handler has started the
+   next transfer, so one with read increment is a queued buffer leaving the
+   queue, and one without while a tune is playing is an underrun. Only the
+   switch from music to silence is counted, not every silence transfer that
+   follows. */
+void SIDPlayer::watchI2STransfers() {
+    const bool starved = !(dma_channel_hw_addr(config.dma_channel)->al1_ctrl & DMA_CH0_CTRL_TRIG_INCR_READ_BITS);
+    if (!starved) {
+        i2sBuffersStarted = i2sBuffersStarted + 1;
+        __sev();
+    } else if (!i2sStarved && rendering) {
+        AudioStats::underrun();
+    }
+    i2sStarved = starved;
+}
+
+/* The device wide sample rate, if one is set, is a number on the first line of
+   the settings file. */
+void SIDPlayer::loadSampleRateSetting() {
+    FIL fil;
+    if (System::openSettingsFile(&fil, SAMPLE_RATE_FILE)) {
+        char line[16];
+        if (f_gets(line, sizeof(line), &fil) != nullptr) {
+            C64::setSampleRate(strtoul(line, nullptr, 10));
+        }
+        f_close(&fil);
+    }
+}
+
 void SIDPlayer::initAudio() {
-    updateVolumeFactor();
+    loadSampleRateSetting();
+    updateVolume();
+    AudioStats::reset();
     audio_i2s_setup(&audio_format, &config);
-    audio_i2s_connect(audioBufferPool);
+    irq_add_shared_handler(DMA_IRQ_0 + PICO_AUDIO_I2S_DMA_IRQ, watchI2STransfers,
+                           PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY);
+    audio_i2s_connect_extra(audioBufferPool, false, AUDIO_I2S_BUFFER_COUNT, AUDIO_I2S_BUFFER_SAMPLES, nullptr);
     audio_i2s_set_enabled(true);
-    C64::begin();
     multicore_launch_core1(core1Main);
+    // Core1 removes the snapshot it resumes from through core0.
+    while (!multicore_fifo_rvalid()) {
+        System::serviceCore1Jobs();
+    }
     multicore_fifo_pop_blocking();
+    C64::enableParallelRendering();
 }
 
 void SIDPlayer::resetState() {
@@ -62,11 +120,61 @@ void SIDPlayer::resetState() {
     rendering = false;
     loadingSuccessful = true;
     lastCatalogEntry = {};
-    memset(visualizationBuffer, 0, FFT_SAMPLES);
+    VisualizationCapture::clear();
+    AudioStats::reset();
     C64::c64Init();
     busy_wait_ms(200);
 }
 
+void SIDPlayer::recordSelectedTune() {
+    recordingQueued = true;
+}
+
+void SIDPlayer::seek(uint32_t millis) {
+    seekTarget = millis;
+}
+
+void SIDPlayer::fastForward(uint32_t millis) {
+    seek(millisSinceSongStart() + millis);
+}
+
+/* Core1 may be halfway through a buffer and waiting for its extra chips, so
+   they are rendered here until it has parked. */
+void SIDPlayer::saveSnapshot() {
+    snapshotRequested = true;
+    const uint32_t start = System::millis_now();
+    while (!audioCoreParked) {
+        if (System::millis_now() - start > SNAPSHOT_PARK_TIMEOUT_MS) {
+            snapshotRequested = false;
+            printf("Audio core did not stop for the snapshot\n");
+            return;
+        }
+        C64::serviceParallelRendering();
+        System::serviceCore1Jobs();
+    }
+    __dmb();
+    writeSnapshot();
+    __dmb();
+    snapshotRequested = false;
+}
+
+/* Only a song that is playing is saved, so that a device put to sleep with
+   nothing playing, or paused, wakes up the way it always has. Any older
+   snapshot is removed in that case. */
+void SIDPlayer::writeSnapshot() {
+    if (rendering && C64::songIsLoaded()) {
+        const uint32_t start = time_us_32();
+        if (C64::saveSnapshot(SETTINGS_DIRECTORY "/" SNAPSHOT_FILE, loadedPath)) {
+            printf("Saved snapshot of %s in %lu ms\n", loadedPath,
+                   static_cast<unsigned long>((time_us_32() - start) / 1000));
+        } else {
+            printf("Could not save snapshot of %s\n", loadedPath);
+        }
+    } else {
+        System::deleteSettingsFile(SNAPSHOT_FILE);
+    }
+}
+
 void SIDPlayer::playIfPaused() {
     if (!rendering) {
         togglePlayPause();
@@ -91,8 +199,8 @@ void SIDPlayer::ampOff() {
     gpio_pull_down(AMP_CONTROL_PIN);
 }
 
-void SIDPlayer::updateVolumeFactor() {
-    volumeFactor = static_cast<float>(volume) / VOLUME_STEPS;
+void SIDPlayer::updateVolume() {
+    Mixer::setVolume(volume);
 }
 
 void SIDPlayer::volumeUp() {
@@ -102,7 +210,7 @@ void SIDPlayer::volumeUp() {
         }
         volume++;
     }
-    updateVolumeFactor();
+    updateVolume();
 }
 
 void SIDPlayer::volumeDown() {
@@ -112,7 +220,7 @@ void SIDPlayer::volumeDown() {
         }
         volume--;
     }
-    updateVolumeFactor();
+    updateVolume();
 }
 
 uint8_t SIDPlayer::getVolume() {
@@ -183,14 +291,182 @@ volatile bool SIDPlayer::reapCommand(repeating_timer *t) {
     return true;
 }
 
+/* Runs between tunes, once the I2S queue has played out. pico-extras only
+   works out the PIO clock divider in audio_i2s_setup, so it is set here the
+   same way: two PIO cycles per bit and 32 bits per stereo frame, with the
+   divider in 24.8 fixed point. The lead is measured in samples, so it starts over too. */
+void SIDPlayer::setOutputSampleRate(uint32_t sampleRate) {
+    if (sampleRate != audio_format.sample_freq) {
+        audio_format.sample_freq = sampleRate;
+        const uint32_t divider = clock_get_hz(clk_sys) * 4 / sampleRate;
+        pio_sm_set_clkdiv_int_frac(__CONCAT(pio, PICO_AUDIO_I2S_PIO), config.pio_sm, divider >> 8u, divider & 0xffu);
+    }
+    AudioLead::reset(AUDIO_I2S_BUFFER_COUNT * AUDIO_I2S_BUFFER_SAMPLES, sampleRate);
+}
+
+// Audio given to the I2S output that hasn't started playing yet.
+uint32_t SIDPlayer::leadSamples() {
+    return samplesQueued - i2sBuffersStarted * AUDIO_I2S_BUFFER_SAMPLES;
+}
+
+/* Holds the next buffer back while the queue is ahead of the lead the tune
+   needs, waking up every time the I2S output starts on a queued buffer. Until
+   the target is reached, after a tune is loaded or resumed, buffers are
+   rendered back to back. */
+void SIDPlayer::waitForLead() {
+    uint32_t target = AudioLead::targetSamples();
+    while (static_cast<int32_t>(leadSamples()) > static_cast<int32_t>(target)) {
+        __wfe();
+        target = AudioLead::targetSamples();
+    }
+    AudioStats::leadSampled(leadSamples(), target);
+}
+
 volatile bool SIDPlayer::loadPSID(TCHAR *fullPath) {
+    loadSamplingSetting(fullPath);
     return C64::sid_load_from_file(fullPath);
 }
 
+// Streams and other settings of a tune are kept with the settings, named after the tune.
+void SIDPlayer::getTuneSettingPath(const TCHAR *fullPath, const char *extension, TCHAR *path, size_t length) {
+    const TCHAR *fileName = strrchr(fullPath, '/');
+    snprintf(path, length, "%s/%s%s", SETTINGS_DIRECTORY, fileName ? fileName + 1 : fullPath, extension);
+}
+
+static bool parseSamplingMethod(const char *name, sampling_method &method) {
+    if (strcmp(name, "fast") == 0) {
+        method = SAMPLE_FAST;
+    } else if (strcmp(name, "interpolate") == 0) {
+        method = SAMPLE_INTERPOLATE;
+    } else if (strcmp(name, "resample") == 0) {
+        method = SAMPLE_RESAMPLE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* The sampling method file of a tune has a line for each song with a method
+   of its own, the song number and then fast, interpolate or resample. A line
+   with just the method sets it for the songs that have no line. */
+void SIDPlayer::loadSamplingSetting(const TCHAR *fullPath) {
+    C64::clearSongSamplingMethods();
+    TCHAR path[MAX_PATH_LENGTH];
+    getTuneSettingPath(fullPath, SAMPLING_FILE_EXTENSION, path, MAX_PATH_LENGTH);
+    FIL fil;
+    if (f_open(&fil, path, FA_READ) != FR_OK) return;
+    char line[32];
+    while (f_gets(line, sizeof(line), &fil) != nullptr) {
+        char *name = line;
+        int song = -1;
+        if (isdigit(static_cast<unsigned char>(line[0]))) {
+            song = static_cast<int>(strtol(line, &name, 10)) - 1;
+        }
+        name += strspn(name, " \t");
+        name[strcspn(name, " \t\r\n")] = '\0';
+        if (!*name) continue;
+        sampling_method method;
+        if (parseSamplingMethod(name, method)) {
+            C64::setSongSamplingMethod(song, method);
+        } else {
+            printf("Unknown sampling method %s in %s\n", name, path);
+        }
+    }
+    f_close(&fil);
+}
+
+// Kept out of core1Main, to keep the path off its stack.
+void SIDPlayer::playRecordedStream(const TCHAR *fullPath) {
+    TCHAR streamPath[MAX_PATH_LENGTH];
+    getTuneSettingPath(fullPath, SID_STREAM_FILE_EXTENSION, streamPath, MAX_PATH_LENGTH);
+    C64::playStream(streamPath);
+}
+
+/* Runs the selected tune through the 6502 for SID_STREAM_RECORD_SECONDS, as
+   fast as it goes, and records its start song. The chips are clocked as when
+   seeking, as tunes read back the oscillator and envelope of voice 3, but
+   nothing is rendered or counted in the audio stats. The player is left reset, so the next press of play loads the tune afresh
+   and picks up the stream. */
+void SIDPlayer::recordStream() {
+    recordingQueued = false;
+    if (!catalog->hasOpenPlaylist()) return;
+    TCHAR fullPath[MAX_PATH_LENGTH];
+    TCHAR streamPath[MAX_PATH_LENGTH];
+    catalog->getCurrentPlaylist()->getFullPathForSelectedEntry(fullPath, MAX_PATH_LENGTH);
+    getTuneSettingPath(fullPath, SID_STREAM_FILE_EXTENSION, streamPath, MAX_PATH_LENGTH);
+    resetState();
+    if (!C64::startRecording(streamPath)) {
+        printf("Could not create %s\n", streamPath);
+        return;
+    }
+    if (loadPSID(fullPath)) {
+        const uint32_t start = time_us_32();
+        for (int i = 0; i < SID_STREAM_RECORD_SECONDS * BUFFERS_PER_SECOND; i++) {
+            C64::skipFrame();
+        }
+        printf("Ran %d s of the tune in %lu ms\n", SID_STREAM_RECORD_SECONDS,
+               static_cast<unsigned long>((time_us_32() - start) / 1000));
+    }
+    printf(C64::stopRecording() ? "Recorded %s\n" : "Could not write %s\n", streamPath);
+    resetState();
+}
+
+/* Makes a seek asked for by core0. The audio already queued for the I2S
+   output keeps playing while the song is run forward, and rendering picks up
+   from the new position as soon as it is reached. */
+void SIDPlayer::seekQueued() {
+    const uint32_t target = seekTarget;
+    seekTarget = NO_SEEK;
+    const uint32_t from = millisSinceSongStart();
+    const uint32_t start = time_us_32();
+    C64::seek(target);
+    const uint32_t tookUs = std::max(time_us_32() - start, 1u);
+    const uint32_t seekedMillis = target > from ? target - from : target;
+    printf("Seeked to %lu ms, %lu ms of music in %lu ms (%lux realtime)\n", static_cast<unsigned long>(target),
+           static_cast<unsigned long>(seekedMillis), static_cast<unsigned long>(tookUs / 1000),
+           static_cast<unsigned long>(static_cast<uint64_t>(seekedMillis) * 1000 / tookUs));
+}
+
+/* Holds core1 between two buffers while core0 saves the emulation. */
+void SIDPlayer::parkForSnapshot() {
+    audioCoreParked = true;
+    while (snapshotRequested) {
+        tight_loop_contents();
+    }
+    audioCoreParked = false;
+}
+
+static bool deleteSnapshot(void *) {
+    System::deleteSettingsFile(SNAPSHOT_FILE);
+    return true;
+}
+
+/* Runs before core0 is let go, so only the removal has to go through it. The
+   snapshot is removed once read, so a song that brings the emulation down
+   can't do it again on every power up. */
+void SIDPlayer::resumeFromSnapshot() {
+    const uint32_t start = time_us_32();
+    if (C64::loadSnapshot(SETTINGS_DIRECTORY "/" SNAPSHOT_FILE, loadedPath)) {
+        System::runOnCore0(deleteSnapshot, nullptr);
+        printf("Resumed %s in %lu ms\n", loadedPath, static_cast<unsigned long>((time_us_32() - start) / 1000));
+        // For the songs played after this one.
+        loadSamplingSetting(loadedPath);
+        playRecordedStream(loadedPath);
+        setOutputSampleRate(C64::getSampleRate());
+        rendering = true;
+        ampOn();
+    }
+}
+
 [[noreturn]] void SIDPlayer::core1Main() {
+#ifndef USE_SDCARD
+    multicore_lockout_victim_init();
+    disk_enable_core1_lockout(true);
+#endif
     ampOff();
     queue_init(&txQueue, 1, 1);
     add_repeating_timer_ms(50, reinterpret_cast<repeating_timer_callback_t>(reapCommand), nullptr, &reapCommandTimer);
+    resumeFromSnapshot();
     multicore_fifo_push_blocking(AUDIO_RENDERING_STARTED_FIFO_FLAG);
     while (true) {
         if (playPauseQueued) {
@@ -201,7 +477,13 @@ volatile bool SIDPlayer::loadPSID(TCHAR *fullPath) {
                     resetState();
                     TCHAR fullPath[MAX_PATH_LENGTH];
                     playlist->getFullPathForSelectedEntry(fullPath, MAX_PATH_LENGTH);
+                    const uint32_t loadStart = time_us_32();
                     if (loadPSID(fullPath)) {
+                        printf("Loaded %s in %lu us\n", fullPath,
+                               static_cast<unsigned long>(time_us_32() - loadStart));
+                        strcpy(loadedPath, fullPath);
+                        playRecordedStream(fullPath);
+                        setOutputSampleRate(C64::getSampleRate());
                         catalog->setSelectedPlaying();
                         loadingSuccessful = true;
                         rendering = true;
@@ -211,7 +493,7 @@ volatile bool SIDPlayer::loadPSID(TCHAR *fullPath) {
                     }
                     lastCatalogEntry = currentCatalogEntry;
                 } else if (rendering) {
-                    memset(visualizationBuffer, 0, sizeof(visualizationBuffer));
+                    VisualizationCapture::clear();
                     rendering = false;
                     ampOff();
                 } else {
@@ -220,12 +502,23 @@ volatile bool SIDPlayer::loadPSID(TCHAR *fullPath) {
                 }
                 playPauseQueued = false;
             }
+        } else if (recordingQueued && !rendering) {
+            recordStream();
+        } else if (seekTarget != NO_SEEK && C64::songIsLoaded()) {
+            seekQueued();
+        } else if (snapshotRequested) {
+            parkForSnapshot();
         }
 
         if (rendering) {
+            waitForLead();
             audio_buffer *buffer = take_audio_buffer(audioBufferPool, true);
-            C64::clock(buffer, volumeFactor);
+            const uint32_t renderStart = time_us_32();
+            C64::clock(buffer);
+            const uint32_t samples = buffer->sample_count;
+            AudioLead::bufferRendered(samples, time_us_32() - renderStart);
             give_audio_buffer(audioBufferPool, buffer);
+            samplesQueued += samples;
         }
     }
 }
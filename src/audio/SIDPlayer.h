@@ -7,8 +7,7 @@
 #include "../Playlist.h"
 
 #define PLAY_PAUSE_COMMAND_CODE     123
-
-extern short visualizationBuffer[];
+#define NO_SEEK                     UINT32_MAX
 
 class SIDPlayer {
 public:
@@ -48,6 +47,20 @@ public:
 
     static void resetState();
 
+    // Moves the current song to the given time from its start, or the given
+    // time ahead, once the audio core is between buffers.
+    static void seek(uint32_t millis);
+
+    static void fastForward(uint32_t millis);
+
+    // Records a SID register stream for the selected tune, once the player is idle.
+    static void recordSelectedTune();
+
+    // Saves the song that is playing, if any, for the next power up to carry
+    // on with. Runs on core0, outside of interrupts, and parks the audio core
+    // for the duration. Gives up after SNAPSHOT_PARK_TIMEOUT_MS if it won't.
+    static void saveSnapshot();
+
     static void playIfPaused();
 
     static void pauseIfPlaying();
@@ -55,7 +68,33 @@ public:
 private:
     static volatile void tryJSRToPlayAddr();
 
-    static void updateVolumeFactor();
+    static void loadSampleRateSetting();
+
+    static void setOutputSampleRate(uint32_t sampleRate);
+
+    static void getTuneSettingPath(const TCHAR *fullPath, const char *extension, TCHAR *path, size_t length);
+
+    static void loadSamplingSetting(const TCHAR *fullPath);
+
+    static void playRecordedStream(const TCHAR *fullPath);
+
+    static void recordStream();
+
+    static void seekQueued();
+
+    static void writeSnapshot();
+
+    static void parkForSnapshot();
+
+    static void resumeFromSnapshot();
+
+    static void watchI2STransfers();
+
+    static uint32_t leadSamples();
+
+    static void waitForLead();
+
+    static void updateVolume();
 
     static volatile void generateSamples(audio_buffer *buffer);
 
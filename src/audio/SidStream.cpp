@@ -0,0 +1,254 @@
+#include "SidStream.h"
+
+#include <cstring>
+
+#include "../platform_config.h"
+#include "../System.h"
+
+// "SIDS", a version byte, the song, flags and a spare byte, the PSID load,
+// init and play addresses, the song count, then the length in cycles and the
+// number of bytes of writes that follow, all little endian.
+#define SID_STREAM_HEADER_SIZE  24
+#define SID_STREAM_VERSION      1
+#define SID_STREAM_FLAG_PAL     0x01
+
+static FIL file;
+static bool fileOpen = false;
+static bool failed = false;
+static BYTE buffer[SID_STREAM_BUFFER_SIZE];
+static UINT bufferUsed = 0;
+static UINT bufferRead = 0;
+static BYTE aheadBuffer[SID_STREAM_BUFFER_SIZE];
+static UINT readWanted = 0;
+static UINT readGot = 0;
+static bool readPending = false;
+static uint32_t bodyBytes = 0;
+static uint32_t bodyLeft = 0;
+static uint32_t lastCycle = 0;
+
+static void putLE(BYTE *out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out[i] = value >> (8 * i) & 0xff;
+    }
+}
+
+static uint32_t getLE(const BYTE *in, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/* Streams are recorded and played on core1, but the file is only ever touched
+   by core0, see System::runOnCore0. */
+static bool createFile(void *path) {
+    return f_open(&file, static_cast<const TCHAR *>(path), FA_CREATE_ALWAYS | FA_WRITE) == FR_OK;
+}
+
+static bool seekToStart(void *) {
+    return f_lseek(&file, 0) == FR_OK;
+}
+
+static bool writeBuffer(void *out) {
+    UINT written;
+    return f_write(&file, out, bufferUsed, &written) == FR_OK && written == bufferUsed;
+}
+
+static bool openFile(void *path) {
+    return f_open(&file, static_cast<const TCHAR *>(path), FA_READ) == FR_OK;
+}
+
+static bool readFile(void *in) {
+    if (f_read(&file, in, readWanted, &readGot) != FR_OK) {
+        readGot = 0;
+    }
+    return readGot != 0;
+}
+
+static bool seekToBody(void *) {
+    return f_lseek(&file, SID_STREAM_HEADER_SIZE) == FR_OK;
+}
+
+static bool closeFile(void *) {
+    return f_close(&file) == FR_OK;
+}
+
+bool SidStream::create(const TCHAR *path) {
+    close();
+    if (!System::runOnCore0(createFile, const_cast<TCHAR *>(path))) {
+        return false;
+    }
+    fileOpen = true;
+    restart();
+    return !failed;
+}
+
+void SidStream::restart() {
+    failed = !System::runOnCore0(seekToStart, nullptr);
+    memset(buffer, 0, SID_STREAM_HEADER_SIZE);
+    bufferUsed = SID_STREAM_HEADER_SIZE;
+    bodyBytes = 0;
+    lastCycle = 0;
+}
+
+bool SidStream::flush() {
+    if (!failed && !System::runOnCore0(writeBuffer, buffer)) {
+        failed = true;
+    }
+    bufferUsed = 0;
+    return !failed;
+}
+
+void SidStream::write(uint32_t cycle, uint8_t chip, uint8_t reg, uint8_t value) {
+    // The longest entry is a five byte delta and two more.
+    if (bufferUsed > SID_STREAM_BUFFER_SIZE - 7) {
+        flush();
+    }
+    const UINT start = bufferUsed;
+    uint32_t delta = cycle - lastCycle;
+    while (delta >= 0x80) {
+        buffer[bufferUsed++] = (delta & 0x7f) | 0x80;
+        delta >>= 7;
+    }
+    buffer[bufferUsed++] = delta;
+    buffer[bufferUsed++] = chip << 5 | (reg & 0x1f);
+    buffer[bufferUsed++] = value;
+    bodyBytes += bufferUsed - start;
+    lastCycle = cycle;
+}
+
+bool SidStream::finish(const SidStreamHeader &header) {
+    flush();
+    BYTE out[SID_STREAM_HEADER_SIZE] = {'S', 'I', 'D', 'S', SID_STREAM_VERSION, header.song,
+                                        static_cast<BYTE>(header.isPAL ? SID_STREAM_FLAG_PAL : 0)};
+    putLE(out + 8, header.load, 2);
+    putLE(out + 10, header.init, 2);
+    putLE(out + 12, header.play, 2);
+    putLE(out + 14, header.songs, 2);
+    putLE(out + 16, header.lengthCycles, 4);
+    putLE(out + 20, bodyBytes, 4);
+    bufferUsed = SID_STREAM_HEADER_SIZE;
+    if (!System::runOnCore0(seekToStart, nullptr) || !System::runOnCore0(writeBuffer, out)) {
+        failed = true;
+    }
+    bufferUsed = 0;
+    const bool ok = !failed;
+    close();
+    return ok;
+}
+
+bool SidStream::open(const TCHAR *path, SidStreamHeader &header) {
+    close();
+    if (!System::runOnCore0(openFile, const_cast<TCHAR *>(path))) {
+        return false;
+    }
+    fileOpen = true;
+    BYTE in[SID_STREAM_HEADER_SIZE];
+    readWanted = SID_STREAM_HEADER_SIZE;
+    if (!System::runOnCore0(readFile, in) || readGot != SID_STREAM_HEADER_SIZE
+        || memcmp(in, "SIDS", 4) != 0 || in[4] != SID_STREAM_VERSION) {
+        close();
+        return false;
+    }
+    header.song = in[5];
+    header.isPAL = in[6] & SID_STREAM_FLAG_PAL;
+    header.load = getLE(in + 8, 2);
+    header.init = getLE(in + 10, 2);
+    header.play = getLE(in + 12, 2);
+    header.songs = getLE(in + 14, 2);
+    header.lengthCycles = getLE(in + 16, 4);
+    bodyBytes = getLE(in + 20, 4);
+    bodyLeft = bodyBytes;
+    bufferUsed = bufferRead = 0;
+    lastCycle = 0;
+    failed = false;
+    readAhead();
+    return true;
+}
+
+// Has core0 read the next buffer, without waiting for it.
+void SidStream::readAhead() {
+    readWanted = bodyLeft < SID_STREAM_BUFFER_SIZE ? bodyLeft : SID_STREAM_BUFFER_SIZE;
+    readPending = !failed && readWanted;
+    if (readPending) {
+        System::startOnCore0(readFile, aheadBuffer);
+    }
+}
+
+/* Takes the buffer read ahead, which core0 has normally long finished, and
+   asks for the one after it. */
+bool SidStream::fill() {
+    bufferUsed = bufferRead = 0;
+    if (!readPending) {
+        return false;
+    }
+    readPending = false;
+    System::waitForCore0();
+    if (!readGot) {
+        failed = true;
+        return false;
+    }
+    memcpy(buffer, aheadBuffer, readGot);
+    bufferUsed = readGot;
+    bodyLeft -= readGot;
+    readAhead();
+    return true;
+}
+
+bool SidStream::nextByte(BYTE &byte) {
+    if (bufferRead == bufferUsed && !fill()) {
+        return false;
+    }
+    byte = buffer[bufferRead++];
+    return true;
+}
+
+bool SidStream::read(SidStreamWrite &write) {
+    uint32_t delta = 0;
+    BYTE byte;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (!nextByte(byte)) {
+            return false;
+        }
+        delta |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    BYTE address, value;
+    if (!nextByte(address) || !nextByte(value)) {
+        return false;
+    }
+    lastCycle += delta;
+    write = {lastCycle, static_cast<uint8_t>(address >> 5), static_cast<uint8_t>(address & 0x1f), value};
+    return true;
+}
+
+bool SidStream::rewind() {
+    if (readPending) {
+        System::waitForCore0();
+        readPending = false;
+    }
+    bodyLeft = bodyBytes;
+    bufferUsed = bufferRead = 0;
+    lastCycle = 0;
+    failed = !System::runOnCore0(seekToBody, nullptr);
+    readAhead();
+    return !failed;
+}
+
+void SidStream::close() {
+    if (readPending) {
+        System::waitForCore0();
+        readPending = false;
+    }
+    if (fileOpen) {
+        System::runOnCore0(closeFile, nullptr);
+        fileOpen = false;
+    }
+}
+
+bool SidStream::isOpen() {
+    return fileOpen;
+}
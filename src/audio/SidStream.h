@@ -0,0 +1,74 @@
+#ifndef SIDPOD_SIDSTREAM_H
+#define SIDPOD_SIDSTREAM_H
+
+#include <cstdint>
+
+#include "ff.h"
+
+// What a stream was recorded from, so that it is only ever played back in
+// place of the song it was recorded for.
+struct SidStreamHeader {
+    uint8_t song;
+    bool isPAL;
+    uint16_t load;
+    uint16_t init;
+    uint16_t play;
+    uint16_t songs;
+    // The length of the recording, after which playback starts over.
+    uint32_t lengthCycles;
+};
+
+struct SidStreamWrite {
+    uint32_t cycle;
+    uint8_t chip;
+    uint8_t reg;
+    uint8_t value;
+};
+
+/*
+ * A recording of every register write a song makes to its SID chips, in the
+ * order and on the cycle the CPU made them. The header is followed by one
+ * entry per write: the cycles since the previous write as a little endian
+ * base 128 number, seven bits per byte with the top bit set on all but the
+ * last, then the chip in the top three bits and the register in the low five
+ * of one byte, and the value. A write within a few thousand cycles of the
+ * last, which is nearly all of them, takes three or four bytes.
+ *
+ * There is only ever one stream open, either being recorded or played back,
+ * and it is read and written through a buffer of SID_STREAM_BUFFER_SIZE.
+ * When playing back, core0 reads the next buffer while this one is used.
+ */
+class SidStream {
+public:
+    static bool create(const TCHAR *path);
+
+    // Drops everything recorded so far, when the song is started over.
+    static void restart();
+
+    static void write(uint32_t cycle, uint8_t chip, uint8_t reg, uint8_t value);
+
+    // Writes the header and closes the file.
+    static bool finish(const SidStreamHeader &header);
+
+    static bool open(const TCHAR *path, SidStreamHeader &header);
+
+    // False at the end of the stream.
+    static bool read(SidStreamWrite &write);
+
+    static bool rewind();
+
+    static void close();
+
+    static bool isOpen();
+
+private:
+    static bool flush();
+
+    static void readAhead();
+
+    static bool fill();
+
+    static bool nextByte(BYTE &byte);
+};
+
+#endif //SIDPOD_SIDSTREAM_H
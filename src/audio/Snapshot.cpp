@@ -0,0 +1,157 @@
+#include "Snapshot.h"
+
+#include <cstring>
+
+#include "../platform_config.h"
+
+// "SNAP", a version byte and three spare bytes, then the size of the state.
+#define SNAPSHOT_HEADER_SIZE    12
+#define SNAPSHOT_VERSION        2
+
+static FIL file;
+static bool fileOpen = false;
+static bool failed = false;
+static BYTE buffer[SNAPSHOT_BUFFER_SIZE];
+static UINT bufferUsed = 0;
+static UINT bufferRead = 0;
+
+static void flush() {
+    UINT written;
+    if (!failed && bufferUsed && (f_write(&file, buffer, bufferUsed, &written) != FR_OK || written != bufferUsed)) {
+        failed = true;
+    }
+    bufferUsed = 0;
+}
+
+bool Snapshot::create(const TCHAR *path, uint32_t stateSize) {
+    close();
+    if (f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+        return false;
+    }
+    fileOpen = true;
+    failed = false;
+    bufferUsed = 0;
+    const BYTE header[SNAPSHOT_HEADER_SIZE] = {
+        'S', 'N', 'A', 'P', SNAPSHOT_VERSION, 0, 0, 0,
+        static_cast<BYTE>(stateSize), static_cast<BYTE>(stateSize >> 8),
+        static_cast<BYTE>(stateSize >> 16), static_cast<BYTE>(stateSize >> 24)
+    };
+    write(header, SNAPSHOT_HEADER_SIZE);
+    return true;
+}
+
+void Snapshot::putByte(uint8_t byte) {
+    if (bufferUsed == SNAPSHOT_BUFFER_SIZE) {
+        flush();
+    }
+    buffer[bufferUsed++] = byte;
+}
+
+void Snapshot::write(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        putByte(bytes[i]);
+    }
+}
+
+void Snapshot::writeMemory(const uint8_t *memory, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < 130 && memory[i + run] == memory[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            putByte(0x80 + run - 3);
+            putByte(memory[i]);
+            i += run;
+            continue;
+        }
+        // Copy up to the next run of three.
+        size_t literal = 0;
+        while (i + literal < size && literal < 128
+               && !(i + literal + 2 < size && memory[i + literal] == memory[i + literal + 1]
+                    && memory[i + literal] == memory[i + literal + 2])) {
+            literal++;
+        }
+        putByte(literal - 1);
+        write(memory + i, literal);
+        i += literal;
+    }
+}
+
+bool Snapshot::finish() {
+    flush();
+    const bool ok = !failed;
+    close();
+    return ok;
+}
+
+bool Snapshot::open(const TCHAR *path, uint32_t stateSize) {
+    close();
+    if (f_open(&file, path, FA_READ) != FR_OK) {
+        return false;
+    }
+    fileOpen = true;
+    failed = false;
+    bufferUsed = bufferRead = 0;
+    BYTE header[SNAPSHOT_HEADER_SIZE];
+    if (!read(header, SNAPSHOT_HEADER_SIZE) || memcmp(header, "SNAP", 4) != 0 || header[4] != SNAPSHOT_VERSION
+        || (header[8] | header[9] << 8 | header[10] << 16 | static_cast<uint32_t>(header[11]) << 24) != stateSize) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::getByte(uint8_t &byte) {
+    if (bufferRead == bufferUsed) {
+        if (failed || f_read(&file, buffer, SNAPSHOT_BUFFER_SIZE, &bufferUsed) != FR_OK || bufferUsed == 0) {
+            failed = true;
+            return false;
+        }
+        bufferRead = 0;
+    }
+    byte = buffer[bufferRead++];
+    return true;
+}
+
+bool Snapshot::read(void *data, size_t size) {
+    auto *bytes = static_cast<uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        if (!getByte(bytes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Snapshot::readMemory(uint8_t *memory, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        uint8_t code, value;
+        if (!getByte(code)) {
+            return false;
+        }
+        if (code < 0x80) {
+            if (i + code + 1 > size || !read(memory + i, code + 1)) {
+                return false;
+            }
+            i += code + 1;
+        } else {
+            if (i + code - 0x80 + 3 > size || !getByte(value)) {
+                return false;
+            }
+            memset(memory + i, value, code - 0x80 + 3);
+            i += code - 0x80 + 3;
+        }
+    }
+    return true;
+}
+
+void Snapshot::close() {
+    if (fileOpen) {
+        f_close(&file);
+        fileOpen = false;
+    }
+}
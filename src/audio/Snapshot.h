@@ -0,0 +1,46 @@
+#ifndef SIDPOD_SNAPSHOT_H
+#define SIDPOD_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ff.h"
+
+/*
+ * A file holding the state of the emulation, so that a song can carry on from
+ * where it was after a power down. The state is written as it is laid out in
+ * memory, so a snapshot only makes sense to the firmware that wrote it: the
+ * header holds the total size of the state, and a snapshot of any other size
+ * is turned down. The C64 memory is run length encoded, as most of it is
+ * zeros or long runs of the same byte, with the PackBits scheme: a byte n
+ * below 0x80 followed by n + 1 bytes to copy, or a byte n from 0x80 up
+ * followed by one byte to repeat n - 0x80 + 3 times.
+ *
+ * There is only ever one snapshot open, which is read and written through a
+ * buffer of SNAPSHOT_BUFFER_SIZE.
+ */
+class Snapshot {
+public:
+    static bool create(const TCHAR *path, uint32_t stateSize);
+
+    static void write(const void *data, size_t size);
+
+    static void writeMemory(const uint8_t *memory, size_t size);
+
+    static bool finish();
+
+    static bool open(const TCHAR *path, uint32_t stateSize);
+
+    static bool read(void *data, size_t size);
+
+    static bool readMemory(uint8_t *memory, size_t size);
+
+    static void close();
+
+private:
+    static void putByte(uint8_t byte);
+
+    static bool getByte(uint8_t &byte);
+};
+
+#endif //SIDPOD_SNAPSHOT_H
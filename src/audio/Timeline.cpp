@@ -0,0 +1,341 @@
+#include "Timeline.h"
+
+#include <cstring>
+
+#include "../platform_config.h"
+
+#define PAL_CIA1_TIMER_A_LATCH      0x4025
+#define NTSC_CIA1_TIMER_A_LATCH     0x4295
+
+#define CIA_CONTROL_START           0x01
+#define CIA_CONTROL_ONE_SHOT        0x08
+#define CIA_CONTROL_FORCE_LOAD      0x10
+#define CIA_ICR_SET                 0x80
+
+Timeline::Event Timeline::events[TIMELINE_EVENT_COUNT];
+int Timeline::eventCount = 0;
+Timeline::Cia Timeline::cias[2];
+Timeline::Vic Timeline::vic;
+bool Timeline::irqLine = false;
+bool Timeline::nmiPending = false;
+
+void Timeline::readState(State &state) {
+    memcpy(state.events, events, sizeof(events));
+    state.eventCount = eventCount;
+    memcpy(state.cias, cias, sizeof(cias));
+    state.vic = vic;
+    state.irqLine = irqLine;
+    state.nmiPending = nmiPending;
+}
+
+void Timeline::writeState(const State &state) {
+    memcpy(events, state.events, sizeof(events));
+    eventCount = state.eventCount;
+    memcpy(cias, state.cias, sizeof(cias));
+    vic = state.vic;
+    irqLine = state.irqLine;
+    nmiPending = state.nmiPending;
+}
+
+void Timeline::reset(uint32_t now, bool isPAL) {
+    eventCount = 0;
+    irqLine = false;
+    nmiPending = false;
+    memset(cias, 0, sizeof(cias));
+    memset(&vic, 0, sizeof(vic));
+
+    for (auto &cia: cias) {
+        for (auto &timer: cia.timer) {
+            timer.latch = 0xffff;
+            timer.counter = 0xffff;
+            timer.updated = now;
+        }
+    }
+
+    // The state the KERNAL leaves CIA 1 in: timer A running at 60 Hz with
+    // its interrupt enabled.
+    CiaTimer &timer = cias[0].timer[0];
+    timer.latch = isPAL ? PAL_CIA1_TIMER_A_LATCH : NTSC_CIA1_TIMER_A_LATCH;
+    timer.counter = timer.latch;
+    timer.control = CIA_CONTROL_START;
+    cias[0].regs[0x0e] = timer.control;
+    cias[0].icrMask = 0x01;
+    scheduleTimer(0, 0);
+
+    vic.cyclesPerLine = isPAL ? 63 : 65;
+    vic.linesPerFrame = isPAL ? 312 : 263;
+    vic.frameStart = now;
+    scheduleRaster(now);
+}
+
+// ----------------------------------------------------------------------------
+// Event list
+// ----------------------------------------------------------------------------
+
+void HOT_FUNC(Timeline::schedule)(EventId id, uint32_t time) {
+    cancel(id);
+    int i = eventCount++;
+    while (i > 0 && isBefore(time, events[i - 1].time)) {
+        events[i] = events[i - 1];
+        i--;
+    }
+    events[i] = {time, id};
+}
+
+void HOT_FUNC(Timeline::cancel)(EventId id) {
+    for (int i = 0; i < eventCount; i++) {
+        if (events[i].id == id) {
+            eventCount--;
+            memmove(&events[i], &events[i + 1], (eventCount - i) * sizeof(Event));
+            return;
+        }
+    }
+}
+
+void HOT_FUNC(Timeline::runEvents)(uint32_t now) {
+    while (eventCount && !isBefore(now, events[0].time)) {
+        const Event event = events[0];
+        eventCount--;
+        memmove(&events[0], &events[1], eventCount * sizeof(Event));
+        switch (event.id) {
+            case CIA1_TIMER_A:
+            case CIA1_TIMER_B:
+            case CIA2_TIMER_A:
+            case CIA2_TIMER_B:
+                timerUnderflow(event.id >> 1, event.id & 1, event.time);
+                break;
+            case VIC_RASTER:
+                vic.irqFlags |= 0x01;
+                if (vic.irqMask & 0x01) {
+                    vic.irqFlags |= 0x80;
+                }
+                irqLine = cias[0].icrData & CIA_ICR_SET || vic.irqFlags & 0x80;
+                schedule(VIC_RASTER, event.time + frameCycles());
+                break;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// CIA
+// ----------------------------------------------------------------------------
+
+bool HOT_FUNC(Timeline::countsCycles)(uint8_t cia, uint8_t timer) {
+    const uint8_t control = cias[cia].timer[timer].control;
+    if (!(control & CIA_CONTROL_START)) {
+        return false;
+    }
+    // Timer A counting CNT pulses, or timer B counting anything but clock
+    // cycles, only moves on events we don't emulate or on timer A underflows.
+    return timer == 0 ? !(control & 0x20) : !(control & 0x60);
+}
+
+uint16_t HOT_FUNC(Timeline::timerValue)(uint8_t cia, uint8_t timer, uint32_t now) {
+    const CiaTimer &t = cias[cia].timer[timer];
+    if (!countsCycles(cia, timer)) {
+        return t.counter;
+    }
+    const uint32_t elapsed = now - t.updated;
+    return elapsed >= t.counter ? 0 : t.counter - elapsed;
+}
+
+void Timeline::syncTimer(uint8_t cia, uint8_t timer, uint32_t now) {
+    CiaTimer &t = cias[cia].timer[timer];
+    t.counter = timerValue(cia, timer, now);
+    t.updated = now;
+}
+
+void HOT_FUNC(Timeline::scheduleTimer)(uint8_t cia, uint8_t timer) {
+    const auto id = static_cast<EventId>(cia << 1 | timer);
+    if (countsCycles(cia, timer)) {
+        const CiaTimer &t = cias[cia].timer[timer];
+        schedule(id, t.updated + t.counter + 1);
+    } else {
+        cancel(id);
+    }
+}
+
+void HOT_FUNC(Timeline::timerUnderflow)(uint8_t cia, uint8_t timer, uint32_t time) {
+    Cia &c = cias[cia];
+    CiaTimer &t = c.timer[timer];
+    c.icrData |= 1 << timer;
+
+    if (timer == 0) {
+        CiaTimer &timerB = c.timer[1];
+        if ((timerB.control & (0x40 | CIA_CONTROL_START)) == (0x40 | CIA_CONTROL_START)) {
+            if (timerB.counter == 0) {
+                timerUnderflow(cia, 1, time);
+            } else {
+                timerB.counter--;
+            }
+        }
+    }
+
+    if (t.control & CIA_CONTROL_ONE_SHOT) {
+        t.control &= ~CIA_CONTROL_START;
+        c.regs[0x0e + timer] = t.control;
+    }
+    t.counter = t.latch;
+    t.updated = time;
+    scheduleTimer(cia, timer);
+    updateInterrupts(cia);
+}
+
+void HOT_FUNC(Timeline::updateInterrupts)(uint8_t cia) {
+    Cia &c = cias[cia];
+    if (c.icrData & c.icrMask & 0x1f && !(c.icrData & CIA_ICR_SET)) {
+        c.icrData |= CIA_ICR_SET;
+        // CIA 2 drives the edge triggered NMI line.
+        if (cia == 1) {
+            nmiPending = true;
+        }
+    }
+    irqLine = cias[0].icrData & CIA_ICR_SET || vic.irqFlags & 0x80;
+}
+
+uint8_t HOT_FUNC(Timeline::ciaRead)(uint8_t cia, uint8_t reg, uint32_t now) {
+    Cia &c = cias[cia];
+    switch (reg) {
+        case 0x00:
+        case 0x01:
+            // No keys pressed and no joysticks on CIA 1.
+            return cia == 0 ? 0xff : c.regs[reg];
+        case 0x04:
+        case 0x06:
+            return timerValue(cia, (reg - 0x04) >> 1, now) & 0xff;
+        case 0x05:
+        case 0x07:
+            return timerValue(cia, (reg - 0x05) >> 1, now) >> 8;
+        case 0x0d: {
+            // Reading the ICR acknowledges the interrupt.
+            const uint8_t value = c.icrData;
+            c.icrData = 0;
+            updateInterrupts(cia);
+            return value;
+        }
+        case 0x0e:
+        case 0x0f:
+            return c.timer[reg - 0x0e].control;
+        default:
+            return c.regs[reg];
+    }
+}
+
+void Timeline::ciaWrite(uint8_t cia, uint8_t reg, uint8_t value, uint32_t now) {
+    Cia &c = cias[cia];
+    c.regs[reg] = value;
+    switch (reg) {
+        case 0x04:
+        case 0x06: {
+            CiaTimer &t = c.timer[(reg - 0x04) >> 1];
+            t.latch = (t.latch & 0xff00) | value;
+            break;
+        }
+        case 0x05:
+        case 0x07: {
+            CiaTimer &t = c.timer[(reg - 0x05) >> 1];
+            t.latch = (t.latch & 0x00ff) | value << 8;
+            // Writing the high byte of a stopped timer also loads it.
+            if (!(t.control & CIA_CONTROL_START)) {
+                t.counter = t.latch;
+            }
+            break;
+        }
+        case 0x0d:
+            if (value & CIA_ICR_SET) {
+                c.icrMask |= value & 0x1f;
+            } else {
+                c.icrMask &= ~(value & 0x1f);
+            }
+            updateInterrupts(cia);
+            break;
+        case 0x0e:
+        case 0x0f: {
+            const uint8_t timer = reg - 0x0e;
+            CiaTimer &t = c.timer[timer];
+            syncTimer(cia, timer, now);
+            if (value & CIA_CONTROL_FORCE_LOAD) {
+                t.counter = t.latch;
+            }
+            t.control = value & ~CIA_CONTROL_FORCE_LOAD;
+            t.updated = now;
+            scheduleTimer(cia, timer);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+uint16_t Timeline::ciaTimerLatch(uint8_t cia, uint8_t timer) {
+    return cias[cia].timer[timer].latch;
+}
+
+// ----------------------------------------------------------------------------
+// VIC
+// ----------------------------------------------------------------------------
+
+uint32_t Timeline::frameCycles() {
+    return vic.cyclesPerLine * vic.linesPerFrame;
+}
+
+uint16_t Timeline::rasterLine(uint32_t now) {
+    const uint32_t elapsed = now - vic.frameStart;
+    if (elapsed >= frameCycles()) {
+        vic.frameStart += elapsed - elapsed % frameCycles();
+    }
+    return (now - vic.frameStart) / vic.cyclesPerLine;
+}
+
+void Timeline::scheduleRaster(uint32_t now) {
+    const uint16_t compare = vic.regs[0x12] | (vic.regs[0x11] & 0x80) << 1;
+    if (compare >= vic.linesPerFrame) {
+        cancel(VIC_RASTER);
+        return;
+    }
+    rasterLine(now);
+    uint32_t time = vic.frameStart + compare * vic.cyclesPerLine;
+    if (!isBefore(now, time)) {
+        time += frameCycles();
+    }
+    schedule(VIC_RASTER, time);
+}
+
+uint8_t Timeline::vicRead(uint8_t reg, uint32_t now) {
+    switch (reg) {
+        case 0x11:
+            return (vic.regs[0x11] & 0x7f) | (rasterLine(now) & 0x100) >> 1;
+        case 0x12:
+            return rasterLine(now) & 0xff;
+        case 0x19:
+            return vic.irqFlags | 0x70;
+        case 0x1a:
+            return vic.irqMask | 0xf0;
+        default:
+            return vic.regs[reg];
+    }
+}
+
+void Timeline::vicWrite(uint8_t reg, uint8_t value, uint32_t now) {
+    vic.regs[reg] = value;
+    switch (reg) {
+        case 0x11:
+        case 0x12:
+            scheduleRaster(now);
+            return;
+        case 0x19:
+            vic.irqFlags &= ~(value & 0x0f);
+            break;
+        case 0x1a:
+            vic.irqMask = value & 0x0f;
+            break;
+        default:
+            return;
+    }
+    if (vic.irqFlags & vic.irqMask & 0x0f) {
+        vic.irqFlags |= 0x80;
+    } else {
+        vic.irqFlags &= 0x7f;
+    }
+    irqLine = cias[0].icrData & CIA_ICR_SET || vic.irqFlags & 0x80;
+}
@@ -0,0 +1,135 @@
+#ifndef SIDPOD_TIMELINE_H
+#define SIDPOD_TIMELINE_H
+
+#include <cstdint>
+
+#define TIMELINE_EVENT_COUNT    5
+
+/*
+ * CIA 1/2 timers and the VIC raster interrupt, driven by a short list of
+ * upcoming events sorted by the 6502 cycle they fall on. The CPU runs freely
+ * between two events, so no time is spent stepping idle cycles.
+ *
+ * All times are taken from the free running 6502 cycle counter and compared
+ * with wrap-around safe arithmetic.
+ */
+class Timeline {
+public:
+    struct State;
+
+    static void reset(uint32_t now, bool isPAL);
+
+    static void readState(State &state);
+
+    static void writeState(const State &state);
+
+    static uint8_t ciaRead(uint8_t cia, uint8_t reg, uint32_t now);
+
+    static void ciaWrite(uint8_t cia, uint8_t reg, uint8_t value, uint32_t now);
+
+    static uint8_t vicRead(uint8_t reg, uint32_t now);
+
+    static void vicWrite(uint8_t reg, uint8_t value, uint32_t now);
+
+    static uint16_t ciaTimerLatch(uint8_t cia, uint8_t timer);
+
+    static uint32_t nextEventTime(uint32_t now) {
+        return eventCount ? events[0].time : now + 0x40000000;
+    }
+
+    static void runEvents(uint32_t now);
+
+    static bool irq() {
+        return irqLine;
+    }
+
+    static bool takeNmi() {
+        const bool pending = nmiPending;
+        nmiPending = false;
+        return pending;
+    }
+
+    static bool isBefore(const uint32_t a, const uint32_t b) {
+        return static_cast<int32_t>(a - b) < 0;
+    }
+
+private:
+    enum EventId : uint8_t {
+        CIA1_TIMER_A,
+        CIA1_TIMER_B,
+        CIA2_TIMER_A,
+        CIA2_TIMER_B,
+        VIC_RASTER
+    };
+
+    struct Event {
+        uint32_t time;
+        EventId id;
+    };
+
+    struct CiaTimer {
+        uint16_t latch;
+        uint16_t counter;
+        uint32_t updated;
+        uint8_t control;
+    };
+
+    struct Cia {
+        CiaTimer timer[2];
+        uint8_t icrMask;
+        uint8_t icrData;
+        uint8_t regs[16];
+    };
+
+    struct Vic {
+        uint8_t regs[0x40];
+        uint8_t irqFlags;
+        uint8_t irqMask;
+        uint32_t frameStart;
+        uint16_t cyclesPerLine;
+        uint16_t linesPerFrame;
+    };
+
+public:
+    // Everything the timeline keeps, to be saved and restored as is.
+    struct State {
+        Event events[TIMELINE_EVENT_COUNT];
+        int eventCount;
+        Cia cias[2];
+        Vic vic;
+        bool irqLine;
+        bool nmiPending;
+    };
+
+private:
+    static Event events[TIMELINE_EVENT_COUNT];
+    static int eventCount;
+    static Cia cias[2];
+    static Vic vic;
+    static bool irqLine;
+    static bool nmiPending;
+
+    static void schedule(EventId id, uint32_t time);
+
+    static void cancel(EventId id);
+
+    static bool countsCycles(uint8_t cia, uint8_t timer);
+
+    static uint16_t timerValue(uint8_t cia, uint8_t timer, uint32_t now);
+
+    static void syncTimer(uint8_t cia, uint8_t timer, uint32_t now);
+
+    static void scheduleTimer(uint8_t cia, uint8_t timer);
+
+    static void timerUnderflow(uint8_t cia, uint8_t timer, uint32_t time);
+
+    static void updateInterrupts(uint8_t cia);
+
+    static uint32_t frameCycles();
+
+    static uint16_t rasterLine(uint32_t now);
+
+    static void scheduleRaster(uint32_t now);
+};
+
+#endif //SIDPOD_TIMELINE_H
@@ -0,0 +1,48 @@
+#include "VisualizationCapture.h"
+
+#include <cstring>
+#include <hardware/sync.h>
+
+#include "../platform_config.h"
+
+#define CAPTURE_HALF_SAMPLES    (FFT_SAMPLES + MAX_SAMPLES_PER_BUFFER)
+
+static short halves[2][CAPTURE_HALF_SAMPLES];
+static int filling = 0;
+static int filled = 0;
+static const short *volatile window = nullptr;
+static volatile uint32_t sequence = 0;
+
+short *VisualizationCapture::tap(int &room) {
+    room = CAPTURE_HALF_SAMPLES - filled;
+    return halves[filling] + filled;
+}
+
+void VisualizationCapture::captured(int samples) {
+    filled += samples;
+    if (filled >= FFT_SAMPLES) {
+        __dmb();
+        window = halves[filling] + filled - FFT_SAMPLES;
+        sequence = sequence + 1;
+        filling ^= 1;
+        filled = 0;
+    }
+}
+
+void VisualizationCapture::clear() {
+    memset(halves, 0, sizeof(halves));
+    filled = 0;
+    __dmb();
+    sequence = sequence + 1;
+}
+
+const short *VisualizationCapture::latest(uint32_t &sequenceRead) {
+    sequenceRead = sequence;
+    __dmb();
+    return window;
+}
+
+bool VisualizationCapture::stillValid(uint32_t sequenceRead) {
+    __dmb();
+    return sequence == sequenceRead;
+}
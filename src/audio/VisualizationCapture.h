@@ -0,0 +1,35 @@
+#ifndef SIDPOD_VISUALIZATIONCAPTURE_H
+#define SIDPOD_VISUALIZATIONCAPTURE_H
+
+#include <cstdint>
+
+/*
+ * The mono mix of the last FFT_SAMPLES samples, handed from the audio core to
+ * the visualization without either side waiting for the other. Core1 fills one
+ * of two halves a buffer at a time, and once it holds a whole window publishes
+ * the newest FFT_SAMPLES samples of it under a sequence counter and moves on to
+ * the other half. Each half has room for a window and a buffer more, so a
+ * buffer is always captured whole. Core0 reads the published window where it
+ * lies, and as core1 only writes to it again once the next window is
+ * published, a reader that finds the counter unchanged when it is done has
+ * read one window from start to end.
+ */
+class VisualizationCapture {
+public:
+    // Called by core1: where the mixer should put the next buffer, and how
+    // much it may put there.
+    static short *tap(int &room);
+
+    static void captured(int samples);
+
+    // Empties both halves, so the visualization falls silent.
+    static void clear();
+
+    // Called by core0: the last complete window and its sequence number, or
+    // nullptr before the first one.
+    static const short *latest(uint32_t &sequence);
+
+    static bool stillValid(uint32_t sequence);
+};
+
+#endif //SIDPOD_VISUALIZATIONCAPTURE_H
@@ -19,6 +19,7 @@
 
 #define __ENVELOPE_CC__
 #include "envelope.h"
+#include "../../platform_config.h"
 
 RESID_NAMESPACE_START
 
@@ -98,7 +99,7 @@ void EnvelopeGenerator::reset()
 // The described method is thus sufficient for exact calculation of the rate
 // periods.
 //
-const reg16 EnvelopeGenerator::rate_counter_period[] = {
+HOT_DATA const reg16 EnvelopeGenerator::rate_counter_period[] = {
       9,  //   2ms*1.0MHz/256 =     7.81
      32,  //   8ms*1.0MHz/256 =    31.25
      63,  //  16ms*1.0MHz/256 =    62.50
@@ -155,7 +156,7 @@ const reg16 EnvelopeGenerator::rate_counter_period[] = {
 // envelope counter are compared to the 4-bit sustain value.
 // This has been verified by sampling ENV3.
 //
-const reg8 EnvelopeGenerator::sustain_level[] = {
+HOT_DATA const reg8 EnvelopeGenerator::sustain_level[] = {
   0x00,
   0x11,
   0x22,
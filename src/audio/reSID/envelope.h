@@ -213,6 +213,21 @@ void EnvelopeGenerator::clock(cycle_count delta_t)
       return;
     }
 
+    // While the envelope counter is frozen only the exponential counter
+    // moves, so the remaining envelope steps are taken all at once.
+    if (RESID_SHORTCUTS
+	&& (hold_zero
+	    || (state == DECAY_SUSTAIN && envelope_counter == sustain_level[sustain]))
+	&& exponential_counter < exponential_counter_period)
+    {
+      delta_t -= rate_step;
+      int steps = 1 + delta_t/rate_period;
+      rate_counter = delta_t%rate_period;
+      exponential_counter = state == ATTACK ?
+	0 : (exponential_counter + steps)%exponential_counter_period;
+      return;
+    }
+
     rate_counter = 0;
     delta_t -= rate_step;
 
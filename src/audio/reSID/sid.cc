@@ -19,24 +19,104 @@
 
 #include "sid.h"
 #include <math.h>
-#include <hardware/interp.h>
+#include <string.h>
 
 #include "../platform_config.h"
 
 RESID_NAMESPACE_START
 
+#ifdef RESID_REFERENCE_CLOCKING
+bool resid_reference_clocking = false;
+#endif
+
 // Resampling constants.
-// The error in interpolated lookup is bounded by 1.234/L^2,
-// while the error in non-interpolated lookup is bounded by
-// 0.7854/L + 0.4113/L^2, see
+// The filter table is laid out in output samples rather than in cycles, so
+// a single table serves every clock and sample frequency. It is read with
+// linear interpolation, where the error is bounded by 1.234/L^2, see
 // http://www-ccrma.stanford.edu/~jos/resample/Choice_Table_Size.html
-// For a resolution of 16 bits this yields L >= 285 and L >= 51473,
-// respectively.
-const int SID::FIR_N = 125;
-const int SID::FIR_RES_INTERPOLATE = 285;
-const int SID::FIR_RES_FAST = 51473;
-const int SID::FIR_SHIFT = 15;
-const int SID::RINGSIZE = 16384;
+// The coefficients are 12 bits, which leaves room in a 32 bit accumulator
+// for full scale input over the whole filter.
+const int SID::FIR_HALF_LENGTH = RESID_FIR_HALF_LENGTH;
+const int SID::FIR_RES = RESID_FIR_RES;
+const int SID::FIR_SHIFT = 12;
+const int SID::RINGSIZE = RESID_FIR_RINGSIZE;
+
+// ----------------------------------------------------------------------------
+// Resampling filter table.
+// ----------------------------------------------------------------------------
+// One half of a Kaiser windowed sinc, computed by the compiler so that the
+// table ends up in flash. The cutoff is set relative to the output sample
+// frequency so that the transition band, which is about 0.15*sample_freq
+// wide for a 24 sample long filter and 60dB of stopband attenuation, ends
+// where aliases would fold back below 20kHz at 44.1kHz.
+namespace {
+    constexpr double FIR_CUTOFF = 0.47;
+    constexpr double FIR_BETA = 5.65;
+    constexpr double FIR_PI = 3.14159265358979323846;
+    constexpr int FIR_TABLE_END = RESID_FIR_HALF_LENGTH * RESID_FIR_RES;
+    static_assert(FIR_TABLE_END < (1 << 15), "Table positions are kept in 16.16 fixpoint");
+
+    constexpr double fir_sin(double x) {
+        while (x > FIR_PI) {
+            x -= 2 * FIR_PI;
+        }
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 14; n++) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double fir_sqrt(double x) {
+        if (x <= 0) {
+            return 0;
+        }
+        double root = x < 1 ? 1 : x;
+        for (;;) {
+            const double next = (root + x / root) / 2;
+            if (next >= root) {
+                return root;
+            }
+            root = next;
+        }
+    }
+
+    // I0() computes the 0th order modified Bessel function of the first kind.
+    constexpr double fir_i0(double x) {
+        const double halfx = x / 2;
+        double sum = 1;
+        double u = 1;
+        for (int n = 1; u >= 1e-9 * sum; n++) {
+            const double temp = halfx / n;
+            u *= temp * temp;
+            sum += u;
+        }
+        return sum;
+    }
+
+    struct FirTable {
+        // Two extra entries let the interpolation run past the last tap.
+        short value[FIR_TABLE_END + 2];
+    };
+
+    constexpr FirTable fir_table_create() {
+        FirTable table{};
+        const double i0_beta = fir_i0(FIR_BETA);
+        for (int i = 0; i <= FIR_TABLE_END; i++) {
+            const double x = static_cast<double>(i) / RESID_FIR_RES;
+            const double wt = x / RESID_FIR_HALF_LENGTH;
+            const double window = fir_i0(FIR_BETA * fir_sqrt(1 - wt * wt)) / i0_beta;
+            const double wc = FIR_PI * 2 * FIR_CUTOFF * x;
+            const double value = (i ? fir_sin(wc) / wc : 1) * window * (1 << 12);
+            table.value[i] = static_cast<short>(value < 0 ? value - 0.5 : value + 0.5);
+        }
+        return table;
+    }
+
+    HOT_DATA constexpr FirTable fir_table = fir_table_create();
+}
 
 // Fixpoint constants (16.16 bits).
 const int SID::FIXP_SHIFT = 16;
@@ -51,6 +131,7 @@ SID::SID() {
     voice[2].set_sync_source(&voice[1]);
 
     set_sampling_parameters(985248, SAMPLE_FAST, SAMPLE_RATE);
+    block_clocking = true;
 
     bus_value = 0;
     bus_value_ttl = 0;
@@ -172,7 +253,7 @@ reg8 SID::read(reg8 offset) {
 // ----------------------------------------------------------------------------
 // Write registers.
 // ----------------------------------------------------------------------------
-void SID::write(reg8 offset, reg8 value) {
+void HOT_FUNC(SID::write)(reg8 offset, reg8 value) {
     bus_value = value;
     bus_value_ttl = 0x2000;
 
@@ -270,6 +351,19 @@ void SID::mute(reg8 channel, bool enable) {
 }
 
 
+// ----------------------------------------------------------------------------
+// Voice state for visualization.
+// ----------------------------------------------------------------------------
+void SID::read_voices(VoiceState voices[3]) {
+    for (int i = 0; i < 3; i++) {
+        voices[i].freq = voice[i].wave.freq;
+        voices[i].pw = voice[i].wave.pw;
+        voices[i].waveform = voice[i].wave.waveform;
+        voices[i].envelope = voice[i].envelope.envelope_counter;
+    }
+}
+
+
 // ----------------------------------------------------------------------------
 // Constructor.
 // ----------------------------------------------------------------------------
@@ -294,6 +388,12 @@ SID::State::State() {
         envelope_state[i] = EnvelopeGenerator::RELEASE;
         hold_zero[i] = true;
     }
+
+    filter_Vhp = filter_Vbp = filter_Vlp = filter_Vnf = 0;
+    extfilt_Vlp = extfilt_Vhp = extfilt_Vo = 0;
+    sample_offset = 0;
+    sample_prev = 0;
+    fir_countdown = 0;
 }
 
 
@@ -352,6 +452,17 @@ SID::State SID::read_state() {
         state.hold_zero[i] = voice[i].envelope.hold_zero;
     }
 
+    state.filter_Vhp = filter.Vhp;
+    state.filter_Vbp = filter.Vbp;
+    state.filter_Vlp = filter.Vlp;
+    state.filter_Vnf = filter.Vnf;
+    state.extfilt_Vlp = extfilt.Vlp;
+    state.extfilt_Vhp = extfilt.Vhp;
+    state.extfilt_Vo = extfilt.Vo;
+    state.sample_offset = sample_offset;
+    state.sample_prev = sample_prev;
+    state.fir_countdown = fir_countdown;
+
     return state;
 }
 
@@ -380,6 +491,17 @@ void SID::write_state(const State &state) {
         voice[i].envelope.state = state.envelope_state[i];
         voice[i].envelope.hold_zero = state.hold_zero[i];
     }
+
+    filter.Vhp = state.filter_Vhp;
+    filter.Vbp = state.filter_Vbp;
+    filter.Vlp = state.filter_Vlp;
+    filter.Vnf = state.filter_Vnf;
+    extfilt.Vlp = state.extfilt_Vlp;
+    extfilt.Vhp = state.extfilt_Vhp;
+    extfilt.Vo = state.extfilt_Vo;
+    sample_offset = state.sample_offset;
+    sample_prev = state.sample_prev;
+    fir_countdown = state.fir_countdown;
 }
 
 
@@ -399,6 +521,15 @@ void SID::enable_external_filter(bool enable) {
 }
 
 
+// ----------------------------------------------------------------------------
+// Enable block clocking in SAMPLE_FAST mode.
+// This is handy for testing, the output is the same either way.
+// ----------------------------------------------------------------------------
+void SID::enable_block_clocking(bool enable) {
+    block_clocking = enable;
+}
+
+
 // ----------------------------------------------------------------------------
 // I0() computes the 0th order modified Bessel function of the first kind.
 // This function is originally from resample-1.5/filterkit.c by J. O. Smith.
@@ -433,12 +564,11 @@ float SID::I0(float x)
 // for sample frequencies up to ~ 44.1kHz, and 20kHz for higher sample
 // frequencies.
 //
-// For resampling, the ratio between the clock frequency and the sample
-// frequency is limited as follows:
-//   125*clock_freq/sample_freq < 16384
-// E.g. provided a clock frequency of ~ 1MHz, the sample frequency can not
-// be set lower than ~ 8kHz. A lower sample frequency would make the
-// resampling code overfill its 16k sample ring buffer.
+// For resampling, the chip is sampled every
+//   step = floor(clock_freq/sample_freq/RESID_FIR_OVERSAMPLING)
+// cycles, and the filter must fit in the ring buffer:
+//   2*RESID_FIR_HALF_LENGTH*clock_freq/(sample_freq*step) < RESID_FIR_RINGSIZE
+// With the default settings this holds for all audio sample frequencies.
 //
 // The end of passband frequency is also limited:
 //   pass_freq <= 0.9*sample_freq/2
@@ -469,6 +599,22 @@ bool SID::set_sampling_parameters(float clock_freq, sampling_method method,
         return false;
     }
 
+    // The chip is sampled every step_cycles cycles for resampling, which
+    // advances the filter table by step entries.
+    cycle_count step_cycles = 1;
+    int step = 0;
+    if (method == SAMPLE_RESAMPLE) {
+        step_cycles = static_cast<cycle_count>(clock_freq / sample_freq / RESID_FIR_OVERSAMPLING);
+        if (step_cycles < 1) {
+            step_cycles = 1;
+        }
+        step = static_cast<int>(step_cycles * FIR_RES * sample_freq / clock_freq + 0.5);
+        // Check whether the filter would overrun the ring buffer.
+        if (step < 1 || 2 * FIR_TABLE_END / step + 2 >= RINGSIZE) {
+            return false;
+        }
+    }
+
     // Set the external filter to the pass freq
     extfilt.set_sampling_parameter(pass_freq);
     clock_frequency = clock_freq;
@@ -480,6 +626,16 @@ bool SID::set_sampling_parameters(float clock_freq, sampling_method method,
     sample_offset = 0;
     sample_prev = 0;
 
+    if (method == SAMPLE_RESAMPLE) {
+        fir_step_cycles = step_cycles;
+        fir_step = step;
+        fir_scale = (fir_step << FIXP_SHIFT) / fir_step_cycles;
+        fir_gain = static_cast<int>(2 * FIR_CUTOFF * fir_step / FIR_RES * (1 << 16) + 0.5);
+        fir_countdown = fir_step_cycles;
+        fir_index = 0;
+        memset(fir_ring, 0, sizeof(fir_ring));
+    }
+
     return true;
 }
 
@@ -559,7 +715,7 @@ void SID::clock() {
 // ----------------------------------------------------------------------------
 // SID clocking - delta_t cycles.
 // ----------------------------------------------------------------------------
-void SID::clock(cycle_count delta_t) {
+void HOT_FUNC(SID::clock)(cycle_count delta_t) {
     int i;
 
     if (delta_t <= 0) {
@@ -651,22 +807,85 @@ void SID::clock(cycle_count delta_t) {
 // }
 //
 // ----------------------------------------------------------------------------
-int SID::clock(cycle_count &delta_t, short *buf, int n) {
+int HOT_FUNC(SID::clock)(cycle_count &delta_t, short *buf, int n) {
     switch (sampling) {
         default:
         case SAMPLE_FAST:
+            if (block_clocking && !hard_sync()) {
+                return clock_block(delta_t, buf, n);
+            }
             return clock_fast(delta_t, buf, n);
         case SAMPLE_INTERPOLATE:
             // TODO: Explore if the hardware interpolation can be used
             return clock_interpolate(delta_t, buf, n);
+        case SAMPLE_RESAMPLE:
+            return clock_resample(delta_t, buf, n);
     }
 }
 
-int SID::clock_and_mix(cycle_count &delta_t, short *buf, int n) {
-    return clock_and_mix_fast(delta_t, buf, n);
+// ----------------------------------------------------------------------------
+// SID clocking without audio sampling, for seeking.
+// The chip is delta clocked in one go, and the sampling position is moved on
+// just as clocking with audio sampling would have, so that the samples after
+// a skip are taken on the same cycles as without it. The filters see the
+// voice outputs of the first cycle throughout, and the FIR ring buffer is not
+// refilled, so the output takes a few milliseconds to settle.
+// ----------------------------------------------------------------------------
+void SID::skip(cycle_count delta_t) {
+    if (delta_t <= 0) {
+        return;
+    }
+    clock(delta_t);
+
+    switch (sampling) {
+        default:
+        case SAMPLE_FAST:
+            for (;;) {
+                cycle_count next_sample_offset = sample_offset + cycles_per_sample + (1 << (FIXP_SHIFT - 1));
+                cycle_count delta_t_sample = next_sample_offset >> FIXP_SHIFT;
+                if (delta_t_sample > delta_t) {
+                    break;
+                }
+                delta_t -= delta_t_sample;
+                sample_offset = (next_sample_offset & FIXP_MASK) - (1 << (FIXP_SHIFT - 1));
+            }
+            break;
+        case SAMPLE_INTERPOLATE:
+            for (;;) {
+                cycle_count next_sample_offset = sample_offset + cycles_per_sample;
+                cycle_count delta_t_sample = next_sample_offset >> FIXP_SHIFT;
+                if (delta_t_sample > delta_t) {
+                    break;
+                }
+                delta_t -= delta_t_sample;
+                sample_offset = next_sample_offset & FIXP_MASK;
+            }
+            break;
+        case SAMPLE_RESAMPLE:
+            if (delta_t >= fir_countdown) {
+                fir_countdown = fir_step_cycles - (delta_t - fir_countdown) % fir_step_cycles;
+            } else {
+                fir_countdown -= delta_t;
+            }
+            for (;;) {
+                cycle_count delta_t_sample = (sample_offset + FIXP_MASK) >> FIXP_SHIFT;
+                if (delta_t_sample > delta_t) {
+                    break;
+                }
+                delta_t -= delta_t_sample;
+                sample_offset += cycles_per_sample - (delta_t_sample << FIXP_SHIFT);
+            }
+            break;
+    }
+    sample_offset -= delta_t << FIXP_SHIFT;
 }
 
-RESID_INLINE int SID::clock_and_mix_fast(cycle_count &delta_t, short *buf, int n) {
+
+// ----------------------------------------------------------------------------
+// SID clocking with audio sampling - delta clocking picking nearest sample.
+// ----------------------------------------------------------------------------
+RESID_INLINE
+int HOT_FUNC(SID::clock_fast)(cycle_count &delta_t, short *buf, int n) {
     int s = 0;
 
     for (;;) {
@@ -681,10 +900,7 @@ RESID_INLINE int SID::clock_and_mix_fast(cycle_count &delta_t, short *buf, int n
         clock(delta_t_sample);
         delta_t -= delta_t_sample;
         sample_offset = (next_sample_offset & FIXP_MASK) - (1 << (FIXP_SHIFT - 1));
-        interp0->base[0] = buf[s];
-        interp0->base[1] = output();
-        interp0->accum[1] = 128;
-        buf[s++] = static_cast<short>(interp0->peek[1]);
+        buf[s++] = output();
     }
 
     clock(delta_t);
@@ -693,12 +909,93 @@ RESID_INLINE int SID::clock_and_mix_fast(cycle_count &delta_t, short *buf, int n
     return s;
 }
 
+
 // ----------------------------------------------------------------------------
-// SID clocking with audio sampling - delta clocking picking nearest sample.
+// Check whether any oscillator hard syncs another one, in which case the
+// oscillators must be clocked on every MSB toggle. See SID::clock().
+// ----------------------------------------------------------------------------
+RESID_INLINE
+bool SID::hard_sync() {
+    return voice[0].wave.sync || voice[1].wave.sync || voice[2].wave.sync;
+}
+
+
+// ----------------------------------------------------------------------------
+// SID clocking with audio sampling - block rendering picking nearest sample.
+//
+// This produces exactly the same samples as clock_fast(), for a stretch of
+// cycles without register writes and without hard sync. Everything that only
+// depends on the registers is then decided once for the block instead of in
+// every clock(delta_t_sample): the MSB search for hard sync falls away, the
+// voice routing into the filter and the filter output selection become
+// masks, and the filter state is kept in locals.
+//
+// A voice with its envelope frozen at zero stays silent until the next
+// register write. Unless it ring modulates an audible voice it is not clocked
+// per sample but caught up at the end of the block. When all three voices are
+// silent the chip is idle, and as soon as the filters have settled on a
+// fixed point every further sample is the same and is simply repeated.
 // ----------------------------------------------------------------------------
 RESID_INLINE
-int SID::clock_fast(cycle_count &delta_t, short *buf, int n) {
+int HOT_FUNC(SID::clock_block)(cycle_count &delta_t, short *buf, int n) {
+    bool silent[3];
+    for (int i = 0; i < 3; i++) {
+        silent[i] = voice[i].envelope.hold_zero && !voice[i].envelope.envelope_counter;
+    }
+    const bool idle = silent[0] && silent[1] && silent[2];
+    bool skip[3];
+    for (int i = 0; i < 3; i++) {
+        skip[i] = silent[i] && (idle || !voice[i].wave.sync_dest->ring_mod);
+    }
+
+    // Routing of voice 1-3 and ext_in into (Vi) and around (Vnf) the filter.
+    const reg8 filt = filter.enabled ? filter.filt : 0;
+    sound_sample route_i[4];
+    sound_sample route_nf[4];
+    for (int i = 0; i < 4; i++) {
+        route_i[i] = filt & (1 << i) ? -1 : 0;
+        route_nf[i] = ~route_i[i];
+    }
+    // NB! Voice 3 is not silenced by voice3off if it is routed through
+    // the filter.
+    if (filter.voice3off && !(filter.filt & 0x04)) {
+        route_i[2] = route_nf[2] = 0;
+    }
+    const sound_sample input = ext_in >> 7;
+
+    // Filter output selection and constants.
+    const bool filter_enabled = filter.enabled;
+    const sound_sample out_lp = filter.hp_bp_lp & 0x1 ? -1 : 0;
+    const sound_sample out_bp = filter.hp_bp_lp & 0x2 ? -1 : 0;
+    const sound_sample out_hp = filter.hp_bp_lp & 0x4 ? -1 : 0;
+    const sound_sample vol = filter.vol;
+    const sound_sample mixer_DC = filter.mixer_DC;
+    const sound_sample w0_ceil_dt = filter.w0_ceil_dt;
+    const sound_sample _1024_div_Q = filter._1024_div_Q;
+    sound_sample Vhp = filter.Vhp;
+    sound_sample Vbp = filter.Vbp;
+    sound_sample Vlp = filter.Vlp;
+    sound_sample Vnf = filter.Vnf;
+
+    // External filter constants.
+    const bool extfilt_enabled = extfilt.enabled;
+    const sound_sample w0lp = extfilt.w0lp;
+    const sound_sample w0hp = extfilt.w0hp;
+    const sound_sample extfilt_DC = extfilt.mixer_DC;
+    sound_sample Elp = extfilt.Vlp;
+    sound_sample Ehp = extfilt.Vhp;
+    sound_sample Eo = extfilt.Vo;
+
+    // Fixed point test, see below.
+    const sound_sample w0_delta_t_max = w0_ceil_dt * 8 >> 6;
+    const sound_sample w0lp_delta_t_max = w0lp * 8 >> 8;
+    const sound_sample w0hp_delta_t_max = w0hp * 8;
+
     int s = 0;
+    bool full = false;
+    bool settled = false;
+    short settled_sample = 0;
+    cycle_count clocked = 0;
 
     for (;;) {
         cycle_count next_sample_offset = sample_offset + cycles_per_sample + (1 << (FIXP_SHIFT - 1));
@@ -707,14 +1004,117 @@ int SID::clock_fast(cycle_count &delta_t, short *buf, int n) {
             break;
         }
         if (s >= n) {
-            return s;
+            full = true;
+            break;
         }
-        clock(delta_t_sample);
+
+        if (settled) {
+            clocked += delta_t_sample;
+            delta_t -= delta_t_sample;
+            sample_offset = (next_sample_offset & FIXP_MASK) - (1 << (FIXP_SHIFT - 1));
+            buf[s++] = settled_sample;
+            continue;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            if (!skip[i]) {
+                voice[i].envelope.clock(delta_t_sample);
+                voice[i].wave.clock(delta_t_sample);
+            }
+        }
+
+        const sound_sample voice1 = voice[0].output() >> 7;
+        const sound_sample voice2 = voice[1].output() >> 7;
+        const sound_sample voice3 = voice[2].output() >> 7;
+        Vnf = (voice1 & route_nf[0]) + (voice2 & route_nf[1]) + (voice3 & route_nf[2]) + (input & route_nf[3]);
+
+        const sound_sample Vfi = (voice1 & route_i[0]) + (voice2 & route_i[1]) +
+                                 (voice3 & route_i[2]) + (input & route_i[3]);
+        sound_sample Vf = 0;
+        if (filter_enabled) {
+            // Same 8 cycle steps as Filter::clock(delta_t, ...).
+            for (cycle_count delta_t_left = delta_t_sample; delta_t_left;) {
+                const cycle_count delta_t_flt = delta_t_left < 8 ? delta_t_left : 8;
+                sound_sample w0_delta_t = w0_ceil_dt * delta_t_flt >> 6;
+                sound_sample dVbp = (w0_delta_t * Vhp >> 14);
+                sound_sample dVlp = (w0_delta_t * Vbp >> 14);
+                Vbp -= dVbp;
+                Vlp -= dVlp;
+                Vhp = (Vbp * _1024_div_Q >> 10) - Vlp - Vfi;
+                delta_t_left -= delta_t_flt;
+            }
+            Vf = (Vlp & out_lp) + (Vbp & out_bp) + (Vhp & out_hp);
+        }
+        const sound_sample Vi = (Vnf + Vf + mixer_DC) * vol;
+
+        if (extfilt_enabled) {
+            // Same 8 cycle steps as ExternalFilter::clock(delta_t, ...).
+            for (cycle_count delta_t_left = delta_t_sample; delta_t_left;) {
+                const cycle_count delta_t_flt = delta_t_left < 8 ? delta_t_left : 8;
+                sound_sample dVlp = (w0lp * delta_t_flt >> 8) * (Vi - Elp) >> 12;
+                sound_sample dVhp = w0hp * delta_t_flt * (Elp - Ehp) >> 20;
+                Eo = Elp - Ehp;
+                Elp += dVlp;
+                Ehp += dVhp;
+                delta_t_left -= delta_t_flt;
+            }
+        } else {
+            Eo = Vi - extfilt_DC;
+        }
+
+        clocked += delta_t_sample;
         delta_t -= delta_t_sample;
         sample_offset = (next_sample_offset & FIXP_MASK) - (1 << (FIXP_SHIFT - 1));
+        extfilt.Vo = Eo;
         buf[s++] = output();
+
+        // The input of an idle chip is constant, so once neither filter moves
+        // in a full 8 cycle step, the state is a fixed point. The steps only
+        // get smaller for shorter steps, so it holds for every sample after.
+        if (idle) {
+            settled = (!filter_enabled ||
+                       (!(w0_delta_t_max * Vhp >> 14) && !(w0_delta_t_max * Vbp >> 14) &&
+                        Vhp == (Vbp * _1024_div_Q >> 10) - Vlp - Vfi)) &&
+                      (!extfilt_enabled ||
+                       (!(w0lp_delta_t_max * (Vi - Elp) >> 12) && !(w0hp_delta_t_max * (Elp - Ehp) >> 20) &&
+                        Eo == Elp - Ehp));
+            settled_sample = buf[s - 1];
+        }
+    }
+
+    // Catch up the voices that were not clocked per sample.
+    for (int i = 0; i < 3; i++) {
+        if (skip[i]) {
+            voice[i].envelope.clock(clocked);
+            voice[i].wave.clock(clocked);
+        }
     }
 
+    if (filter_enabled) {
+        filter.Vhp = Vhp;
+        filter.Vbp = Vbp;
+        filter.Vlp = Vlp;
+    } else {
+        filter.Vhp = filter.Vbp = filter.Vlp = 0;
+    }
+    filter.Vnf = Vnf;
+    if (extfilt_enabled) {
+        extfilt.Vlp = Elp;
+        extfilt.Vhp = Ehp;
+    } else {
+        extfilt.Vlp = extfilt.Vhp = 0;
+    }
+
+    // Age bus value.
+    bus_value_ttl -= clocked;
+    if (bus_value_ttl <= 0) {
+        bus_value = 0;
+        bus_value_ttl = 0;
+    }
+
+    if (full) {
+        return s;
+    }
     clock(delta_t);
     sample_offset -= delta_t << FIXP_SHIFT;
     delta_t = 0;
@@ -732,7 +1132,7 @@ int SID::clock_fast(cycle_count &delta_t, short *buf, int n) {
 // sampling noise.
 // ----------------------------------------------------------------------------
 RESID_INLINE
-int SID::clock_interpolate(cycle_count &delta_t, short *buf, int n) {
+int HOT_FUNC(SID::clock_interpolate)(cycle_count &delta_t, short *buf, int n) {
     int s = 0;
     int i;
 
@@ -776,4 +1176,101 @@ int SID::clock_interpolate(cycle_count &delta_t, short *buf, int n) {
 }
 
 
+// ----------------------------------------------------------------------------
+// SID clocking with audio sampling - band limited resampling.
+//
+// The chip is delta clocked and sampled every fir_step_cycles cycles into a
+// ring buffer, at a rate of at least RESID_FIR_OVERSAMPLING times the sample
+// frequency. Each output sample is the ring buffer convolved with a Kaiser
+// windowed sinc, which removes the aliasing of SAMPLE_FAST at a fraction of
+// the cost of clocking every cycle. The output is delayed by
+// RESID_FIR_HALF_LENGTH samples.
+//
+// Here sample_offset is the time until the next output sample.
+// ----------------------------------------------------------------------------
+RESID_INLINE
+int HOT_FUNC(SID::clock_resample)(cycle_count &delta_t, short *buf, int n) {
+    int s = 0;
+
+    for (;;) {
+        cycle_count delta_t_sample = (sample_offset + FIXP_MASK) >> FIXP_SHIFT;
+        if (delta_t_sample > delta_t) {
+            break;
+        }
+        if (s >= n) {
+            return s;
+        }
+        clock_ring(delta_t_sample);
+        delta_t -= delta_t_sample;
+        sample_offset -= delta_t_sample << FIXP_SHIFT;
+
+        buf[s++] = fir_output(((fir_step_cycles - fir_countdown) << FIXP_SHIFT) + sample_offset);
+        sample_offset += cycles_per_sample;
+    }
+
+    clock_ring(delta_t);
+    sample_offset -= delta_t << FIXP_SHIFT;
+    delta_t = 0;
+    return s;
+}
+
+RESID_INLINE
+void HOT_FUNC(SID::clock_ring)(cycle_count delta_t) {
+    while (delta_t >= fir_countdown) {
+        clock(fir_countdown);
+        delta_t -= fir_countdown;
+        fir_countdown = fir_step_cycles;
+
+        // The ring is stored twice so that the filter can read it backwards
+        // without wrapping.
+        fir_ring[fir_index] = fir_ring[fir_index + RINGSIZE] = output();
+        fir_index = (fir_index + 1) & (RINGSIZE - 1);
+    }
+    clock(delta_t);
+    fir_countdown -= delta_t;
+}
+
+// sample_time is the time of the output sample relative to the newest ring
+// sample, in 16.16 cycles.
+RESID_INLINE
+short HOT_FUNC(SID::fir_output)(cycle_count sample_time) {
+    // Table position of the newest ring sample, 16.16.
+    const int position = (FIR_TABLE_END << FIXP_SHIFT) - ((sample_time >> 8) * fir_scale >> 8);
+    const int frac = position & FIXP_MASK;
+    int index = position >> FIXP_SHIFT;
+    const short *sample = fir_ring + fir_index + RINGSIZE - 1;
+
+    while (index > FIR_TABLE_END) {
+        index -= fir_step;
+        sample--;
+    }
+
+    // Convolve with the table at index and index + 1 in the same pass and
+    // interpolate between the two results.
+    int v0 = 0;
+    int v1 = 0;
+    for (; index >= 0; index -= fir_step) {
+        v0 += *sample * fir_table.value[index];
+        v1 += *sample-- * fir_table.value[index + 1];
+    }
+    for (index = -index; index <= FIR_TABLE_END; index += fir_step) {
+        v0 += *sample * fir_table.value[index];
+        v1 += *sample-- * fir_table.value[index - 1];
+    }
+
+    const int v = v0 + static_cast<int>(static_cast<int64_t>(v1 - v0) * frac >> FIXP_SHIFT);
+    const int result = static_cast<int>(static_cast<int64_t>(v) * fir_gain >> (FIR_SHIFT + 16));
+
+    // Saturated arithmetics to guard against 16 bit sample overflow.
+    const int half = 1 << 15;
+    if (result >= half) {
+        return half - 1;
+    }
+    if (result < -half) {
+        return -half;
+    }
+    return static_cast<short>(result);
+}
+
+
 RESID_NAMESPACE_STOP
@@ -40,6 +40,8 @@ public:
 
     void enable_external_filter(bool enable);
 
+    void enable_block_clocking(bool enable);
+
     bool set_sampling_parameters(float clock_freq, sampling_method method,
                                  float sample_freq, float pass_freq = -1,
                                  float filter_scale = 0.97);
@@ -55,7 +57,7 @@ public:
 
     int clock(cycle_count &delta_t, short *buf, int n);
 
-    int clock_and_mix(cycle_count &delta_t, short *buf, int n);
+    void skip(cycle_count delta_t);
 
     void reset();
 
@@ -66,6 +68,16 @@ public:
 
     void mute(reg8 channel, bool enable);
 
+    // What each voice is playing, without the cost of a full read_state().
+    struct VoiceState {
+        reg16 freq;
+        reg12 pw;
+        reg8 waveform;
+        reg8 envelope;
+    };
+
+    void read_voices(VoiceState voices[3]);
+
     // Read/write state.
     class State {
     public:
@@ -85,6 +97,19 @@ public:
         reg8 envelope_counter[3];
         EnvelopeGenerator::State envelope_state[3];
         bool hold_zero[3];
+
+        // Filter, external filter and sampling state, so that the output
+        // carries on without a click after the state is written back.
+        sound_sample filter_Vhp;
+        sound_sample filter_Vbp;
+        sound_sample filter_Vlp;
+        sound_sample filter_Vnf;
+        sound_sample extfilt_Vlp;
+        sound_sample extfilt_Vhp;
+        sound_sample extfilt_Vo;
+        cycle_count sample_offset;
+        short sample_prev;
+        cycle_count fir_countdown;
     };
 
     State read_state();
@@ -100,9 +125,17 @@ public:
 protected:
     RESID_INLINE int clock_fast(cycle_count &delta_t, short *buf, int n);
 
+    RESID_INLINE int clock_block(cycle_count &delta_t, short *buf, int n);
+
+    RESID_INLINE bool hard_sync();
+
     RESID_INLINE int clock_interpolate(cycle_count &delta_t, short *buf, int n);
 
-    RESID_INLINE int clock_and_mix_fast(cycle_count &delta_t, short *buf, int n);
+    RESID_INLINE int clock_resample(cycle_count &delta_t, short *buf, int n);
+
+    RESID_INLINE void clock_ring(cycle_count delta_t);
+
+    RESID_INLINE short fir_output(cycle_count sample_time);
 
     Voice voice[3];
     Filter filter;
@@ -119,9 +152,8 @@ protected:
     int ext_in;
 
     // Resampling constants.
-    static const int FIR_N;
-    static const int FIR_RES_INTERPOLATE;
-    static const int FIR_RES_FAST;
+    static const int FIR_HALF_LENGTH;
+    static const int FIR_RES;
     static const int FIR_SHIFT;
     static const int RINGSIZE;
 
@@ -131,12 +163,19 @@ protected:
 
     // Sampling variables.
     sampling_method sampling;
+    bool block_clocking;
     cycle_count cycles_per_sample;
     cycle_count sample_offset;
-    int sample_index;
     short sample_prev;
-    int fir_N;
-    int fir_RES;
+
+    // Resampling variables.
+    short fir_ring[RESID_FIR_RINGSIZE * 2];
+    int fir_index;
+    cycle_count fir_step_cycles;
+    cycle_count fir_countdown;
+    int fir_step;
+    int fir_scale;
+    int fir_gain;
 };
 
 RESID_NAMESPACE_STOP
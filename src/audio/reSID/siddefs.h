@@ -27,6 +27,26 @@
 #define RESID_INLINING 1
 #define RESID_INLINE inline
 
+// Resampling filter size. The filter spans RESID_FIR_HALF_LENGTH output
+// samples on each side of the sample being computed, with RESID_FIR_RES
+// table entries per output sample. The chip is sampled at least
+// RESID_FIR_OVERSAMPLING times per output sample into a ring buffer of
+// RESID_FIR_RINGSIZE samples, which must be a power of two. Sampling the
+// chip more often reduces aliasing but costs more taps per output sample;
+// above ~6 the filter sum may overflow 32 bits.
+#ifndef RESID_FIR_HALF_LENGTH
+#define RESID_FIR_HALF_LENGTH 12
+#endif
+#ifndef RESID_FIR_RES
+#define RESID_FIR_RES 128
+#endif
+#ifndef RESID_FIR_OVERSAMPLING
+#define RESID_FIR_OVERSAMPLING 4
+#endif
+#ifndef RESID_FIR_RINGSIZE
+#define RESID_FIR_RINGSIZE 256
+#endif
+
 // Support namespace
 
 #ifdef RESID_NAMESPACE
@@ -39,6 +59,7 @@
 #   define RESID_NAMESPACE_START
 #   define RESID_NAMESPACE_STOP
 #endif
+#include <stdint.h>
 #include <sys/types.h>
 
 RESID_NAMESPACE_START
@@ -67,7 +88,18 @@ typedef sound_sample fc_point[2];
 
 enum chip_model { MOS6581, MOS8580 };
 
-enum sampling_method { SAMPLE_FAST, SAMPLE_INTERPOLATE};
+enum sampling_method { SAMPLE_FAST, SAMPLE_INTERPOLATE, SAMPLE_RESAMPLE };
+
+// The envelope and noise register delta clocks take shortcuts over the
+// original reSID loops. Builds defining RESID_REFERENCE_CLOCKING keep the
+// original loops too, selected at run time with resid_reference_clocking,
+// so that the shortcuts can be checked against them.
+#ifdef RESID_REFERENCE_CLOCKING
+extern bool resid_reference_clocking;
+#define RESID_SHORTCUTS (!resid_reference_clocking)
+#else
+#define RESID_SHORTCUTS true
+#endif
 
 
 #ifdef __cplusplus
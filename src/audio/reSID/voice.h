@@ -74,7 +74,12 @@ sound_sample Voice::output()
 {
   if (!muted)
   { // Multiply oscillator output with envelope output.
-    return (wave.output() - wave_zero)*envelope.output() + voice_DC;
+    // A silent voice outputs its DC level only, so the waveform is skipped.
+    reg8 envelope_output = envelope.output();
+    if (!envelope_output) {
+      return voice_DC;
+    }
+    return (wave.output() - wave_zero)*envelope_output + voice_DC;
   } else {
     return 0;
   }
@@ -19,6 +19,9 @@
 
 #define __WAVE_CC__
 #include "wave.h"
+#include "wave_resolve.h"
+
+#include <cstring>
 
 RESID_NAMESPACE_START
 
@@ -46,23 +49,130 @@ void WaveformGenerator::set_sync_source(WaveformGenerator* source)
 
 
 // ----------------------------------------------------------------------------
-// Set chip model.
+// Packed combined waveform tables, built at compile time from the switch
+// statements in wave_resolve.h. The table data of both chip models is kept in
+// flash, the tables of the chip models in use are copied to RAM.
 // ----------------------------------------------------------------------------
+namespace {
+  constexpr int WAVE_TABLE_MAX_BLOCKS = 256;
 
-void WaveformGenerator::set_chip_model(chip_model model)
+  constexpr reg12 wave_resolve(chip_model model, int table, reg12 output) {
+    if (model == MOS6581) {
+      switch (table) {
+        case WaveformGenerator::WAVE__ST:
+          return wave6581__STresolve(output);
+        case WaveformGenerator::WAVE_P_T:
+          return wave6581_P_Tresolve(output);
+        case WaveformGenerator::WAVE_PS_:
+          return wave6581_PS_resolve(output);
+        default:
+          return wave6581_PSTresolve(output);
+      }
+    }
+    switch (table) {
+      case WaveformGenerator::WAVE__ST:
+        return wave8580__STresolve(output);
+      case WaveformGenerator::WAVE_P_T:
+        return wave8580_P_Tresolve(output);
+      case WaveformGenerator::WAVE_PS_:
+        return wave8580_PS_resolve(output);
+      default:
+        return wave8580_PSTresolve(output);
+    }
+  }
+
+  struct WaveTableBuilder {
+    uint8_t data[WAVE_TABLE_INDEX_SIZE + WAVE_TABLE_MAX_BLOCKS * WAVE_TABLE_BLOCK];
+    int blocks;
+  };
+
+  // Splits the tables into blocks and stores every distinct block once.
+  constexpr WaveTableBuilder wave_tables_build(chip_model model) {
+    WaveTableBuilder builder{};
+    builder.blocks = 1;
+    for (int table = 0; table < WaveformGenerator::WAVE_TABLES; table++) {
+      for (int index = 0; index < 1 << (12 - WAVE_TABLE_BLOCK_BITS); index++) {
+        uint8_t samples[WAVE_TABLE_BLOCK]{};
+        bool silent = true;
+        for (int i = 0; i < WAVE_TABLE_BLOCK; i++) {
+          samples[i] = wave_resolve(model, table, index << WAVE_TABLE_BLOCK_BITS | i);
+          silent = silent && !samples[i];
+        }
+        int block = 0;
+        if (!silent) {
+          for (block = 1; block < builder.blocks; block++) {
+            bool same = true;
+            for (int i = 0; i < WAVE_TABLE_BLOCK && same; i++) {
+              same = builder.data[WAVE_TABLE_INDEX_SIZE + block * WAVE_TABLE_BLOCK + i] == samples[i];
+            }
+            if (same) {
+              break;
+            }
+          }
+          if (block == builder.blocks && builder.blocks < WAVE_TABLE_MAX_BLOCKS) {
+            for (int i = 0; i < WAVE_TABLE_BLOCK; i++) {
+              builder.data[WAVE_TABLE_INDEX_SIZE + block * WAVE_TABLE_BLOCK + i] = samples[i];
+            }
+            builder.blocks++;
+          }
+        }
+        builder.data[(table << (12 - WAVE_TABLE_BLOCK_BITS)) + index] = block;
+      }
+    }
+    return builder;
+  }
+
+  template<int BLOCKS>
+  struct WaveTables {
+    static constexpr int SIZE = WAVE_TABLE_INDEX_SIZE + BLOCKS * WAVE_TABLE_BLOCK;
+    uint8_t data[SIZE];
+  };
+
+  // Trims the builder down to the blocks that are used.
+  template<int BLOCKS>
+  constexpr WaveTables<BLOCKS> wave_tables_trim(const WaveTableBuilder &builder) {
+    WaveTables<BLOCKS> tables{};
+    for (int i = 0; i < WaveTables<BLOCKS>::SIZE; i++) {
+      tables.data[i] = builder.data[i];
+    }
+    return tables;
+  }
+
+  constexpr WaveTableBuilder wave6581_builder = wave_tables_build(MOS6581);
+  constexpr WaveTableBuilder wave8580_builder = wave_tables_build(MOS8580);
+  // The block index is a byte, so this also catches blocks that didn't fit.
+  static_assert(wave6581_builder.blocks < WAVE_TABLE_MAX_BLOCKS, "Too many 6581 waveform blocks");
+  static_assert(wave8580_builder.blocks < WAVE_TABLE_MAX_BLOCKS, "Too many 8580 waveform blocks");
+
+  constexpr auto wave6581_tables = wave_tables_trim<wave6581_builder.blocks>(wave6581_builder);
+  constexpr auto wave8580_tables = wave_tables_trim<wave8580_builder.blocks>(wave8580_builder);
+
+  uint8_t *wave_tables_ram[2];
+}
+
+const uint8_t* WaveformGenerator::combined_tables(chip_model model)
 {
-  if (model == MOS6581) {
-    wave__STresolve = &wave6581__STresolve;
-    wave_P_Tresolve = &wave6581_P_Tresolve;
-    wave_PS_resolve = &wave6581_PS_resolve;
-    wave_PSTresolve = &wave6581_PSTresolve;
-  } 
-  else {
-    wave__STresolve = &wave8580__STresolve;
-    wave_P_Tresolve = &wave8580_P_Tresolve;
-    wave_PS_resolve = &wave8580_PS_resolve;
-    wave_PSTresolve = &wave8580_PSTresolve;
+  const int index = model == MOS6581 ? 0 : 1;
+  if (!wave_tables_ram[index]) {
+    const uint8_t *tables = model == MOS6581 ? wave6581_tables.data : wave8580_tables.data;
+    wave_tables_ram[index] = new uint8_t[combined_tables_size(model)];
+    memcpy(wave_tables_ram[index], tables, combined_tables_size(model));
   }
+  return wave_tables_ram[index];
+}
+
+int WaveformGenerator::combined_tables_size(chip_model model)
+{
+  return model == MOS6581 ? sizeof(wave6581_tables.data) : sizeof(wave8580_tables.data);
+}
+
+
+// ----------------------------------------------------------------------------
+// Set chip model.
+// ----------------------------------------------------------------------------
+void WaveformGenerator::set_chip_model(chip_model model)
+{
+  wave_tables = combined_tables(model);
 }
 
 
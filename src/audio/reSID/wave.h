@@ -26,6 +26,12 @@
 
 RESID_NAMESPACE_START
 
+// Combined waveform tables are packed in blocks of 16 samples.
+#define WAVE_TABLE_BLOCK_BITS 4
+#define WAVE_TABLE_BLOCK (1 << WAVE_TABLE_BLOCK_BITS)
+// Block index for the four tables of a chip model.
+#define WAVE_TABLE_INDEX_SIZE (4 << (12 - WAVE_TABLE_BLOCK_BITS))
+
 // ----------------------------------------------------------------------------
 // A 24 bit accumulator is the basis for waveform generation. FREQ is added to
 // the lower 16 bits of the accumulator each cycle.
@@ -57,6 +63,18 @@ public:
   // 12-bit waveform output.
   RESID_INLINE reg12 output();
 
+  // Combined waveform tables, looked up with the 12-bit output of the first
+  // waveform in the name (the triangle output is right-shifted for P_T).
+  enum { WAVE__ST, WAVE_P_T, WAVE_PS_, WAVE_PST, WAVE_TABLES };
+
+  // Packed tables for a chip model, copied into RAM on first use.
+  static const uint8_t* combined_tables(chip_model model);
+
+  // Size in bytes of the packed tables for a chip model.
+  static int combined_tables_size(chip_model model);
+
+  RESID_INLINE static reg8 combined(const uint8_t* tables, int table, reg12 output);
+
 protected:
   const WaveformGenerator* sync_source;
   WaveformGenerator* sync_dest;
@@ -100,10 +118,10 @@ protected:
   RESID_INLINE reg12 outputNPS_();
   RESID_INLINE reg12 outputNPST();
 
-	reg12 (* wave_PSTresolve)(reg12);
-	reg12 (* wave_PS_resolve)(reg12);
-	reg12 (* wave_P_Tresolve)(reg12);
-	reg12 (* wave__STresolve)(reg12);
+  // Packed combined waveform tables for the chip model, see wave.cc.
+  const uint8_t* wave_tables;
+
+  RESID_INLINE reg12 combined(int table, reg12 output);
 
 
 friend class Voice;
@@ -170,7 +188,25 @@ void WaveformGenerator::clock(cycle_count delta_t)
   msb_rising = !(accumulator_prev & 0x800000) && (accumulator & 0x800000);
 
   // Shift noise register once for each time accumulator bit 19 is set high.
-  // Bit 19 is set high each time 2^20 (0x100000) is added to the accumulator.
+  // Bit 19 is set high each time 2^20 (0x100000) is added to the accumulator,
+  // i.e. once for every multiple of 0x100000 + 0x080000 that was passed.
+  if (RESID_SHORTCUTS) {
+    reg24 shifts = ((accumulator_prev + delta_accumulator + 0x080000) >> 20)
+      - ((accumulator_prev + 0x080000) >> 20);
+
+    while (shifts--) {
+      // Shift the noise/random register.
+      // NB! The shift is actually delayed 2 cycles, this is not modeled.
+      reg24 bit0 = ((shift_register >> 22) ^ (shift_register >> 17)) & 0x1;
+      shift_register <<= 1;
+      shift_register &= 0x7fffff;
+      shift_register |= bit0;
+    }
+    return;
+  }
+
+#ifdef RESID_REFERENCE_CLOCKING
+  // The original loop, walking the accumulator in steps of 2^20.
   reg24 shift_period = 0x100000;
 
   while (delta_accumulator) {
@@ -203,6 +239,7 @@ void WaveformGenerator::clock(cycle_count delta_t)
 
     delta_accumulator -= shift_period;
   }
+#endif
 }
 
 
@@ -374,25 +411,48 @@ reg12 WaveformGenerator::outputN___()
 RESID_INLINE
 reg12 WaveformGenerator::output__ST()
 {
-	return wave__STresolve(output__S_()) << 4;
+  return combined(WAVE__ST, output__S_()) << 4;
 }
 
 RESID_INLINE
 reg12 WaveformGenerator::output_P_T()
 {
-  return (wave_P_Tresolve(output___T() >> 1) << 4) & output_P__();
+  return (combined(WAVE_P_T, output___T() >> 1) << 4) & output_P__();
 }
 
 RESID_INLINE
 reg12 WaveformGenerator::output_PS_()
 {
-  return (wave_PS_resolve(output__S_()) << 4) & output_P__();
+  return (combined(WAVE_PS_, output__S_()) << 4) & output_P__();
 }
 
 RESID_INLINE
 reg12 WaveformGenerator::output_PST()
 {
-  return (wave_PSTresolve(output__S_()) << 4) & output_P__();
+  return (combined(WAVE_PST, output__S_()) << 4) & output_P__();
+}
+
+// ----------------------------------------------------------------------------
+// Combined waveform table lookup.
+// The tables are split into blocks of WAVE_TABLE_BLOCK samples. For each
+// table an index of one byte per block names the block of samples, out of
+// the distinct blocks of the chip model, with block 0 all zero.
+// This costs two byte loads for any input, whereas the switch statements the
+// tables are built from branch through binary searches.
+// ----------------------------------------------------------------------------
+RESID_INLINE
+reg8 WaveformGenerator::combined(const uint8_t* tables, int table, reg12 output)
+{
+  const uint8_t block = tables[(table << (12 - WAVE_TABLE_BLOCK_BITS))
+			    + (output >> WAVE_TABLE_BLOCK_BITS)];
+  return tables[WAVE_TABLE_INDEX_SIZE + (block << WAVE_TABLE_BLOCK_BITS)
+		+ (output & (WAVE_TABLE_BLOCK - 1))];
+}
+
+RESID_INLINE
+reg12 WaveformGenerator::combined(int table, reg12 output)
+{
+  return combined(wave_tables, table, output);
 }
 
 // Combined waveforms including noise:
@@ -492,6009 +552,6 @@ reg12 WaveformGenerator::output()
   }
 }
 
-RESID_INLINE
-reg12 wave6581_PSTresolve(reg12 output) {
-	switch (output) {
-		case 0x7fe:
-		case 0x7ff:
-		case 0xffe:
-		case 0xfff:
-			return 0x7f;
-		case 0x7ef:
-		case 0xfef:
-			return 0x20;
-		case 0x7fd:
-		case 0xffd:
-			return 0x7e;
-		case 0x7f7:
-		case 0xff7:
-			return 0x30;
-		case 0x3ff:
-		case 0xbff:
-			return 0x3f;
-		case 0x7fb:
-		case 0x7fc:
-		case 0xffb:
-		case 0xffc:
-			return 0x78;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave6581_PS_resolve(reg12 output) {
-	switch (output) {
-		case 0x3bf:
-		case 0xbbf:
-			return 0x3b;
-		case 0x5df:
-		case 0xddf:
-			return 0x5d;
-		case 0x7f3:
-		case 0x7f5:
-		case 0x7f6:
-		case 0x7f7:
-		case 0x7f9:
-		case 0x7fa:
-		case 0x7fb:
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-		case 0x7ff:
-		case 0xff3:
-		case 0xff5:
-		case 0xff6:
-		case 0xff7:
-		case 0xff9:
-		case 0xffa:
-		case 0xffb:
-		case 0xffc:
-		case 0xffd:
-		case 0xffe:
-		case 0xfff:
-			return 0x7f;
-		case 0x5fc:
-		case 0xdfc:
-			return 0x5c;
-		case 0x7e7:
-		case 0x7eb:
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-		case 0x7f4:
-		case 0x7f8:
-		case 0xfe7:
-		case 0xfeb:
-		case 0xfed:
-		case 0xfee:
-		case 0xfef:
-		case 0xff8:
-			return 0x7e;
-		case 0x5bf:
-		case 0xdbf:
-			return 0x5b;
-		case 0x7d7:
-		case 0x7db:
-		case 0x7dd:
-		case 0x7de:
-		case 0x7df:
-		case 0xfd7:
-		case 0xfdb:
-		case 0xfdd:
-		case 0xfde:
-		case 0xfdf:
-			return 0x7d;
-		case 0x7cf:
-		case 0x7ec:
-		case 0x7f1:
-		case 0x7f2:
-		case 0xfcf:
-		case 0xfec:
-		case 0xff1:
-		case 0xff2:
-		case 0xff4:
-			return 0x7c;
-		case 0x7b7:
-		case 0x7bb:
-		case 0x7bd:
-		case 0x7be:
-		case 0x7bf:
-		case 0xfb7:
-		case 0xfbb:
-		case 0xfbd:
-		case 0xfbe:
-		case 0xfbf:
-			return 0x7b;
-		case 0x7af:
-		case 0xfaf:
-			return 0x7a;
-		case 0x1ff:
-		case 0x9ff:
-			return 0x1f;
-		case 0x3f7:
-		case 0x3fb:
-		case 0x3fd:
-		case 0x3fe:
-		case 0x3ff:
-		case 0xbf7:
-		case 0xbfb:
-		case 0xbfd:
-		case 0xbfe:
-		case 0xbff:
-			return 0x3f;
-		case 0x3ef:
-		case 0x3fc:
-		case 0xbef:
-		case 0xbfc:
-			return 0x3e;
-		case 0x3df:
-		case 0xbdf:
-			return 0x3d;
-		case 0x5f7:
-		case 0x5fb:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x5ff:
-		case 0xdf7:
-		case 0xdfb:
-		case 0xdfd:
-		case 0xdfe:
-		case 0xdff:
-			return 0x5f;
-		case 0x5ef:
-		case 0xdef:
-			return 0x5e;
-		case 0x5f6:
-		case 0x5f9:
-		case 0x5fa:
-		case 0x6be:
-		case 0x6dd:
-		case 0x6de:
-		case 0x6e7:
-		case 0x6eb:
-		case 0x6ed:
-		case 0x6ee:
-		case 0x6f3:
-		case 0x71f:
-		case 0x72f:
-		case 0x737:
-		case 0x73b:
-		case 0x73d:
-		case 0x74f:
-		case 0x757:
-		case 0x75b:
-		case 0x7b8:
-		case 0x7d4:
-		case 0x7d8:
-		case 0x7e1:
-		case 0x7e2:
-		case 0xdf6:
-		case 0xdf9:
-		case 0xdfa:
-		case 0xebe:
-		case 0xede:
-		case 0xee7:
-		case 0xeeb:
-		case 0xeed:
-		case 0xeee:
-		case 0xef3:
-		case 0xf1f:
-		case 0xf2f:
-		case 0xf37:
-		case 0xf3b:
-		case 0xf3d:
-		case 0xf4f:
-		case 0xf57:
-		case 0xf5b:
-		case 0xfb8:
-		case 0xfd4:
-		case 0xfd8:
-		case 0xfe1:
-		case 0xfe2:
-			return 0x40;
-		case 0x6f5:
-		case 0x6f6:
-		case 0x6f9:
-		case 0x6fa:
-		case 0x6fc:
-		case 0x73e:
-		case 0x75d:
-		case 0x75e:
-		case 0x767:
-		case 0x76b:
-		case 0x76d:
-		case 0x76e:
-		case 0x773:
-		case 0x775:
-		case 0x776:
-		case 0x78f:
-		case 0x797:
-		case 0x79b:
-		case 0x79d:
-		case 0x79e:
-		case 0x7a7:
-		case 0x7ab:
-		case 0x7e4:
-		case 0x7e8:
-		case 0xef5:
-		case 0xef6:
-		case 0xef9:
-		case 0xefa:
-		case 0xefc:
-		case 0xf3e:
-		case 0xf5d:
-		case 0xf5e:
-		case 0xf67:
-		case 0xf6b:
-		case 0xf6d:
-		case 0xf6e:
-		case 0xf73:
-		case 0xf75:
-		case 0xf76:
-		case 0xf8f:
-		case 0xf97:
-		case 0xf9b:
-		case 0xf9d:
-		case 0xf9e:
-		case 0xfa7:
-		case 0xfab:
-		case 0xfe4:
-		case 0xfe8:
-			return 0x60;
-		case 0xff:
-		case 0x8ff:
-			return 0x07;
-		case 0x17f:
-		case 0x1bf:
-		case 0x27f:
-		case 0x47f:
-		case 0x97f:
-		case 0x9bf:
-		case 0xa7f:
-		case 0xc7f:
-			return 0x03;
-		case 0x1fe:
-		case 0x9fe:
-			return 0x02;
-		case 0x2bf:
-		case 0xabf:
-			return 0x01;
-		case 0x67f:
-		case 0xe7f:
-			return 0x67;
-		case 0x6ef:
-		case 0xeef:
-			return 0x6e;
-		case 0x6df:
-		case 0xedf:
-			return 0x6d;
-		case 0x6bf:
-		case 0xebf:
-			return 0x6b;
-		case 0x2ff:
-		case 0xaff:
-			return 0x2f;
-		case 0x4ff:
-		case 0xcff:
-			return 0x4f;
-		case 0x6f7:
-		case 0x6fb:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-		case 0xef7:
-		case 0xefb:
-		case 0xefd:
-		case 0xefe:
-		case 0xeff:
-			return 0x6f;
-		case 0x76f:
-		case 0xf6f:
-			return 0x76;
-		case 0x75f:
-		case 0xf5f:
-			return 0x75;
-		case 0x3f6:
-		case 0x3f9:
-		case 0xbf6:
-		case 0xbf9:
-			return 0x30;
-		case 0x73f:
-		case 0xf3f:
-			return 0x73;
-		case 0x779:
-		case 0x77a:
-		case 0x77c:
-		case 0x7ad:
-		case 0x7ae:
-		case 0x7b3:
-		case 0x7b5:
-		case 0x7b6:
-		case 0x7b9:
-		case 0x7ba:
-		case 0x7c7:
-		case 0x7cb:
-		case 0x7cd:
-		case 0x7ce:
-		case 0x7d3:
-		case 0x7d5:
-		case 0x7d6:
-		case 0x7d9:
-		case 0x7f0:
-		case 0xf79:
-		case 0xf7a:
-		case 0xf7c:
-		case 0xfad:
-		case 0xfae:
-		case 0xfb3:
-		case 0xfb5:
-		case 0xfb6:
-		case 0xfb9:
-		case 0xfba:
-		case 0xfc7:
-		case 0xfcb:
-		case 0xfcd:
-		case 0xfce:
-		case 0xfd3:
-		case 0xfd5:
-		case 0xfd6:
-		case 0xfd9:
-		case 0xff0:
-			return 0x70;
-		case 0x3fa:
-		case 0xbfa:
-			return 0x38;
-		case 0x37f:
-		case 0xb7f:
-			return 0x37;
-		case 0x57f:
-		case 0xd7f:
-			return 0x57;
-		case 0x79f:
-		case 0xf9f:
-			return 0x79;
-		case 0x7bc:
-		case 0x7da:
-		case 0x7dc:
-		case 0x7e3:
-		case 0x7e5:
-		case 0x7e6:
-		case 0x7e9:
-		case 0x7ea:
-		case 0xfbc:
-		case 0xfda:
-		case 0xfdc:
-		case 0xfe3:
-		case 0xfe5:
-		case 0xfe6:
-		case 0xfe9:
-		case 0xfea:
-			return 0x78;
-		case 0x777:
-		case 0x77b:
-		case 0x77d:
-		case 0x77e:
-		case 0x77f:
-		case 0xf77:
-		case 0xf7b:
-		case 0xf7d:
-		case 0xf7e:
-		case 0xf7f:
-			return 0x77;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave6581_P_Tresolve(reg12 output) {
-	switch (output) {
-		case 0x4ff:
-		case 0xb00:
-			return 0x9f;
-		case 0x6be:
-		case 0x6dd:
-		case 0x6de:
-		case 0x6e7:
-		case 0x6eb:
-		case 0x6ed:
-		case 0x6f3:
-		case 0x912:
-		case 0x914:
-		case 0x918:
-		case 0x921:
-		case 0x922:
-		case 0x941:
-			return 0xd0;
-		case 0x6ee:
-		case 0x6f5:
-		case 0x6f6:
-		case 0x6f9:
-		case 0x906:
-		case 0x909:
-		case 0x90a:
-		case 0x90c:
-		case 0x911:
-			return 0xd8;
-		case 0x6bf:
-		case 0x940:
-			return 0xd7;
-		case 0x2ff:
-		case 0xd00:
-			return 0x5f;
-		case 0x7f2:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f5:
-		case 0x7f6:
-		case 0x7f7:
-		case 0x7f8:
-		case 0x807:
-		case 0x808:
-		case 0x809:
-		case 0x80a:
-		case 0x80b:
-		case 0x80c:
-		case 0x80d:
-			return 0xfe;
-		case 0x1fd:
-			return 0x20;
-		case 0x7eb:
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-		case 0x810:
-		case 0x811:
-		case 0x812:
-		case 0x814:
-			return 0xfd;
-		case 0x7e6:
-		case 0x7e7:
-		case 0x7e9:
-		case 0x7ea:
-		case 0x7ec:
-		case 0x7f1:
-		case 0x80e:
-		case 0x813:
-		case 0x815:
-		case 0x816:
-		case 0x818:
-		case 0x819:
-		case 0x81a:
-			return 0xfc;
-		case 0x7db:
-		case 0x7dd:
-		case 0x7de:
-		case 0x7df:
-		case 0x820:
-		case 0x821:
-		case 0x822:
-		case 0x824:
-			return 0xfb;
-		case 0x7d7:
-		case 0x828:
-			return 0xfa;
-		case 0x37b:
-		case 0x37d:
-		case 0x37e:
-		case 0x3af:
-		case 0x3b7:
-		case 0x3bb:
-		case 0x3bd:
-		case 0x3cf:
-		case 0x3d7:
-		case 0x3ec:
-		case 0x3f2:
-		case 0x3f4:
-		case 0xc0b:
-		case 0xc0d:
-		case 0xc0e:
-		case 0xc13:
-		case 0xc28:
-		case 0xc30:
-		case 0xc44:
-		case 0xc48:
-		case 0xc50:
-		case 0xc81:
-		case 0xc82:
-		case 0xc84:
-			return 0x60;
-		case 0x5fb:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x5ff:
-		case 0xa00:
-		case 0xa01:
-		case 0xa02:
-		case 0xa04:
-			return 0xbf;
-		case 0x5f7:
-		case 0x5fc:
-		case 0xa03:
-		case 0xa08:
-			return 0xbe;
-		case 0x5ef:
-		case 0xa10:
-			return 0xbd;
-		case 0x5fa:
-		case 0xa05:
-		case 0xa06:
-		case 0xa09:
-			return 0xbc;
-		case 0x5df:
-		case 0xa20:
-			return 0xbb;
-		case 0x7f9:
-		case 0x7fa:
-		case 0x7fb:
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-		case 0x7ff:
-		case 0x800:
-		case 0x801:
-		case 0x802:
-		case 0x803:
-		case 0x804:
-		case 0x805:
-		case 0x806:
-			return 0xff;
-		case 0x57d:
-		case 0x57e:
-		case 0x5b7:
-		case 0x5bb:
-		case 0x5bd:
-		case 0x5cf:
-		case 0x5d7:
-		case 0x5db:
-		case 0x5f4:
-		case 0x5f8:
-		case 0xa07:
-		case 0xa0b:
-		case 0xa0d:
-		case 0xa24:
-		case 0xa28:
-		case 0xa30:
-		case 0xa42:
-		case 0xa44:
-		case 0xa48:
-		case 0xa81:
-		case 0xa82:
-			return 0xa0;
-		case 0x71f:
-		case 0x72f:
-		case 0x737:
-		case 0x73b:
-		case 0x73d:
-		case 0x73e:
-		case 0x74f:
-		case 0x757:
-		case 0x75b:
-		case 0x75c:
-		case 0x75d:
-		case 0x75e:
-		case 0x767:
-		case 0x769:
-		case 0x76a:
-		case 0x76b:
-		case 0x76c:
-		case 0x76d:
-		case 0x76e:
-		case 0x771:
-		case 0x772:
-		case 0x773:
-		case 0x774:
-		case 0x778:
-		case 0x795:
-		case 0x796:
-		case 0x799:
-		case 0x79a:
-		case 0x79c:
-		case 0x7a3:
-		case 0x7a5:
-		case 0x7a6:
-		case 0x7a9:
-		case 0x7aa:
-		case 0x7ac:
-		case 0x7b0:
-		case 0x7b1:
-		case 0x7b2:
-		case 0x7c3:
-		case 0x7c4:
-		case 0x7c5:
-		case 0x7c6:
-		case 0x7c8:
-		case 0x7c9:
-		case 0x7ca:
-		case 0x7d0:
-		case 0x7e0:
-		case 0x81f:
-		case 0x82f:
-		case 0x836:
-		case 0x837:
-		case 0x839:
-		case 0x83a:
-		case 0x83b:
-		case 0x83c:
-		case 0x84d:
-		case 0x84e:
-		case 0x84f:
-		case 0x853:
-		case 0x855:
-		case 0x856:
-		case 0x859:
-		case 0x85a:
-		case 0x85c:
-		case 0x863:
-		case 0x865:
-		case 0x866:
-		case 0x869:
-		case 0x86a:
-		case 0x871:
-		case 0x887:
-		case 0x88b:
-		case 0x88c:
-		case 0x88d:
-		case 0x88e:
-		case 0x892:
-		case 0x893:
-		case 0x894:
-		case 0x895:
-		case 0x896:
-		case 0x898:
-		case 0x899:
-		case 0x8a1:
-		case 0x8a2:
-		case 0x8a3:
-		case 0x8a4:
-		case 0x8a8:
-		case 0x8b0:
-		case 0x8c1:
-		case 0x8c2:
-		case 0x8c4:
-		case 0x8c8:
-		case 0x8d0:
-		case 0x8e0:
-			return 0xe0;
-		case 0x775:
-		case 0x776:
-		case 0x779:
-		case 0x886:
-		case 0x889:
-		case 0x88a:
-		case 0x891:
-			return 0xe8;
-		case 0x73f:
-		case 0x8c0:
-			return 0xe7;
-		case 0x37f:
-		case 0xc80:
-			return 0x6f;
-		case 0xe02:
-			return 0x30;
-		case 0x3be:
-		case 0x3db:
-		case 0x3dd:
-		case 0x3de:
-		case 0x3e7:
-		case 0x3eb:
-		case 0x3ed:
-		case 0x3f8:
-		case 0xc07:
-		case 0xc14:
-		case 0xc18:
-		case 0xc22:
-		case 0xc24:
-		case 0xc41:
-		case 0xc42:
-			return 0x70;
-		case 0x1fe:
-			return 0x38;
-		case 0x67f:
-		case 0x980:
-			return 0xcf;
-		case 0x3ee:
-		case 0x3f3:
-		case 0x3f5:
-		case 0x3f6:
-		case 0xc0a:
-		case 0xc0c:
-		case 0xc11:
-		case 0xc12:
-		case 0xc21:
-			return 0x78;
-		case 0x3bf:
-		case 0xc40:
-			return 0x77;
-		case 0x3fb:
-		case 0x3fd:
-		case 0x3fe:
-		case 0x3ff:
-		case 0xc00:
-		case 0xc01:
-		case 0xc02:
-		case 0xc04:
-			return 0x7f;
-		case 0x7af:
-		case 0x850:
-			return 0xf5;
-		case 0x3f7:
-		case 0x3fc:
-		case 0xc03:
-		case 0xc08:
-			return 0x7e;
-		case 0x5be:
-		case 0x5dd:
-		case 0x5de:
-		case 0x5e7:
-		case 0x5eb:
-		case 0x5ed:
-		case 0xa12:
-		case 0xa14:
-		case 0xa18:
-		case 0xa21:
-		case 0xa22:
-		case 0xa41:
-			return 0xb0;
-		case 0x7ba:
-		case 0x7bc:
-		case 0x843:
-		case 0x845:
-			return 0xf4;
-		case 0x3ef:
-		case 0xc10:
-			return 0x7d;
-		case 0x79f:
-		case 0x860:
-			return 0xf3;
-		case 0x3f9:
-		case 0x3fa:
-		case 0xc05:
-		case 0xc06:
-		case 0xc09:
-			return 0x7c;
-		case 0x3df:
-		case 0xc20:
-			return 0x7b;
-		case 0x78f:
-		case 0x797:
-		case 0x79b:
-		case 0x79d:
-		case 0x79e:
-		case 0x7a7:
-		case 0x7ab:
-		case 0x7ad:
-		case 0x7ae:
-		case 0x7b3:
-		case 0x7b4:
-		case 0x7b5:
-		case 0x7b6:
-		case 0x7b8:
-		case 0x7b9:
-		case 0x7c7:
-		case 0x7cc:
-		case 0x7d1:
-		case 0x7d2:
-		case 0x7d4:
-		case 0x7d8:
-		case 0x7e1:
-		case 0x7e2:
-		case 0x7e4:
-		case 0x81b:
-		case 0x81d:
-		case 0x81e:
-		case 0x827:
-		case 0x82b:
-		case 0x82d:
-		case 0x82e:
-		case 0x833:
-		case 0x835:
-		case 0x838:
-		case 0x846:
-		case 0x847:
-		case 0x849:
-		case 0x84a:
-		case 0x84b:
-		case 0x84c:
-		case 0x851:
-		case 0x852:
-		case 0x854:
-		case 0x858:
-		case 0x861:
-		case 0x862:
-		case 0x864:
-		case 0x868:
-		case 0x870:
-			return 0xf0;
-		case 0xb01:
-			return 0x90;
-		case 0x5ee:
-		case 0x5f3:
-		case 0x5f5:
-		case 0x5f6:
-		case 0x5f9:
-		case 0xa0a:
-		case 0xa0c:
-		case 0xa11:
-			return 0xb8;
-		case 0x5bf:
-		case 0xa40:
-			return 0xb7;
-		case 0x1ff:
-		case 0xe00:
-			return 0x3f;
-		case 0x7cf:
-		case 0x830:
-			return 0xf9;
-		case 0x7cb:
-		case 0x7cd:
-		case 0x7ce:
-		case 0x7d3:
-		case 0x7d5:
-		case 0x7d6:
-		case 0x7d9:
-		case 0x7da:
-		case 0x7dc:
-		case 0x7e3:
-		case 0x7e5:
-		case 0x7e8:
-		case 0x7f0:
-		case 0x80f:
-		case 0x817:
-		case 0x81c:
-		case 0x823:
-		case 0x825:
-		case 0x826:
-		case 0x829:
-		case 0x82a:
-		case 0x82c:
-		case 0x831:
-		case 0x832:
-		case 0x834:
-			return 0xf8;
-		case 0x7bb:
-		case 0x7bd:
-		case 0x7be:
-		case 0x7bf:
-		case 0x840:
-		case 0x841:
-		case 0x842:
-		case 0x844:
-			return 0xf7;
-		case 0x7b7:
-		case 0x848:
-			return 0xf6;
-		case 0xe01:
-			return 0x3c;
-		case 0x6fa:
-		case 0x6fc:
-		case 0x903:
-		case 0x905:
-			return 0xdc;
-		case 0x6df:
-		case 0x920:
-			return 0xdb;
-		case 0x2fb:
-		case 0x2fd:
-		case 0x2fe:
-		case 0x36f:
-		case 0x377:
-		case 0x39f:
-		case 0x3dc:
-		case 0x3e6:
-		case 0x3e9:
-		case 0x3ea:
-		case 0x3f1:
-		case 0xc15:
-		case 0xc16:
-		case 0xc19:
-		case 0xc23:
-		case 0xc25:
-		case 0xc60:
-		case 0xc88:
-		case 0xc90:
-		case 0xd02:
-		case 0xd04:
-		case 0xd08:
-			return 0x40;
-		case 0x47f:
-		case 0x4bf:
-		case 0x4df:
-		case 0x4ef:
-		case 0x4f7:
-		case 0x4fb:
-		case 0x4fc:
-		case 0x4fd:
-		case 0x4fe:
-		case 0x53f:
-		case 0x55f:
-		case 0x56f:
-		case 0x577:
-		case 0x579:
-		case 0x57a:
-		case 0x57b:
-		case 0x57c:
-		case 0x59f:
-		case 0x5ad:
-		case 0x5ae:
-		case 0x5af:
-		case 0x5b3:
-		case 0x5b5:
-		case 0x5b6:
-		case 0x5b9:
-		case 0x5ba:
-		case 0x5bc:
-		case 0x5c7:
-		case 0x5cb:
-		case 0x5cd:
-		case 0x5ce:
-		case 0x5d3:
-		case 0x5d5:
-		case 0x5d6:
-		case 0x5d9:
-		case 0x5da:
-		case 0x5dc:
-		case 0x5e3:
-		case 0x5e4:
-		case 0x5e5:
-		case 0x5e6:
-		case 0x5e8:
-		case 0x5e9:
-		case 0x5ea:
-		case 0x5ec:
-		case 0x5f0:
-		case 0x5f1:
-		case 0x5f2:
-		case 0x65d:
-		case 0x65e:
-		case 0x66b:
-		case 0x66d:
-		case 0x66e:
-		case 0x673:
-		case 0x675:
-		case 0x676:
-		case 0x679:
-		case 0x67a:
-		case 0x68f:
-		case 0x697:
-		case 0x69b:
-		case 0x69d:
-		case 0x69e:
-		case 0x6a7:
-		case 0x6ab:
-		case 0x6ad:
-		case 0x6ae:
-		case 0x6b3:
-		case 0x6b5:
-		case 0x6b8:
-		case 0x6c7:
-		case 0x6cb:
-		case 0x6cc:
-		case 0x6cd:
-		case 0x6d1:
-		case 0x6d2:
-		case 0x6d4:
-		case 0x6d8:
-		case 0x6e1:
-		case 0x6e2:
-		case 0x6e4:
-		case 0x6e8:
-		case 0x70f:
-		case 0x717:
-		case 0x71b:
-		case 0x71c:
-		case 0x727:
-		case 0x729:
-		case 0x72a:
-		case 0x72c:
-		case 0x731:
-		case 0x732:
-		case 0x734:
-		case 0x738:
-		case 0x743:
-		case 0x745:
-		case 0x746:
-		case 0x749:
-		case 0x74a:
-		case 0x74c:
-		case 0x751:
-		case 0x752:
-		case 0x754:
-		case 0x760:
-		case 0x761:
-		case 0x783:
-		case 0x784:
-		case 0x785:
-		case 0x786:
-		case 0x788:
-		case 0x789:
-		case 0x790:
-		case 0x7a0:
-		case 0x85f:
-		case 0x86f:
-		case 0x876:
-		case 0x877:
-		case 0x879:
-		case 0x87a:
-		case 0x87b:
-		case 0x87c:
-		case 0x89e:
-		case 0x89f:
-		case 0x8ab:
-		case 0x8ad:
-		case 0x8ae:
-		case 0x8b3:
-		case 0x8b5:
-		case 0x8b6:
-		case 0x8b9:
-		case 0x8ba:
-		case 0x8bc:
-		case 0x8c7:
-		case 0x8cb:
-		case 0x8cd:
-		case 0x8ce:
-		case 0x8d3:
-		case 0x8d5:
-		case 0x8d6:
-		case 0x8d8:
-		case 0x8d9:
-		case 0x8e3:
-		case 0x8e4:
-		case 0x8e8:
-		case 0x8f0:
-		case 0x917:
-		case 0x91b:
-		case 0x91d:
-		case 0x91e:
-		case 0x927:
-		case 0x92b:
-		case 0x92d:
-		case 0x92e:
-		case 0x932:
-		case 0x933:
-		case 0x934:
-		case 0x938:
-		case 0x947:
-		case 0x94a:
-		case 0x94c:
-		case 0x951:
-		case 0x952:
-		case 0x954:
-		case 0x958:
-		case 0x961:
-		case 0x962:
-		case 0x964:
-		case 0x968:
-		case 0x970:
-		case 0x985:
-		case 0x986:
-		case 0x989:
-		case 0x98a:
-		case 0x98c:
-		case 0x991:
-		case 0x992:
-		case 0x994:
-		case 0x9a1:
-		case 0x9a2:
-		case 0x9c1:
-		case 0xa0e:
-		case 0xa0f:
-		case 0xa13:
-		case 0xa15:
-		case 0xa16:
-		case 0xa17:
-		case 0xa19:
-		case 0xa1a:
-		case 0xa1b:
-		case 0xa1c:
-		case 0xa23:
-		case 0xa25:
-		case 0xa26:
-		case 0xa29:
-		case 0xa2a:
-		case 0xa2c:
-		case 0xa31:
-		case 0xa32:
-		case 0xa34:
-		case 0xa38:
-		case 0xa43:
-		case 0xa45:
-		case 0xa46:
-		case 0xa49:
-		case 0xa4a:
-		case 0xa4c:
-		case 0xa50:
-		case 0xa51:
-		case 0xa52:
-		case 0xa60:
-		case 0xa61:
-		case 0xa83:
-		case 0xa84:
-		case 0xa85:
-		case 0xa86:
-		case 0xa88:
-		case 0xa89:
-		case 0xa90:
-		case 0xaa0:
-		case 0xac0:
-		case 0xb02:
-		case 0xb03:
-		case 0xb04:
-		case 0xb08:
-		case 0xb10:
-		case 0xb20:
-		case 0xb40:
-		case 0xb80:
-			return 0x80;
-		case 0x6fb:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-		case 0x900:
-		case 0x901:
-		case 0x902:
-		case 0x904:
-			return 0xdf;
-		case 0x6f7:
-		case 0x908:
-			return 0xde;
-		case 0x6ef:
-		case 0x910:
-			return 0xdd;
-		case 0x63f:
-		case 0x65f:
-		case 0x66f:
-		case 0x677:
-		case 0x67b:
-		case 0x67c:
-		case 0x67d:
-		case 0x67e:
-		case 0x69f:
-		case 0x6af:
-		case 0x6b6:
-		case 0x6b7:
-		case 0x6b9:
-		case 0x6ba:
-		case 0x6bb:
-		case 0x6bc:
-		case 0x6bd:
-		case 0x6ce:
-		case 0x6cf:
-		case 0x6d3:
-		case 0x6d5:
-		case 0x6d6:
-		case 0x6d7:
-		case 0x6d9:
-		case 0x6da:
-		case 0x6db:
-		case 0x6dc:
-		case 0x6e3:
-		case 0x6e5:
-		case 0x6e6:
-		case 0x6e9:
-		case 0x6ea:
-		case 0x6ec:
-		case 0x6f0:
-		case 0x6f1:
-		case 0x6f2:
-		case 0x6f4:
-		case 0x6f8:
-		case 0x71d:
-		case 0x71e:
-		case 0x72b:
-		case 0x72d:
-		case 0x72e:
-		case 0x733:
-		case 0x735:
-		case 0x736:
-		case 0x739:
-		case 0x73a:
-		case 0x73c:
-		case 0x747:
-		case 0x74b:
-		case 0x74d:
-		case 0x74e:
-		case 0x753:
-		case 0x755:
-		case 0x756:
-		case 0x758:
-		case 0x759:
-		case 0x75a:
-		case 0x762:
-		case 0x763:
-		case 0x764:
-		case 0x765:
-		case 0x766:
-		case 0x768:
-		case 0x770:
-		case 0x787:
-		case 0x78a:
-		case 0x78b:
-		case 0x78c:
-		case 0x78d:
-		case 0x78e:
-		case 0x791:
-		case 0x792:
-		case 0x793:
-		case 0x794:
-		case 0x798:
-		case 0x7a1:
-		case 0x7a2:
-		case 0x7a4:
-		case 0x7a8:
-		case 0x7c0:
-		case 0x7c1:
-		case 0x7c2:
-		case 0x83d:
-		case 0x83e:
-		case 0x83f:
-		case 0x857:
-		case 0x85b:
-		case 0x85d:
-		case 0x85e:
-		case 0x867:
-		case 0x86b:
-		case 0x86c:
-		case 0x86d:
-		case 0x86e:
-		case 0x872:
-		case 0x873:
-		case 0x874:
-		case 0x875:
-		case 0x878:
-		case 0x88f:
-		case 0x897:
-		case 0x89a:
-		case 0x89b:
-		case 0x89c:
-		case 0x89d:
-		case 0x8a5:
-		case 0x8a6:
-		case 0x8a7:
-		case 0x8a9:
-		case 0x8aa:
-		case 0x8ac:
-		case 0x8b1:
-		case 0x8b2:
-		case 0x8b4:
-		case 0x8b8:
-		case 0x8c3:
-		case 0x8c5:
-		case 0x8c6:
-		case 0x8c9:
-		case 0x8ca:
-		case 0x8cc:
-		case 0x8d1:
-		case 0x8d2:
-		case 0x8d4:
-		case 0x8e1:
-		case 0x8e2:
-		case 0x907:
-		case 0x90b:
-		case 0x90d:
-		case 0x90e:
-		case 0x90f:
-		case 0x913:
-		case 0x915:
-		case 0x916:
-		case 0x919:
-		case 0x91a:
-		case 0x91c:
-		case 0x923:
-		case 0x924:
-		case 0x925:
-		case 0x926:
-		case 0x928:
-		case 0x929:
-		case 0x92a:
-		case 0x92c:
-		case 0x930:
-		case 0x931:
-		case 0x942:
-		case 0x943:
-		case 0x944:
-		case 0x945:
-		case 0x946:
-		case 0x948:
-		case 0x949:
-		case 0x950:
-		case 0x960:
-		case 0x981:
-		case 0x982:
-		case 0x983:
-		case 0x984:
-		case 0x988:
-		case 0x990:
-		case 0x9a0:
-		case 0x9c0:
-			return 0xc0;
-		case 0x76f:
-		case 0x890:
-			return 0xed;
-		case 0x77a:
-		case 0x77c:
-		case 0x883:
-		case 0x885:
-			return 0xec;
-		case 0x75f:
-		case 0x8a0:
-			return 0xeb;
-		case 0x57f:
-		case 0xa80:
-			return 0xaf;
-		case 0xd01:
-			return 0x58;
-		case 0x77b:
-		case 0x77d:
-		case 0x77e:
-		case 0x77f:
-		case 0x880:
-		case 0x881:
-		case 0x882:
-		case 0x884:
-			return 0xef;
-		case 0x777:
-		case 0x888:
-			return 0xee;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave6581__STresolve(reg12 output) {
-	switch (output) {
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-		case 0x7ff:
-		case 0xffc:
-		case 0xffd:
-		case 0xffe:
-		case 0xfff:
-			return 0x7f;
-		case 0x1fc:
-		case 0x1fd:
-		case 0x1fe:
-		case 0x1ff:
-		case 0x5fc:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x9fc:
-		case 0x9fd:
-		case 0x9fe:
-		case 0x9ff:
-		case 0xdfc:
-		case 0xdfd:
-		case 0xdfe:
-			return 0x0f;
-		case 0x1f8:
-		case 0x1f9:
-		case 0x1fa:
-		case 0x1fb:
-		case 0x5f8:
-		case 0x5f9:
-		case 0x5fa:
-		case 0x5fb:
-		case 0x9f8:
-		case 0x9f9:
-		case 0x9fa:
-		case 0x9fb:
-		case 0xdf8:
-		case 0xdf9:
-		case 0xdfa:
-		case 0xdfb:
-			return 0x0e;
-		case 0x3fc:
-		case 0x3fd:
-		case 0x5ff:
-		case 0xbfc:
-		case 0xbfd:
-		case 0xdff:
-			return 0x1f;
-		case 0x3f8:
-		case 0x3f9:
-		case 0x3fa:
-		case 0x3fb:
-		case 0xbf8:
-		case 0xbf9:
-		case 0xbfa:
-		case 0xbfb:
-			return 0x1e;
-		case 0x3fe:
-		case 0x3ff:
-		case 0x7fa:
-		case 0x7fb:
-		case 0xbfe:
-		case 0xbff:
-		case 0xffa:
-		case 0xffb:
-			return 0x3f;
-		case 0x3f0:
-		case 0x3f1:
-		case 0x3f2:
-		case 0x3f3:
-		case 0x3f4:
-		case 0x3f5:
-		case 0x3f6:
-		case 0x3f7:
-		case 0xbf0:
-		case 0xbf1:
-		case 0xbf2:
-		case 0xbf3:
-		case 0xbf4:
-		case 0xbf5:
-		case 0xbf6:
-		case 0xbf7:
-			return 0x1c;
-		case 0x7f8:
-		case 0x7f9:
-		case 0xff8:
-		case 0xff9:
-			return 0x3e;
-		case 0x7f0:
-		case 0x7f1:
-		case 0x7f2:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f5:
-		case 0x7f6:
-		case 0x7f7:
-		case 0xff0:
-		case 0xff1:
-		case 0xff2:
-		case 0xff3:
-		case 0xff4:
-		case 0xff5:
-		case 0xff6:
-		case 0xff7:
-			return 0x3c;
-		case 0xfc:
-		case 0xfd:
-		case 0xfe:
-		case 0xff:
-		case 0x2fc:
-		case 0x2fd:
-		case 0x2fe:
-		case 0x2ff:
-		case 0x4fc:
-		case 0x4fd:
-		case 0x4fe:
-		case 0x4ff:
-		case 0x6fc:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-		case 0x8fc:
-		case 0x8fd:
-		case 0x8fe:
-		case 0x8ff:
-		case 0xafc:
-		case 0xafd:
-		case 0xafe:
-		case 0xaff:
-		case 0xcfc:
-		case 0xcfd:
-		case 0xcfe:
-		case 0xcff:
-		case 0xefc:
-		case 0xefd:
-		case 0xefe:
-		case 0xeff:
-			return 0x07;
-		case 0x7e0:
-		case 0x7e1:
-		case 0x7e2:
-		case 0x7e3:
-		case 0x7e4:
-		case 0x7e5:
-		case 0x7e6:
-		case 0x7e7:
-		case 0x7e8:
-		case 0x7e9:
-		case 0x7ea:
-		case 0x7eb:
-		case 0x7ec:
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-		case 0xfe0:
-		case 0xfe1:
-		case 0xfe2:
-		case 0xfe3:
-		case 0xfe4:
-		case 0xfe5:
-		case 0xfe6:
-		case 0xfe7:
-		case 0xfe8:
-		case 0xfe9:
-		case 0xfea:
-		case 0xfeb:
-		case 0xfec:
-		case 0xfed:
-		case 0xfee:
-		case 0xfef:
-			return 0x38;
-		case 0x7e:
-		case 0x7f:
-		case 0x17e:
-		case 0x17f:
-		case 0x27e:
-		case 0x27f:
-		case 0x37e:
-		case 0x37f:
-		case 0x47e:
-		case 0x47f:
-		case 0x57e:
-		case 0x57f:
-		case 0x67e:
-		case 0x67f:
-		case 0x77e:
-		case 0x77f:
-		case 0x87e:
-		case 0x87f:
-		case 0x97e:
-		case 0x97f:
-		case 0xa7e:
-		case 0xa7f:
-		case 0xb7e:
-		case 0xb7f:
-		case 0xc7e:
-		case 0xc7f:
-		case 0xd7e:
-		case 0xd7f:
-		case 0xe7e:
-		case 0xe7f:
-		case 0xf7e:
-		case 0xf7f:
-			return 0x03;
-		case 0xbf:
-		case 0x13f:
-		case 0x1bf:
-		case 0x2bf:
-		case 0x33f:
-		case 0x3bf:
-		case 0x4bf:
-		case 0x53f:
-		case 0x5bf:
-		case 0x6bf:
-		case 0x73f:
-		case 0x7bf:
-		case 0x8bf:
-		case 0x93f:
-		case 0x9bf:
-		case 0xabf:
-		case 0xb3f:
-		case 0xbbf:
-		case 0xcbf:
-		case 0xd3f:
-		case 0xdbf:
-		case 0xebf:
-		case 0xf3f:
-		case 0xfbf:
-			return 0x01;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave8580_PSTresolve(reg12 output) {
-	switch (output) {
-		case 0x7fe:
-		case 0x7ff:
-			return 0x7f;
-		case 0x7fc:
-		case 0x7fd:
-			return 0x7e;
-		case 0xf7f:
-			return 0xe3;
-		case 0xdff:
-			return 0x9f;
-		case 0xeee:
-		case 0xeef:
-		case 0xef0:
-		case 0xef1:
-		case 0xef2:
-		case 0xef3:
-		case 0xef4:
-		case 0xef5:
-		case 0xef6:
-		case 0xef7:
-		case 0xef8:
-		case 0xef9:
-		case 0xefa:
-		case 0xefb:
-		case 0xefc:
-		case 0xefd:
-		case 0xefe:
-		case 0xf00:
-		case 0xf01:
-		case 0xf02:
-		case 0xf03:
-		case 0xf04:
-		case 0xf05:
-		case 0xf06:
-		case 0xf07:
-		case 0xf08:
-		case 0xf09:
-		case 0xf0a:
-		case 0xf0b:
-		case 0xf0c:
-		case 0xf0d:
-		case 0xf0e:
-		case 0xf0f:
-		case 0xf10:
-		case 0xf11:
-		case 0xf12:
-		case 0xf13:
-		case 0xf14:
-		case 0xf15:
-		case 0xf16:
-		case 0xf17:
-		case 0xf18:
-		case 0xf19:
-		case 0xf1a:
-		case 0xf1b:
-		case 0xf1c:
-		case 0xf1d:
-		case 0xf1e:
-		case 0xf1f:
-		case 0xf20:
-		case 0xf21:
-		case 0xf22:
-		case 0xf23:
-		case 0xf24:
-		case 0xf25:
-		case 0xf26:
-		case 0xf27:
-		case 0xf28:
-		case 0xf29:
-		case 0xf2a:
-		case 0xf2b:
-		case 0xf2c:
-		case 0xf2d:
-		case 0xf2e:
-		case 0xf2f:
-		case 0xf30:
-		case 0xf31:
-		case 0xf32:
-		case 0xf33:
-		case 0xf34:
-		case 0xf35:
-		case 0xf36:
-		case 0xf37:
-		case 0xf38:
-		case 0xf39:
-		case 0xf3a:
-		case 0xf3b:
-		case 0xf3c:
-		case 0xf3d:
-		case 0xf3e:
-		case 0xf3f:
-		case 0xf40:
-		case 0xf41:
-		case 0xf42:
-		case 0xf43:
-		case 0xf44:
-		case 0xf45:
-		case 0xf46:
-		case 0xf47:
-		case 0xf48:
-		case 0xf49:
-		case 0xf4a:
-		case 0xf4b:
-		case 0xf4c:
-		case 0xf4d:
-		case 0xf4e:
-		case 0xf4f:
-		case 0xf50:
-		case 0xf51:
-		case 0xf52:
-		case 0xf53:
-		case 0xf54:
-		case 0xf55:
-		case 0xf56:
-		case 0xf57:
-		case 0xf58:
-		case 0xf59:
-		case 0xf5a:
-		case 0xf5b:
-		case 0xf5c:
-		case 0xf5d:
-		case 0xf5e:
-		case 0xf5f:
-		case 0xf60:
-		case 0xf61:
-		case 0xf62:
-		case 0xf63:
-		case 0xf64:
-		case 0xf65:
-		case 0xf66:
-		case 0xf67:
-		case 0xf68:
-		case 0xf69:
-		case 0xf6a:
-		case 0xf6b:
-		case 0xf6c:
-		case 0xf6d:
-		case 0xf6e:
-		case 0xf70:
-		case 0xf71:
-		case 0xf72:
-		case 0xf73:
-			return 0xc0;
-		case 0x7fa:
-		case 0x7fb:
-			return 0x7c;
-		case 0xdfe:
-			return 0x8c;
-		case 0xf6f:
-		case 0xf74:
-		case 0xf75:
-		case 0xf76:
-		case 0xf77:
-		case 0xf78:
-		case 0xf79:
-		case 0xf7a:
-		case 0xf7b:
-		case 0xf7c:
-		case 0xf7d:
-		case 0xf7e:
-		case 0xf80:
-		case 0xf81:
-		case 0xf82:
-		case 0xf83:
-		case 0xf84:
-		case 0xf85:
-		case 0xf86:
-		case 0xf87:
-		case 0xf88:
-		case 0xf89:
-		case 0xf8a:
-		case 0xf8b:
-		case 0xf8c:
-		case 0xf8d:
-		case 0xf8e:
-		case 0xf8f:
-		case 0xf90:
-		case 0xf91:
-		case 0xf92:
-		case 0xf93:
-		case 0xf94:
-		case 0xf95:
-		case 0xf96:
-		case 0xf97:
-		case 0xf98:
-		case 0xf99:
-		case 0xf9a:
-		case 0xf9b:
-		case 0xf9c:
-		case 0xf9d:
-		case 0xf9e:
-		case 0xf9f:
-		case 0xfa0:
-		case 0xfa1:
-		case 0xfa2:
-		case 0xfa3:
-		case 0xfa4:
-		case 0xfa5:
-		case 0xfa6:
-		case 0xfa7:
-		case 0xfa8:
-		case 0xfa9:
-		case 0xfaa:
-		case 0xfab:
-		case 0xfac:
-		case 0xfad:
-		case 0xfae:
-		case 0xfaf:
-		case 0xfb0:
-		case 0xfb1:
-		case 0xfb2:
-		case 0xfb3:
-		case 0xfb4:
-		case 0xfb5:
-			return 0xe0;
-		case 0xfb6:
-		case 0xfb7:
-		case 0xfb8:
-		case 0xfb9:
-		case 0xfba:
-		case 0xfbb:
-		case 0xfbc:
-		case 0xfbd:
-		case 0xfbe:
-		case 0xfbf:
-		case 0xfc0:
-		case 0xfc1:
-		case 0xfc2:
-		case 0xfc3:
-		case 0xfc4:
-		case 0xfc5:
-		case 0xfc6:
-		case 0xfc7:
-		case 0xfc8:
-		case 0xfc9:
-		case 0xfca:
-		case 0xfcb:
-		case 0xfcc:
-		case 0xfcd:
-		case 0xfce:
-		case 0xfcf:
-		case 0xfd0:
-		case 0xfd1:
-		case 0xfd2:
-		case 0xfd3:
-		case 0xfd4:
-		case 0xfd5:
-		case 0xfd6:
-		case 0xfd7:
-		case 0xfd8:
-		case 0xfd9:
-			return 0xf0;
-		case 0xbfd:
-			return 0x08;
-		case 0x3ff:
-			return 0x1f;
-		case 0xbfe:
-			return 0x1e;
-		case 0xbff:
-			return 0x3f;
-		case 0xfda:
-		case 0xfdb:
-		case 0xfdc:
-		case 0xfdd:
-		case 0xfde:
-		case 0xfdf:
-		case 0xfe0:
-		case 0xfe1:
-		case 0xfe2:
-		case 0xfe3:
-		case 0xfe4:
-		case 0xfe5:
-		case 0xfe6:
-		case 0xfe7:
-		case 0xfe8:
-		case 0xfe9:
-		case 0xfea:
-			return 0xf8;
-		case 0xff5:
-		case 0xff6:
-		case 0xff7:
-		case 0xff8:
-			return 0xfe;
-		case 0x7ee:
-		case 0x7f1:
-			return 0x20;
-		case 0xfeb:
-		case 0xfec:
-		case 0xfed:
-		case 0xfee:
-		case 0xfef:
-		case 0xff0:
-		case 0xff1:
-		case 0xff2:
-		case 0xff3:
-		case 0xff4:
-			return 0xfc;
-		case 0x7f0:
-			return 0x60;
-		case 0x7ef:
-		case 0x7f2:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f5:
-		case 0x7f6:
-			return 0x70;
-		case 0xdf7:
-		case 0xdf8:
-		case 0xdf9:
-		case 0xdfa:
-		case 0xdfb:
-		case 0xdfc:
-		case 0xdfd:
-		case 0xe3e:
-		case 0xe3f:
-		case 0xe5e:
-		case 0xe5f:
-		case 0xe66:
-		case 0xe6a:
-		case 0xe6b:
-		case 0xe6c:
-		case 0xe6d:
-		case 0xe6e:
-		case 0xe6f:
-		case 0xe70:
-		case 0xe71:
-		case 0xe72:
-		case 0xe73:
-		case 0xe74:
-		case 0xe75:
-		case 0xe76:
-		case 0xe77:
-		case 0xe78:
-		case 0xe79:
-		case 0xe7a:
-		case 0xe7b:
-		case 0xe7c:
-		case 0xe7d:
-		case 0xe7e:
-		case 0xe7f:
-		case 0xe82:
-		case 0xe85:
-		case 0xe86:
-		case 0xe87:
-		case 0xe88:
-		case 0xe8a:
-		case 0xe8b:
-		case 0xe8c:
-		case 0xe8d:
-		case 0xe8e:
-		case 0xe8f:
-		case 0xe90:
-		case 0xe91:
-		case 0xe92:
-		case 0xe93:
-		case 0xe94:
-		case 0xe95:
-		case 0xe96:
-		case 0xe97:
-		case 0xe98:
-		case 0xe99:
-		case 0xe9a:
-		case 0xe9b:
-		case 0xe9c:
-		case 0xe9d:
-		case 0xe9e:
-		case 0xe9f:
-		case 0xea0:
-		case 0xea1:
-		case 0xea2:
-		case 0xea3:
-		case 0xea4:
-		case 0xea5:
-		case 0xea6:
-		case 0xea7:
-		case 0xea8:
-		case 0xea9:
-		case 0xeaa:
-		case 0xeab:
-		case 0xeac:
-		case 0xead:
-		case 0xeae:
-		case 0xeaf:
-		case 0xeb0:
-		case 0xeb1:
-		case 0xeb2:
-		case 0xeb3:
-		case 0xeb4:
-		case 0xeb5:
-		case 0xeb6:
-		case 0xeb7:
-		case 0xeb8:
-		case 0xeb9:
-		case 0xeba:
-		case 0xebb:
-		case 0xebc:
-		case 0xebd:
-		case 0xebe:
-		case 0xebf:
-		case 0xec0:
-		case 0xec1:
-		case 0xec2:
-		case 0xec3:
-		case 0xec4:
-		case 0xec5:
-		case 0xec6:
-		case 0xec7:
-		case 0xec8:
-		case 0xec9:
-		case 0xeca:
-		case 0xecb:
-		case 0xecc:
-		case 0xecd:
-		case 0xece:
-		case 0xecf:
-		case 0xed0:
-		case 0xed1:
-		case 0xed2:
-		case 0xed3:
-		case 0xed4:
-		case 0xed5:
-		case 0xed6:
-		case 0xed7:
-		case 0xed8:
-		case 0xed9:
-		case 0xeda:
-		case 0xedb:
-		case 0xedc:
-		case 0xedd:
-		case 0xede:
-		case 0xedf:
-		case 0xee0:
-		case 0xee1:
-		case 0xee2:
-		case 0xee3:
-		case 0xee4:
-		case 0xee5:
-		case 0xee6:
-		case 0xee7:
-		case 0xee8:
-		case 0xee9:
-		case 0xeea:
-		case 0xeeb:
-		case 0xeec:
-		case 0xeed:
-			return 0x80;
-		case 0xeff:
-			return 0xcf;
-		case 0x7f7:
-		case 0x7f8:
-		case 0x7f9:
-			return 0x78;
-		case 0xff9:
-		case 0xffa:
-		case 0xffb:
-		case 0xffc:
-		case 0xffd:
-		case 0xffe:
-		case 0xfff:
-			return 0xff;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave8580_PS_resolve(reg12 output) {
-	switch (output) {
-		case 0x9fb:
-		case 0x9fd:
-		case 0x9fe:
-		case 0x9ff:
-			return 0x9f;
-		case 0xdaf:
-		case 0xdb7:
-		case 0xdbb:
-		case 0xdbd:
-		case 0xddc:
-		case 0xde3:
-		case 0xde5:
-		case 0xde6:
-		case 0xde8:
-			return 0xd0;
-		case 0x1ff:
-			return 0x1f;
-		case 0x3fc:
-			return 0x1e;
-		case 0xdbe:
-		case 0xdcf:
-		case 0xdd7:
-		case 0xddb:
-		case 0xddd:
-		case 0xdde:
-		case 0xde9:
-		case 0xdea:
-		case 0xdec:
-		case 0xdf0:
-			return 0xd8;
-		case 0xd7f:
-			return 0xd7;
-		case 0x3fa:
-			return 0x1c;
-		case 0x5f7:
-		case 0x5fb:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x5ff:
-			return 0x5f;
-		case 0x5ef:
-			return 0x5e;
-		case 0x6df:
-			return 0x65;
-		case 0xfe2:
-		case 0xfe3:
-		case 0xfe4:
-		case 0xfe5:
-		case 0xfe6:
-		case 0xfe7:
-		case 0xfe8:
-		case 0xfe9:
-		case 0xfea:
-		case 0xfeb:
-		case 0xfec:
-		case 0xfed:
-		case 0xfee:
-		case 0xfef:
-			return 0xfe;
-		case 0xfd7:
-		case 0xfdb:
-		case 0xfdc:
-		case 0xfdd:
-		case 0xfde:
-		case 0xfdf:
-			return 0xfd;
-		case 0x73f:
-			return 0x63;
-		case 0xfc3:
-		case 0xfc5:
-		case 0xfc6:
-		case 0xfc7:
-		case 0xfc8:
-		case 0xfc9:
-		case 0xfca:
-		case 0xfcb:
-		case 0xfcc:
-		case 0xfcd:
-		case 0xfce:
-		case 0xfcf:
-		case 0xfd0:
-		case 0xfd1:
-		case 0xfd2:
-		case 0xfd3:
-		case 0xfd4:
-		case 0xfd5:
-		case 0xfd6:
-		case 0xfd8:
-		case 0xfd9:
-		case 0xfda:
-		case 0xfe0:
-		case 0xfe1:
-			return 0xfc;
-		case 0xfb7:
-		case 0xfbb:
-		case 0xfbc:
-		case 0xfbd:
-		case 0xfbe:
-		case 0xfbf:
-			return 0xfb;
-		case 0x75f:
-			return 0x61;
-		case 0xfaf:
-		case 0xfb9:
-		case 0xfba:
-			return 0xfa;
-		case 0x779:
-		case 0x77a:
-		case 0x77c:
-		case 0x797:
-		case 0x79b:
-		case 0x79d:
-		case 0x79e:
-		case 0x7a7:
-		case 0x7ab:
-		case 0x7ac:
-		case 0x7ad:
-		case 0x7ae:
-		case 0x7b1:
-		case 0x7b2:
-		case 0x7b3:
-		case 0x7b4:
-		case 0x7b5:
-		case 0x7b6:
-		case 0x7b8:
-		case 0x7c0:
-		case 0x7c1:
-		case 0x7c2:
-		case 0x7c3:
-		case 0x7c4:
-		case 0x7c5:
-		case 0x7c6:
-		case 0x7c8:
-		case 0x7c9:
-		case 0x7ca:
-		case 0x7cc:
-		case 0x7d0:
-			return 0x60;
-		case 0xbf7:
-		case 0xbf9:
-		case 0xbfa:
-		case 0xbfb:
-		case 0xbfc:
-		case 0xbfd:
-		case 0xbfe:
-		case 0xbff:
-			return 0xbf;
-		case 0xbee:
-		case 0xbef:
-		case 0xbf3:
-		case 0xbf5:
-		case 0xbf6:
-		case 0xbf8:
-			return 0xbe;
-		case 0xbdf:
-			return 0xbd;
-		case 0xbdd:
-		case 0xbde:
-		case 0xbe7:
-		case 0xbeb:
-		case 0xbed:
-		case 0xbf1:
-		case 0xbf2:
-		case 0xbf4:
-			return 0xbc;
-		case 0x7ff:
-		case 0xff0:
-		case 0xff1:
-		case 0xff2:
-		case 0xff3:
-		case 0xff4:
-		case 0xff5:
-		case 0xff6:
-		case 0xff7:
-		case 0xff8:
-		case 0xff9:
-		case 0xffa:
-		case 0xffb:
-		case 0xffc:
-		case 0xffd:
-		case 0xffe:
-		case 0xfff:
-			return 0xff;
-		case 0xbbf:
-			return 0xbb;
-		case 0x6ef:
-			return 0x6e;
-		case 0xb6f:
-		case 0xb77:
-		case 0xb7b:
-		case 0xbb9:
-		case 0xbba:
-		case 0xbbc:
-		case 0xbc7:
-		case 0xbcb:
-		case 0xbcd:
-		case 0xbce:
-		case 0xbd1:
-		case 0xbd2:
-		case 0xbd3:
-		case 0xbd4:
-		case 0xbd5:
-		case 0xbd6:
-		case 0xbd8:
-		case 0xbe0:
-			return 0xa0;
-		case 0xe3f:
-		case 0xe7e:
-			return 0xe3;
-		case 0xe5f:
-		case 0xe7d:
-			return 0xe1;
-		case 0xe57:
-		case 0xe5b:
-		case 0xe5d:
-		case 0xe5e:
-		case 0xe67:
-		case 0xe6b:
-		case 0xe6c:
-		case 0xe6d:
-		case 0xe6e:
-		case 0xe6f:
-		case 0xe71:
-		case 0xe72:
-		case 0xe73:
-		case 0xe74:
-		case 0xe75:
-		case 0xe76:
-		case 0xe77:
-		case 0xe78:
-		case 0xe79:
-		case 0xe7a:
-		case 0xe7b:
-		case 0xe7c:
-		case 0xe87:
-		case 0xe8b:
-		case 0xe8d:
-		case 0xe8e:
-		case 0xe8f:
-		case 0xe93:
-		case 0xe95:
-		case 0xe96:
-		case 0xe97:
-		case 0xe98:
-		case 0xe99:
-		case 0xe9a:
-		case 0xe9b:
-		case 0xe9c:
-		case 0xe9d:
-		case 0xe9e:
-		case 0xe9f:
-		case 0xea0:
-		case 0xea1:
-		case 0xea2:
-		case 0xea3:
-		case 0xea4:
-		case 0xea5:
-		case 0xea6:
-		case 0xea7:
-		case 0xea8:
-		case 0xea9:
-		case 0xeaa:
-		case 0xeab:
-		case 0xeac:
-		case 0xead:
-		case 0xeae:
-		case 0xeaf:
-		case 0xeb0:
-		case 0xeb1:
-		case 0xeb2:
-		case 0xeb3:
-		case 0xeb4:
-		case 0xeb5:
-		case 0xeb6:
-		case 0xeb7:
-		case 0xeb8:
-		case 0xeb9:
-		case 0xeba:
-		case 0xebb:
-		case 0xebc:
-		case 0xebd:
-		case 0xebe:
-		case 0xec0:
-		case 0xec1:
-		case 0xec2:
-		case 0xec3:
-		case 0xec4:
-		case 0xec5:
-		case 0xec6:
-		case 0xec7:
-		case 0xec8:
-		case 0xec9:
-		case 0xeca:
-		case 0xecb:
-		case 0xecc:
-		case 0xecd:
-		case 0xece:
-		case 0xecf:
-		case 0xed0:
-		case 0xed1:
-		case 0xed2:
-		case 0xed3:
-		case 0xed4:
-		case 0xed5:
-		case 0xed6:
-		case 0xed7:
-		case 0xed8:
-		case 0xed9:
-		case 0xeda:
-		case 0xedc:
-		case 0xee0:
-		case 0xee1:
-		case 0xee2:
-		case 0xee3:
-		case 0xee4:
-		case 0xee5:
-		case 0xee6:
-		case 0xee8:
-		case 0xee9:
-		case 0xeea:
-		case 0xf00:
-		case 0xf01:
-		case 0xf02:
-		case 0xf03:
-		case 0xf04:
-		case 0xf05:
-		case 0xf06:
-		case 0xf07:
-		case 0xf08:
-		case 0xf09:
-		case 0xf0a:
-		case 0xf0b:
-		case 0xf0c:
-		case 0xf0d:
-		case 0xf0e:
-		case 0xf0f:
-		case 0xf10:
-		case 0xf11:
-		case 0xf12:
-		case 0xf13:
-		case 0xf14:
-		case 0xf15:
-		case 0xf16:
-		case 0xf17:
-		case 0xf18:
-		case 0xf19:
-		case 0xf1a:
-		case 0xf1b:
-		case 0xf1c:
-		case 0xf1d:
-		case 0xf1e:
-		case 0xf20:
-		case 0xf21:
-		case 0xf22:
-		case 0xf23:
-		case 0xf24:
-		case 0xf25:
-		case 0xf26:
-		case 0xf28:
-		case 0xf29:
-		case 0xf2a:
-		case 0xf2c:
-		case 0xf30:
-		case 0xf31:
-		case 0xf32:
-		case 0xf40:
-		case 0xf41:
-		case 0xf42:
-			return 0xe0;
-		case 0xedb:
-		case 0xedd:
-		case 0xede:
-		case 0xeec:
-		case 0xef0:
-		case 0xef1:
-		case 0xef2:
-			return 0xe8;
-		case 0xb7d:
-			return 0xa3;
-		case 0xe7f:
-			return 0xe7;
-		case 0x6f7:
-		case 0x6fb:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-			return 0x6f;
-		case 0x76f:
-		case 0x777:
-		case 0x7b9:
-		case 0x7ba:
-		case 0x7bc:
-		case 0x7c7:
-		case 0x7cb:
-		case 0x7cd:
-		case 0x7ce:
-		case 0x7d1:
-		case 0x7d2:
-		case 0x7d3:
-		case 0x7d4:
-		case 0x7d5:
-		case 0x7d6:
-		case 0x7d8:
-		case 0x7e0:
-			return 0x70;
-		case 0xcfd:
-		case 0xcfe:
-		case 0xcff:
-			return 0xcf;
-		case 0x79f:
-		case 0x7bd:
-			return 0x79;
-		case 0x7af:
-		case 0x7b7:
-		case 0x7bb:
-		case 0x7d9:
-		case 0x7da:
-		case 0x7dc:
-		case 0x7e1:
-		case 0x7e2:
-		case 0x7e3:
-		case 0x7e4:
-		case 0x7e5:
-		case 0x7e6:
-		case 0x7e8:
-			return 0x78;
-		case 0x77b:
-		case 0x77d:
-		case 0x77e:
-		case 0x77f:
-			return 0x77;
-		case 0x3bf:
-			return 0x3b;
-		case 0x7f5:
-		case 0x7f6:
-		case 0x7f7:
-		case 0x7f9:
-		case 0x7fa:
-		case 0x7fb:
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-			return 0x7f;
-		case 0xb9f:
-			return 0xb1;
-		case 0xf5f:
-			return 0xf5;
-		case 0x7eb:
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f8:
-			return 0x7e;
-		case 0xbaf:
-		case 0xbb7:
-		case 0xbbb:
-		case 0xbd9:
-		case 0xbda:
-		case 0xbdc:
-		case 0xbe1:
-		case 0xbe2:
-		case 0xbe3:
-		case 0xbe4:
-		case 0xbe8:
-			return 0xb0;
-		case 0xf6d:
-		case 0xf6e:
-		case 0xf73:
-		case 0xf75:
-		case 0xf78:
-			return 0xf4;
-		case 0x7df:
-			return 0x7d;
-		case 0xf3f:
-			return 0xf3;
-		case 0x7cf:
-		case 0x7d7:
-		case 0x7db:
-		case 0x7dd:
-		case 0x7de:
-		case 0x7e7:
-		case 0x7e9:
-		case 0x7ea:
-		case 0x7ec:
-		case 0x7f0:
-		case 0x7f1:
-		case 0x7f2:
-			return 0x7c;
-		case 0x7be:
-		case 0x7bf:
-			return 0x7b;
-		case 0xf1f:
-		case 0xf27:
-		case 0xf2b:
-		case 0xf2d:
-		case 0xf2e:
-		case 0xf2f:
-		case 0xf33:
-		case 0xf34:
-		case 0xf35:
-		case 0xf36:
-		case 0xf37:
-		case 0xf38:
-		case 0xf39:
-		case 0xf3a:
-		case 0xf3b:
-		case 0xf3c:
-		case 0xf3d:
-		case 0xf3e:
-		case 0xf43:
-		case 0xf44:
-		case 0xf45:
-		case 0xf46:
-		case 0xf47:
-		case 0xf48:
-		case 0xf49:
-		case 0xf4a:
-		case 0xf4b:
-		case 0xf4c:
-		case 0xf4d:
-		case 0xf4e:
-		case 0xf4f:
-		case 0xf50:
-		case 0xf51:
-		case 0xf52:
-		case 0xf53:
-		case 0xf54:
-		case 0xf55:
-		case 0xf56:
-		case 0xf57:
-		case 0xf58:
-		case 0xf59:
-		case 0xf5a:
-		case 0xf5b:
-		case 0xf5c:
-		case 0xf5d:
-		case 0xf5e:
-		case 0xf60:
-		case 0xf61:
-		case 0xf62:
-		case 0xf63:
-		case 0xf64:
-		case 0xf65:
-		case 0xf66:
-		case 0xf67:
-		case 0xf68:
-		case 0xf69:
-		case 0xf6a:
-		case 0xf6b:
-		case 0xf6c:
-		case 0xf70:
-		case 0xf71:
-		case 0xf72:
-		case 0xf74:
-		case 0xf80:
-		case 0xf81:
-		case 0xf82:
-		case 0xf83:
-		case 0xf84:
-		case 0xf85:
-		case 0xf86:
-		case 0xf88:
-		case 0xf89:
-		case 0xf8a:
-		case 0xf8b:
-		case 0xf8c:
-		case 0xf90:
-		case 0xf91:
-		case 0xf92:
-		case 0xf94:
-			return 0xf0;
-		case 0xbbe:
-			return 0xb9;
-		case 0xbbd:
-		case 0xbcf:
-		case 0xbd7:
-		case 0xbdb:
-		case 0xbe5:
-		case 0xbe6:
-		case 0xbe9:
-		case 0xbea:
-		case 0xbec:
-		case 0xbf0:
-			return 0xb8;
-		case 0xb7e:
-		case 0xb7f:
-			return 0xb7;
-		case 0x3f7:
-		case 0x3fb:
-		case 0x3fd:
-		case 0x3fe:
-		case 0x3ff:
-			return 0x3f;
-		case 0xf9f:
-			return 0xf9;
-		case 0x3ef:
-			return 0x3e;
-		case 0xf87:
-		case 0xf8d:
-		case 0xf8e:
-		case 0xf8f:
-		case 0xf93:
-		case 0xf95:
-		case 0xf96:
-		case 0xf97:
-		case 0xf98:
-		case 0xf99:
-		case 0xf9a:
-		case 0xf9b:
-		case 0xf9c:
-		case 0xf9d:
-		case 0xf9e:
-		case 0xfa0:
-		case 0xfa1:
-		case 0xfa2:
-		case 0xfa3:
-		case 0xfa4:
-		case 0xfa5:
-		case 0xfa6:
-		case 0xfa7:
-		case 0xfa8:
-		case 0xfa9:
-		case 0xfaa:
-		case 0xfab:
-		case 0xfac:
-		case 0xfad:
-		case 0xfae:
-		case 0xfb0:
-		case 0xfb1:
-		case 0xfb2:
-		case 0xfb3:
-		case 0xfb4:
-		case 0xfb5:
-		case 0xfb6:
-		case 0xfb8:
-		case 0xfc0:
-		case 0xfc1:
-		case 0xfc2:
-		case 0xfc4:
-			return 0xf8;
-		case 0x3df:
-			return 0x3d;
-		case 0xf77:
-		case 0xf7b:
-		case 0xf7c:
-		case 0xf7d:
-		case 0xf7e:
-		case 0xf7f:
-			return 0xf7;
-		case 0xf6f:
-		case 0xf76:
-		case 0xf79:
-		case 0xf7a:
-			return 0xf6;
-		case 0x6bf:
-			return 0x43;
-		case 0x97f:
-		case 0xa7f:
-		case 0xaf7:
-		case 0xafb:
-			return 0x87;
-		case 0xde7:
-		case 0xdeb:
-		case 0xded:
-		case 0xdee:
-		case 0xdf1:
-		case 0xdf2:
-		case 0xdf4:
-			return 0xdc;
-		case 0xdbf:
-			return 0xdb;
-		case 0x6f9:
-		case 0x6fa:
-		case 0x6fc:
-		case 0x75e:
-		case 0x767:
-		case 0x76b:
-		case 0x76d:
-		case 0x76e:
-		case 0x772:
-		case 0x773:
-		case 0x774:
-		case 0x775:
-		case 0x776:
-		case 0x778:
-		case 0x78f:
-		case 0x796:
-		case 0x799:
-		case 0x79a:
-		case 0x79c:
-		case 0x7a1:
-		case 0x7a2:
-		case 0x7a3:
-		case 0x7a4:
-		case 0x7a5:
-		case 0x7a6:
-		case 0x7a8:
-		case 0x7a9:
-		case 0x7aa:
-		case 0x7b0:
-			return 0x40;
-		case 0xaef:
-			return 0x84;
-		case 0x9bf:
-		case 0xabf:
-		case 0xb3f:
-			return 0x83;
-		case 0xadf:
-		case 0xb5f:
-		case 0xc3f:
-			return 0x81;
-		case 0x9de:
-		case 0x9e7:
-		case 0x9eb:
-		case 0x9ed:
-		case 0x9ee:
-		case 0x9f3:
-		case 0x9f4:
-		case 0x9f5:
-		case 0x9f6:
-		case 0x9f8:
-		case 0x9f9:
-		case 0x9fa:
-		case 0x9fc:
-		case 0xa6f:
-		case 0xa77:
-		case 0xa7b:
-		case 0xa7d:
-		case 0xa7e:
-		case 0xa9f:
-		case 0xaaf:
-		case 0xab7:
-		case 0xabb:
-		case 0xabc:
-		case 0xabd:
-		case 0xabe:
-		case 0xacf:
-		case 0xad5:
-		case 0xad6:
-		case 0xad7:
-		case 0xad9:
-		case 0xada:
-		case 0xadb:
-		case 0xadc:
-		case 0xadd:
-		case 0xade:
-		case 0xae0:
-		case 0xae1:
-		case 0xae2:
-		case 0xae3:
-		case 0xae4:
-		case 0xae5:
-		case 0xae6:
-		case 0xae7:
-		case 0xae8:
-		case 0xae9:
-		case 0xaea:
-		case 0xaeb:
-		case 0xaec:
-		case 0xaed:
-		case 0xaee:
-		case 0xaf0:
-		case 0xaf1:
-		case 0xaf2:
-		case 0xaf3:
-		case 0xaf4:
-		case 0xaf5:
-		case 0xaf6:
-		case 0xaf8:
-		case 0xaf9:
-		case 0xafa:
-		case 0xafc:
-		case 0xb0f:
-		case 0xb17:
-		case 0xb1b:
-		case 0xb1c:
-		case 0xb1d:
-		case 0xb1e:
-		case 0xb1f:
-		case 0xb23:
-		case 0xb26:
-		case 0xb27:
-		case 0xb29:
-		case 0xb2a:
-		case 0xb2b:
-		case 0xb2c:
-		case 0xb2d:
-		case 0xb2e:
-		case 0xb2f:
-		case 0xb30:
-		case 0xb31:
-		case 0xb32:
-		case 0xb33:
-		case 0xb34:
-		case 0xb35:
-		case 0xb36:
-		case 0xb37:
-		case 0xb38:
-		case 0xb39:
-		case 0xb3a:
-		case 0xb3b:
-		case 0xb3c:
-		case 0xb3d:
-		case 0xb3e:
-		case 0xb40:
-		case 0xb41:
-		case 0xb42:
-		case 0xb43:
-		case 0xb44:
-		case 0xb45:
-		case 0xb46:
-		case 0xb47:
-		case 0xb48:
-		case 0xb49:
-		case 0xb4a:
-		case 0xb4b:
-		case 0xb4c:
-		case 0xb4d:
-		case 0xb4e:
-		case 0xb4f:
-		case 0xb50:
-		case 0xb51:
-		case 0xb52:
-		case 0xb53:
-		case 0xb54:
-		case 0xb55:
-		case 0xb56:
-		case 0xb57:
-		case 0xb58:
-		case 0xb59:
-		case 0xb5a:
-		case 0xb5b:
-		case 0xb5c:
-		case 0xb5d:
-		case 0xb5e:
-		case 0xb60:
-		case 0xb61:
-		case 0xb62:
-		case 0xb63:
-		case 0xb64:
-		case 0xb65:
-		case 0xb66:
-		case 0xb67:
-		case 0xb68:
-		case 0xb69:
-		case 0xb6a:
-		case 0xb6b:
-		case 0xb6c:
-		case 0xb6d:
-		case 0xb6e:
-		case 0xb70:
-		case 0xb71:
-		case 0xb72:
-		case 0xb73:
-		case 0xb74:
-		case 0xb75:
-		case 0xb76:
-		case 0xb78:
-		case 0xb79:
-		case 0xb7a:
-		case 0xb7c:
-		case 0xb80:
-		case 0xb81:
-		case 0xb82:
-		case 0xb83:
-		case 0xb84:
-		case 0xb85:
-		case 0xb86:
-		case 0xb87:
-		case 0xb88:
-		case 0xb89:
-		case 0xb8a:
-		case 0xb8b:
-		case 0xb8c:
-		case 0xb8d:
-		case 0xb8e:
-		case 0xb8f:
-		case 0xb90:
-		case 0xb91:
-		case 0xb92:
-		case 0xb93:
-		case 0xb94:
-		case 0xb95:
-		case 0xb96:
-		case 0xb97:
-		case 0xb98:
-		case 0xb99:
-		case 0xb9a:
-		case 0xb9b:
-		case 0xb9c:
-		case 0xb9d:
-		case 0xb9e:
-		case 0xba0:
-		case 0xba1:
-		case 0xba2:
-		case 0xba3:
-		case 0xba4:
-		case 0xba5:
-		case 0xba6:
-		case 0xba7:
-		case 0xba8:
-		case 0xba9:
-		case 0xbaa:
-		case 0xbab:
-		case 0xbac:
-		case 0xbad:
-		case 0xbae:
-		case 0xbb0:
-		case 0xbb1:
-		case 0xbb2:
-		case 0xbb3:
-		case 0xbb4:
-		case 0xbb5:
-		case 0xbb6:
-		case 0xbb8:
-		case 0xbc0:
-		case 0xbc1:
-		case 0xbc2:
-		case 0xbc3:
-		case 0xbc4:
-		case 0xbc5:
-		case 0xbc6:
-		case 0xbc8:
-		case 0xbc9:
-		case 0xbca:
-		case 0xbcc:
-		case 0xbd0:
-		case 0xc03:
-		case 0xc07:
-		case 0xc0b:
-		case 0xc0f:
-		case 0xc11:
-		case 0xc12:
-		case 0xc13:
-		case 0xc14:
-		case 0xc15:
-		case 0xc16:
-		case 0xc17:
-		case 0xc19:
-		case 0xc1a:
-		case 0xc1b:
-		case 0xc1c:
-		case 0xc1d:
-		case 0xc1e:
-		case 0xc1f:
-		case 0xc20:
-		case 0xc21:
-		case 0xc22:
-		case 0xc23:
-		case 0xc24:
-		case 0xc25:
-		case 0xc26:
-		case 0xc27:
-		case 0xc28:
-		case 0xc29:
-		case 0xc2a:
-		case 0xc2b:
-		case 0xc2c:
-		case 0xc2d:
-		case 0xc2e:
-		case 0xc2f:
-		case 0xc30:
-		case 0xc31:
-		case 0xc32:
-		case 0xc33:
-		case 0xc34:
-		case 0xc35:
-		case 0xc36:
-		case 0xc37:
-		case 0xc38:
-		case 0xc39:
-		case 0xc3a:
-		case 0xc3b:
-		case 0xc3c:
-		case 0xc3d:
-		case 0xc3e:
-		case 0xc40:
-		case 0xc41:
-		case 0xc42:
-		case 0xc43:
-		case 0xc44:
-		case 0xc45:
-		case 0xc46:
-		case 0xc47:
-		case 0xc48:
-		case 0xc49:
-		case 0xc4a:
-		case 0xc4b:
-		case 0xc4c:
-		case 0xc4d:
-		case 0xc4e:
-		case 0xc4f:
-		case 0xc50:
-		case 0xc51:
-		case 0xc52:
-		case 0xc53:
-		case 0xc54:
-		case 0xc55:
-		case 0xc56:
-		case 0xc57:
-		case 0xc58:
-		case 0xc59:
-		case 0xc5a:
-		case 0xc5b:
-		case 0xc5c:
-		case 0xc5d:
-		case 0xc5e:
-		case 0xc5f:
-		case 0xc60:
-		case 0xc61:
-		case 0xc62:
-		case 0xc63:
-		case 0xc64:
-		case 0xc65:
-		case 0xc66:
-		case 0xc67:
-		case 0xc68:
-		case 0xc69:
-		case 0xc6a:
-		case 0xc6b:
-		case 0xc6c:
-		case 0xc6d:
-		case 0xc6e:
-		case 0xc6f:
-		case 0xc70:
-		case 0xc71:
-		case 0xc72:
-		case 0xc73:
-		case 0xc74:
-		case 0xc75:
-		case 0xc76:
-		case 0xc77:
-		case 0xc78:
-		case 0xc79:
-		case 0xc7a:
-		case 0xc7b:
-		case 0xc7c:
-		case 0xc7d:
-		case 0xc7e:
-		case 0xc80:
-		case 0xc81:
-		case 0xc82:
-		case 0xc83:
-		case 0xc84:
-		case 0xc85:
-		case 0xc86:
-		case 0xc87:
-		case 0xc88:
-		case 0xc89:
-		case 0xc8a:
-		case 0xc8b:
-		case 0xc8c:
-		case 0xc8d:
-		case 0xc8e:
-		case 0xc8f:
-		case 0xc90:
-		case 0xc91:
-		case 0xc92:
-		case 0xc93:
-		case 0xc94:
-		case 0xc95:
-		case 0xc96:
-		case 0xc97:
-		case 0xc98:
-		case 0xc99:
-		case 0xc9a:
-		case 0xc9b:
-		case 0xc9c:
-		case 0xc9d:
-		case 0xc9e:
-		case 0xc9f:
-		case 0xca0:
-		case 0xca1:
-		case 0xca2:
-		case 0xca3:
-		case 0xca4:
-		case 0xca5:
-		case 0xca6:
-		case 0xca7:
-		case 0xca8:
-		case 0xca9:
-		case 0xcaa:
-		case 0xcab:
-		case 0xcac:
-		case 0xcad:
-		case 0xcae:
-		case 0xcaf:
-		case 0xcb0:
-		case 0xcb1:
-		case 0xcb2:
-		case 0xcb3:
-		case 0xcb4:
-		case 0xcb5:
-		case 0xcb6:
-		case 0xcb7:
-		case 0xcb8:
-		case 0xcb9:
-		case 0xcba:
-		case 0xcbb:
-		case 0xcbc:
-		case 0xcbd:
-		case 0xcc0:
-		case 0xcc1:
-		case 0xcc2:
-		case 0xcc3:
-		case 0xcc4:
-		case 0xcc5:
-		case 0xcc6:
-		case 0xcc7:
-		case 0xcc8:
-		case 0xcc9:
-		case 0xcca:
-		case 0xccb:
-		case 0xccc:
-		case 0xccd:
-		case 0xcce:
-		case 0xcd0:
-		case 0xcd1:
-		case 0xcd2:
-		case 0xcd3:
-		case 0xcd4:
-		case 0xcd5:
-		case 0xcd6:
-		case 0xcd8:
-		case 0xcd9:
-		case 0xcda:
-		case 0xcdc:
-		case 0xce0:
-		case 0xce1:
-		case 0xce2:
-		case 0xce3:
-		case 0xce4:
-		case 0xce5:
-		case 0xce6:
-		case 0xce8:
-		case 0xce9:
-		case 0xcea:
-		case 0xd00:
-		case 0xd01:
-		case 0xd02:
-		case 0xd03:
-		case 0xd04:
-		case 0xd05:
-		case 0xd06:
-		case 0xd07:
-		case 0xd08:
-		case 0xd09:
-		case 0xd0a:
-		case 0xd0b:
-		case 0xd0c:
-		case 0xd0d:
-		case 0xd0e:
-		case 0xd0f:
-		case 0xd10:
-		case 0xd11:
-		case 0xd12:
-		case 0xd13:
-		case 0xd14:
-		case 0xd15:
-		case 0xd16:
-		case 0xd17:
-		case 0xd18:
-		case 0xd19:
-		case 0xd1a:
-		case 0xd1b:
-		case 0xd1c:
-		case 0xd1d:
-		case 0xd1e:
-		case 0xd20:
-		case 0xd21:
-		case 0xd22:
-		case 0xd23:
-		case 0xd24:
-		case 0xd25:
-		case 0xd26:
-		case 0xd27:
-		case 0xd28:
-		case 0xd29:
-		case 0xd2a:
-		case 0xd2b:
-		case 0xd2c:
-		case 0xd2d:
-		case 0xd2e:
-		case 0xd30:
-		case 0xd31:
-		case 0xd32:
-		case 0xd33:
-		case 0xd34:
-		case 0xd35:
-		case 0xd38:
-		case 0xd40:
-		case 0xd41:
-		case 0xd42:
-		case 0xd43:
-		case 0xd44:
-		case 0xd45:
-		case 0xd46:
-		case 0xd48:
-		case 0xd49:
-		case 0xd4a:
-		case 0xd4c:
-		case 0xd50:
-			return 0x80;
-		case 0x17f:
-		case 0x1fd:
-		case 0x1fe:
-		case 0x57f:
-			return 0x07;
-		case 0x7f:
-		case 0x1bf:
-		case 0x27f:
-		case 0x2bf:
-		case 0x47f:
-		case 0x87f:
-			return 0x03;
-		case 0x67f:
-			return 0x47;
-		case 0xdf7:
-		case 0xdf9:
-		case 0xdfa:
-		case 0xdfb:
-		case 0xdfc:
-		case 0xdfd:
-		case 0xdfe:
-		case 0xdff:
-			return 0xdf;
-		case 0xbf:
-		case 0x1df:
-		case 0x2df:
-		case 0x2fe:
-		case 0x33f:
-		case 0x4bf:
-		case 0x53f:
-		case 0x63f:
-		case 0x8bf:
-		case 0x93f:
-		case 0xa3f:
-			return 0x01;
-		case 0xdef:
-		case 0xdf3:
-		case 0xdf5:
-		case 0xdf6:
-		case 0xdf8:
-			return 0xde;
-		case 0xddf:
-			return 0xdd;
-		case 0x8ff:
-		case 0x9f7:
-		case 0xafd:
-			return 0x8f;
-		case 0xcdf:
-		case 0xd5f:
-		case 0xd7d:
-			return 0xc1;
-		case 0x9ef:
-			return 0x8e;
-		case 0xcbe:
-		case 0xccf:
-		case 0xcd7:
-		case 0xcdb:
-		case 0xcdd:
-		case 0xcde:
-		case 0xce7:
-		case 0xceb:
-		case 0xcec:
-		case 0xced:
-		case 0xcee:
-		case 0xcef:
-		case 0xcf0:
-		case 0xcf1:
-		case 0xcf2:
-		case 0xcf3:
-		case 0xcf4:
-		case 0xcf5:
-		case 0xcf6:
-		case 0xcf8:
-		case 0xcf9:
-		case 0xcfa:
-		case 0xcfc:
-		case 0xd1f:
-		case 0xd2f:
-		case 0xd36:
-		case 0xd37:
-		case 0xd39:
-		case 0xd3a:
-		case 0xd3b:
-		case 0xd3c:
-		case 0xd3d:
-		case 0xd3e:
-		case 0xd47:
-		case 0xd4b:
-		case 0xd4d:
-		case 0xd4e:
-		case 0xd4f:
-		case 0xd51:
-		case 0xd52:
-		case 0xd53:
-		case 0xd54:
-		case 0xd55:
-		case 0xd56:
-		case 0xd57:
-		case 0xd58:
-		case 0xd59:
-		case 0xd5a:
-		case 0xd5b:
-		case 0xd5c:
-		case 0xd5d:
-		case 0xd5e:
-		case 0xd60:
-		case 0xd61:
-		case 0xd62:
-		case 0xd63:
-		case 0xd64:
-		case 0xd65:
-		case 0xd66:
-		case 0xd67:
-		case 0xd68:
-		case 0xd69:
-		case 0xd6a:
-		case 0xd6b:
-		case 0xd6c:
-		case 0xd6d:
-		case 0xd6e:
-		case 0xd6f:
-		case 0xd70:
-		case 0xd71:
-		case 0xd72:
-		case 0xd73:
-		case 0xd74:
-		case 0xd75:
-		case 0xd76:
-		case 0xd77:
-		case 0xd78:
-		case 0xd79:
-		case 0xd7a:
-		case 0xd7b:
-		case 0xd7c:
-		case 0xd80:
-		case 0xd81:
-		case 0xd82:
-		case 0xd83:
-		case 0xd84:
-		case 0xd85:
-		case 0xd86:
-		case 0xd87:
-		case 0xd88:
-		case 0xd89:
-		case 0xd8a:
-		case 0xd8b:
-		case 0xd8c:
-		case 0xd8d:
-		case 0xd8e:
-		case 0xd8f:
-		case 0xd90:
-		case 0xd91:
-		case 0xd92:
-		case 0xd93:
-		case 0xd94:
-		case 0xd95:
-		case 0xd96:
-		case 0xd97:
-		case 0xd98:
-		case 0xd99:
-		case 0xd9a:
-		case 0xd9b:
-		case 0xd9c:
-		case 0xd9d:
-		case 0xd9e:
-		case 0xd9f:
-		case 0xda0:
-		case 0xda1:
-		case 0xda2:
-		case 0xda3:
-		case 0xda4:
-		case 0xda5:
-		case 0xda6:
-		case 0xda7:
-		case 0xda8:
-		case 0xda9:
-		case 0xdaa:
-		case 0xdab:
-		case 0xdac:
-		case 0xdad:
-		case 0xdae:
-		case 0xdb0:
-		case 0xdb1:
-		case 0xdb2:
-		case 0xdb3:
-		case 0xdb4:
-		case 0xdb5:
-		case 0xdb6:
-		case 0xdb8:
-		case 0xdb9:
-		case 0xdba:
-		case 0xdbc:
-		case 0xdc0:
-		case 0xdc1:
-		case 0xdc2:
-		case 0xdc3:
-		case 0xdc4:
-		case 0xdc5:
-		case 0xdc6:
-		case 0xdc7:
-		case 0xdc8:
-		case 0xdc9:
-		case 0xdca:
-		case 0xdcb:
-		case 0xdcc:
-		case 0xdcd:
-		case 0xdce:
-		case 0xdd0:
-		case 0xdd1:
-		case 0xdd2:
-		case 0xdd3:
-		case 0xdd4:
-		case 0xdd5:
-		case 0xdd6:
-		case 0xdd8:
-		case 0xdd9:
-		case 0xdda:
-		case 0xde0:
-		case 0xde1:
-		case 0xde2:
-		case 0xde4:
-		case 0xe00:
-		case 0xe01:
-		case 0xe02:
-		case 0xe03:
-		case 0xe04:
-		case 0xe05:
-		case 0xe06:
-		case 0xe07:
-		case 0xe08:
-		case 0xe09:
-		case 0xe0a:
-		case 0xe0b:
-		case 0xe0c:
-		case 0xe0d:
-		case 0xe0e:
-		case 0xe0f:
-		case 0xe10:
-		case 0xe11:
-		case 0xe12:
-		case 0xe13:
-		case 0xe14:
-		case 0xe15:
-		case 0xe16:
-		case 0xe17:
-		case 0xe18:
-		case 0xe19:
-		case 0xe1a:
-		case 0xe1b:
-		case 0xe1c:
-		case 0xe1d:
-		case 0xe1e:
-		case 0xe1f:
-		case 0xe20:
-		case 0xe21:
-		case 0xe22:
-		case 0xe23:
-		case 0xe24:
-		case 0xe25:
-		case 0xe26:
-		case 0xe27:
-		case 0xe28:
-		case 0xe29:
-		case 0xe2a:
-		case 0xe2b:
-		case 0xe2c:
-		case 0xe2d:
-		case 0xe2e:
-		case 0xe2f:
-		case 0xe30:
-		case 0xe31:
-		case 0xe32:
-		case 0xe33:
-		case 0xe34:
-		case 0xe35:
-		case 0xe36:
-		case 0xe37:
-		case 0xe38:
-		case 0xe39:
-		case 0xe3a:
-		case 0xe3b:
-		case 0xe3c:
-		case 0xe3d:
-		case 0xe3e:
-		case 0xe40:
-		case 0xe41:
-		case 0xe42:
-		case 0xe43:
-		case 0xe44:
-		case 0xe45:
-		case 0xe46:
-		case 0xe47:
-		case 0xe48:
-		case 0xe49:
-		case 0xe4a:
-		case 0xe4b:
-		case 0xe4c:
-		case 0xe4d:
-		case 0xe4e:
-		case 0xe4f:
-		case 0xe50:
-		case 0xe51:
-		case 0xe52:
-		case 0xe53:
-		case 0xe54:
-		case 0xe55:
-		case 0xe56:
-		case 0xe58:
-		case 0xe59:
-		case 0xe5a:
-		case 0xe5c:
-		case 0xe60:
-		case 0xe61:
-		case 0xe62:
-		case 0xe63:
-		case 0xe64:
-		case 0xe65:
-		case 0xe66:
-		case 0xe68:
-		case 0xe69:
-		case 0xe6a:
-		case 0xe70:
-		case 0xe80:
-		case 0xe81:
-		case 0xe82:
-		case 0xe83:
-		case 0xe84:
-		case 0xe85:
-		case 0xe86:
-		case 0xe88:
-		case 0xe89:
-		case 0xe8a:
-		case 0xe8c:
-		case 0xe90:
-		case 0xe91:
-		case 0xe92:
-		case 0xe94:
-			return 0xc0;
-		case 0x9df:
-			return 0x8d;
-		case 0xff:
-		case 0x2ff:
-		case 0x4ff:
-			return 0x0f;
-		case 0xc7f:
-		case 0xcf7:
-		case 0xcfb:
-		case 0xd7e:
-			return 0xc7;
-		case 0x3f9:
-		case 0x5fc:
-			return 0x0c;
-		case 0x5bf:
-			return 0x0b;
-		case 0x5df:
-			return 0x0a;
-		case 0xcbf:
-		case 0xd3f:
-			return 0xc3;
-		case 0xedf:
-			return 0xed;
-		case 0xee7:
-		case 0xeeb:
-		case 0xeed:
-		case 0xeee:
-		case 0xef3:
-		case 0xef4:
-		case 0xef8:
-			return 0xec;
-		case 0xebf:
-			return 0xeb;
-		case 0x37f:
-			return 0x17;
-		case 0xafe:
-		case 0xaff:
-			return 0xaf;
-		case 0xef7:
-		case 0xef9:
-		case 0xefa:
-		case 0xefb:
-		case 0xefc:
-		case 0xefd:
-		case 0xefe:
-		case 0xeff:
-			return 0xef;
-		case 0xeef:
-		case 0xef5:
-		case 0xef6:
-			return 0xee;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave8580_P_Tresolve(reg12 output) {
-	switch (output) {
-		case 0x4ff:
-		case 0xb00:
-			return 0x9f;
-		case 0x6dd:
-		case 0x6de:
-		case 0x6e7:
-		case 0x6e9:
-		case 0x6ea:
-		case 0x6eb:
-		case 0x6ec:
-		case 0x6f0:
-		case 0x6f1:
-		case 0x90e:
-		case 0x90f:
-		case 0x913:
-		case 0x914:
-		case 0x915:
-		case 0x916:
-		case 0x918:
-		case 0x921:
-		case 0x922:
-			return 0xd0;
-		case 0xb01:
-			return 0x9e;
-		case 0x6df:
-		case 0x920:
-			return 0xd9;
-		case 0x6ed:
-		case 0x6ee:
-		case 0x6f2:
-		case 0x6f3:
-		case 0x6f4:
-		case 0x90b:
-		case 0x90c:
-		case 0x90d:
-		case 0x911:
-		case 0x912:
-			return 0xd8;
-		case 0x6bf:
-		case 0x940:
-			return 0xd7;
-		case 0x1fb:
-		case 0xe04:
-			return 0x1c;
-		case 0x2ff:
-		case 0xd00:
-			return 0x5f;
-		case 0x2fe:
-		case 0xd01:
-			return 0x5e;
-		case 0x7f0:
-		case 0x7f1:
-		case 0x7f2:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f5:
-		case 0x7f6:
-		case 0x7f7:
-		case 0x808:
-		case 0x809:
-		case 0x80a:
-		case 0x80b:
-		case 0x80c:
-		case 0x80d:
-		case 0x80e:
-			return 0xfe;
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-		case 0x810:
-		case 0x811:
-		case 0x812:
-			return 0xfd;
-		case 0xc81:
-			return 0x64;
-		case 0x7e1:
-		case 0x7e2:
-		case 0x7e3:
-		case 0x7e4:
-		case 0x7e5:
-		case 0x7e6:
-		case 0x7e7:
-		case 0x7e8:
-		case 0x7e9:
-		case 0x7ea:
-		case 0x7eb:
-		case 0x7ec:
-		case 0x80f:
-		case 0x813:
-		case 0x814:
-		case 0x815:
-		case 0x816:
-		case 0x817:
-		case 0x818:
-		case 0x819:
-		case 0x81a:
-		case 0x81b:
-		case 0x81c:
-		case 0x81d:
-		case 0x81e:
-			return 0xfc;
-		case 0x7dd:
-		case 0x7de:
-		case 0x7df:
-		case 0x820:
-		case 0x821:
-		case 0x822:
-			return 0xfb;
-		case 0x7db:
-		case 0x7dc:
-		case 0x823:
-		case 0x824:
-			return 0xfa;
-		case 0x37d:
-		case 0x37e:
-		case 0x3b7:
-		case 0x3ba:
-		case 0x3bb:
-		case 0x3bc:
-		case 0x3bd:
-		case 0x3cd:
-		case 0x3ce:
-		case 0x3cf:
-		case 0x3d3:
-		case 0x3d4:
-		case 0x3d5:
-		case 0x3d6:
-		case 0x3d8:
-		case 0x3d9:
-		case 0x3da:
-		case 0x3e0:
-		case 0x3e1:
-		case 0x3e2:
-		case 0x3e4:
-		case 0xc1b:
-		case 0xc1d:
-		case 0xc1e:
-		case 0xc1f:
-		case 0xc25:
-		case 0xc26:
-		case 0xc27:
-		case 0xc29:
-		case 0xc2a:
-		case 0xc2b:
-		case 0xc2c:
-		case 0xc30:
-		case 0xc31:
-		case 0xc32:
-		case 0xc42:
-		case 0xc43:
-		case 0xc44:
-		case 0xc45:
-		case 0xc48:
-		case 0xc82:
-			return 0x60;
-		case 0x5fb:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x5ff:
-		case 0xa00:
-		case 0xa01:
-		case 0xa02:
-		case 0xa04:
-			return 0xbf;
-		case 0x5f7:
-		case 0x5fa:
-		case 0x5fc:
-		case 0xa03:
-		case 0xa05:
-		case 0xa08:
-			return 0xbe;
-		case 0x5ef:
-		case 0x5f5:
-		case 0x5f6:
-		case 0x5f8:
-		case 0x5f9:
-		case 0xa06:
-		case 0xa07:
-		case 0xa09:
-		case 0xa0a:
-		case 0xa10:
-			return 0xbc;
-		case 0x5df:
-		case 0xa20:
-			return 0xbb;
-		case 0x7f8:
-		case 0x7f9:
-		case 0x7fa:
-		case 0x7fb:
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-		case 0x7ff:
-		case 0x800:
-		case 0x801:
-		case 0x802:
-		case 0x803:
-		case 0x804:
-		case 0x805:
-		case 0x806:
-		case 0x807:
-			return 0xff;
-		case 0x5bb:
-		case 0x5bc:
-		case 0x5bd:
-		case 0x5be:
-		case 0x5cf:
-		case 0x5d6:
-		case 0x5d7:
-		case 0x5d8:
-		case 0x5d9:
-		case 0x5da:
-		case 0x5dc:
-		case 0x5e0:
-		case 0x5e1:
-		case 0x5e2:
-		case 0x5e3:
-		case 0x5e4:
-		case 0x5e5:
-		case 0x5e8:
-		case 0xa1a:
-		case 0xa1b:
-		case 0xa1c:
-		case 0xa1d:
-		case 0xa1e:
-		case 0xa1f:
-		case 0xa23:
-		case 0xa25:
-		case 0xa26:
-		case 0xa27:
-		case 0xa28:
-		case 0xa29:
-		case 0xa2a:
-		case 0xa30:
-		case 0xa42:
-		case 0xa43:
-		case 0xa44:
-			return 0xa0;
-		case 0x71b:
-		case 0x71d:
-		case 0x71e:
-		case 0x71f:
-		case 0x727:
-		case 0x72a:
-		case 0x72b:
-		case 0x72c:
-		case 0x72d:
-		case 0x72e:
-		case 0x72f:
-		case 0x730:
-		case 0x731:
-		case 0x732:
-		case 0x733:
-		case 0x734:
-		case 0x735:
-		case 0x736:
-		case 0x737:
-		case 0x738:
-		case 0x739:
-		case 0x73a:
-		case 0x73b:
-		case 0x73c:
-		case 0x73d:
-		case 0x73e:
-		case 0x740:
-		case 0x741:
-		case 0x742:
-		case 0x743:
-		case 0x744:
-		case 0x745:
-		case 0x746:
-		case 0x747:
-		case 0x748:
-		case 0x749:
-		case 0x74a:
-		case 0x74b:
-		case 0x74c:
-		case 0x74d:
-		case 0x74e:
-		case 0x74f:
-		case 0x750:
-		case 0x751:
-		case 0x752:
-		case 0x753:
-		case 0x754:
-		case 0x755:
-		case 0x756:
-		case 0x757:
-		case 0x758:
-		case 0x759:
-		case 0x75a:
-		case 0x75b:
-		case 0x75c:
-		case 0x75d:
-		case 0x75e:
-		case 0x760:
-		case 0x761:
-		case 0x762:
-		case 0x763:
-		case 0x764:
-		case 0x765:
-		case 0x766:
-		case 0x767:
-		case 0x768:
-		case 0x769:
-		case 0x76a:
-		case 0x76b:
-		case 0x76c:
-		case 0x76d:
-		case 0x770:
-		case 0x771:
-		case 0x772:
-		case 0x780:
-		case 0x781:
-		case 0x782:
-		case 0x783:
-		case 0x784:
-		case 0x785:
-		case 0x786:
-		case 0x787:
-		case 0x788:
-		case 0x789:
-		case 0x78a:
-		case 0x78b:
-		case 0x78c:
-		case 0x790:
-		case 0x791:
-		case 0x86e:
-		case 0x86f:
-		case 0x873:
-		case 0x874:
-		case 0x875:
-		case 0x876:
-		case 0x877:
-		case 0x878:
-		case 0x879:
-		case 0x87a:
-		case 0x87b:
-		case 0x87c:
-		case 0x87d:
-		case 0x87e:
-		case 0x87f:
-		case 0x88d:
-		case 0x88e:
-		case 0x88f:
-		case 0x892:
-		case 0x893:
-		case 0x894:
-		case 0x895:
-		case 0x896:
-		case 0x897:
-		case 0x898:
-		case 0x899:
-		case 0x89a:
-		case 0x89b:
-		case 0x89c:
-		case 0x89d:
-		case 0x89e:
-		case 0x89f:
-		case 0x8a1:
-		case 0x8a2:
-		case 0x8a3:
-		case 0x8a4:
-		case 0x8a5:
-		case 0x8a6:
-		case 0x8a7:
-		case 0x8a8:
-		case 0x8a9:
-		case 0x8aa:
-		case 0x8ab:
-		case 0x8ac:
-		case 0x8ad:
-		case 0x8ae:
-		case 0x8af:
-		case 0x8b0:
-		case 0x8b1:
-		case 0x8b2:
-		case 0x8b3:
-		case 0x8b4:
-		case 0x8b5:
-		case 0x8b6:
-		case 0x8b7:
-		case 0x8b8:
-		case 0x8b9:
-		case 0x8ba:
-		case 0x8bb:
-		case 0x8bc:
-		case 0x8bd:
-		case 0x8be:
-		case 0x8bf:
-		case 0x8c1:
-		case 0x8c2:
-		case 0x8c3:
-		case 0x8c4:
-		case 0x8c5:
-		case 0x8c6:
-		case 0x8c7:
-		case 0x8c8:
-		case 0x8c9:
-		case 0x8ca:
-		case 0x8cb:
-		case 0x8cc:
-		case 0x8cd:
-		case 0x8ce:
-		case 0x8cf:
-		case 0x8d0:
-		case 0x8d1:
-		case 0x8d2:
-		case 0x8d3:
-		case 0x8d4:
-		case 0x8d5:
-		case 0x8d8:
-		case 0x8e0:
-		case 0x8e1:
-		case 0x8e2:
-			return 0xe0;
-		case 0x75f:
-		case 0x76e:
-		case 0x773:
-		case 0x774:
-		case 0x775:
-		case 0x887:
-		case 0x88a:
-		case 0x88b:
-		case 0x88c:
-		case 0x891:
-		case 0x8a0:
-			return 0xe8;
-		case 0x73f:
-		case 0x8c0:
-			return 0xe7;
-		case 0x37f:
-		case 0xc80:
-			return 0x6f;
-		case 0x3be:
-		case 0x3d7:
-		case 0x3db:
-		case 0x3dc:
-		case 0x3dd:
-		case 0x3e3:
-		case 0x3e5:
-		case 0x3e6:
-		case 0x3e7:
-		case 0x3e8:
-		case 0x3e9:
-		case 0x3ea:
-		case 0xc15:
-		case 0xc16:
-		case 0xc17:
-		case 0xc19:
-		case 0xc1a:
-		case 0xc1c:
-		case 0xc22:
-		case 0xc23:
-		case 0xc24:
-		case 0xc28:
-		case 0xc41:
-			return 0x70;
-		case 0x67f:
-		case 0x980:
-			return 0xcf;
-		case 0x3de:
-		case 0x3eb:
-		case 0x3ec:
-		case 0x3ed:
-		case 0x3ee:
-		case 0x3f0:
-		case 0x3f1:
-		case 0x3f2:
-		case 0x3f4:
-		case 0xc0b:
-		case 0xc0d:
-		case 0xc0e:
-		case 0xc0f:
-		case 0xc11:
-		case 0xc12:
-		case 0xc13:
-		case 0xc14:
-		case 0xc18:
-		case 0xc21:
-			return 0x78;
-		case 0x3bf:
-		case 0xc40:
-			return 0x77;
-		case 0x3fb:
-		case 0x3fc:
-		case 0x3fd:
-		case 0x3fe:
-		case 0x3ff:
-		case 0xc00:
-		case 0xc01:
-		case 0xc02:
-		case 0xc03:
-		case 0xc04:
-			return 0x7f;
-		case 0x3f7:
-		case 0x3f9:
-		case 0x3fa:
-		case 0xc05:
-		case 0xc06:
-		case 0xc08:
-			return 0x7e;
-		case 0x5db:
-		case 0x5dd:
-		case 0x5de:
-		case 0x5e6:
-		case 0x5e7:
-		case 0x5e9:
-		case 0x5ea:
-		case 0x5ec:
-		case 0x5f0:
-		case 0xa0f:
-		case 0xa13:
-		case 0xa15:
-		case 0xa16:
-		case 0xa17:
-		case 0xa18:
-		case 0xa19:
-		case 0xa21:
-		case 0xa22:
-		case 0xa24:
-		case 0xa41:
-			return 0xb0;
-		case 0x7af:
-		case 0x7b7:
-		case 0x7b9:
-		case 0x7ba:
-		case 0x845:
-		case 0x846:
-		case 0x848:
-		case 0x850:
-			return 0xf4;
-		case 0x3ef:
-		case 0x3f3:
-		case 0x3f5:
-		case 0x3f6:
-		case 0x3f8:
-		case 0xc07:
-		case 0xc09:
-		case 0xc0a:
-		case 0xc0c:
-		case 0xc10:
-			return 0x7c;
-		case 0x3df:
-		case 0xc20:
-			return 0x7b;
-		case 0x78d:
-		case 0x78e:
-		case 0x78f:
-		case 0x792:
-		case 0x793:
-		case 0x794:
-		case 0x795:
-		case 0x796:
-		case 0x797:
-		case 0x798:
-		case 0x799:
-		case 0x79a:
-		case 0x79b:
-		case 0x79c:
-		case 0x79d:
-		case 0x79e:
-		case 0x79f:
-		case 0x7a0:
-		case 0x7a1:
-		case 0x7a2:
-		case 0x7a3:
-		case 0x7a4:
-		case 0x7a5:
-		case 0x7a6:
-		case 0x7a7:
-		case 0x7a8:
-		case 0x7a9:
-		case 0x7aa:
-		case 0x7ab:
-		case 0x7ac:
-		case 0x7ad:
-		case 0x7ae:
-		case 0x7b0:
-		case 0x7b1:
-		case 0x7b2:
-		case 0x7b3:
-		case 0x7b4:
-		case 0x7b5:
-		case 0x7b6:
-		case 0x7b8:
-		case 0x7c0:
-		case 0x7c1:
-		case 0x7c2:
-		case 0x7c4:
-		case 0x83b:
-		case 0x83c:
-		case 0x83d:
-		case 0x83e:
-		case 0x83f:
-		case 0x847:
-		case 0x849:
-		case 0x84a:
-		case 0x84b:
-		case 0x84c:
-		case 0x84d:
-		case 0x84e:
-		case 0x84f:
-		case 0x851:
-		case 0x852:
-		case 0x853:
-		case 0x854:
-		case 0x855:
-		case 0x856:
-		case 0x857:
-		case 0x858:
-		case 0x859:
-		case 0x85a:
-		case 0x85b:
-		case 0x85c:
-		case 0x85d:
-		case 0x85e:
-		case 0x85f:
-		case 0x860:
-		case 0x861:
-		case 0x862:
-		case 0x863:
-		case 0x864:
-		case 0x865:
-		case 0x866:
-		case 0x867:
-		case 0x868:
-		case 0x869:
-		case 0x86a:
-		case 0x86b:
-		case 0x86c:
-		case 0x86d:
-		case 0x870:
-		case 0x871:
-		case 0x872:
-			return 0xf0;
-		case 0x5eb:
-		case 0x5ed:
-		case 0x5ee:
-		case 0x5f1:
-		case 0x5f2:
-		case 0x5f3:
-		case 0x5f4:
-		case 0xa0b:
-		case 0xa0c:
-		case 0xa0d:
-		case 0xa0e:
-		case 0xa11:
-		case 0xa12:
-		case 0xa14:
-			return 0xb8;
-		case 0x5bf:
-		case 0xa40:
-			return 0xb7;
-		case 0x1fe:
-		case 0x1ff:
-		case 0xe00:
-		case 0xe01:
-			return 0x3f;
-		case 0x7c3:
-		case 0x7c5:
-		case 0x7c6:
-		case 0x7c7:
-		case 0x7c8:
-		case 0x7c9:
-		case 0x7ca:
-		case 0x7cb:
-		case 0x7cc:
-		case 0x7cd:
-		case 0x7ce:
-		case 0x7cf:
-		case 0x7d0:
-		case 0x7d1:
-		case 0x7d2:
-		case 0x7d3:
-		case 0x7d4:
-		case 0x7d5:
-		case 0x7d6:
-		case 0x7d7:
-		case 0x7d8:
-		case 0x7d9:
-		case 0x7da:
-		case 0x7e0:
-		case 0x81f:
-		case 0x825:
-		case 0x826:
-		case 0x827:
-		case 0x828:
-		case 0x829:
-		case 0x82a:
-		case 0x82b:
-		case 0x82c:
-		case 0x82d:
-		case 0x82e:
-		case 0x82f:
-		case 0x830:
-		case 0x831:
-		case 0x832:
-		case 0x833:
-		case 0x834:
-		case 0x835:
-		case 0x836:
-		case 0x837:
-		case 0x838:
-		case 0x839:
-		case 0x83a:
-			return 0xf8;
-		case 0xe02:
-			return 0x3e;
-		case 0x7bd:
-		case 0x7be:
-		case 0x7bf:
-		case 0x840:
-		case 0x841:
-		case 0x842:
-			return 0xf7;
-		case 0x1fd:
-			return 0x3c;
-		case 0x7bb:
-		case 0x7bc:
-		case 0x843:
-		case 0x844:
-			return 0xf6;
-		case 0x6ef:
-		case 0x6f5:
-		case 0x6f6:
-		case 0x6f8:
-		case 0x6f9:
-		case 0x906:
-		case 0x907:
-		case 0x909:
-		case 0x90a:
-		case 0x910:
-			return 0xdc;
-		case 0x377:
-		case 0x37b:
-		case 0x37c:
-		case 0x39f:
-		case 0x3ae:
-		case 0x3af:
-		case 0x3b3:
-		case 0x3b4:
-		case 0x3b5:
-		case 0x3b6:
-		case 0x3b8:
-		case 0x3b9:
-		case 0x3c5:
-		case 0x3c6:
-		case 0x3c7:
-		case 0x3c8:
-		case 0x3c9:
-		case 0x3ca:
-		case 0x3cb:
-		case 0x3cc:
-		case 0x3d0:
-		case 0x3d1:
-		case 0x3d2:
-		case 0xc2d:
-		case 0xc2e:
-		case 0xc2f:
-		case 0xc33:
-		case 0xc34:
-		case 0xc35:
-		case 0xc36:
-		case 0xc37:
-		case 0xc38:
-		case 0xc39:
-		case 0xc3a:
-		case 0xc3c:
-		case 0xc46:
-		case 0xc47:
-		case 0xc49:
-		case 0xc4a:
-		case 0xc4b:
-		case 0xc4c:
-		case 0xc50:
-		case 0xc51:
-		case 0xc52:
-		case 0xc60:
-		case 0xc83:
-		case 0xc84:
-		case 0xc88:
-			return 0x40;
-		case 0x47f:
-		case 0x4bd:
-		case 0x4be:
-		case 0x4bf:
-		case 0x4cf:
-		case 0x4d7:
-		case 0x4da:
-		case 0x4db:
-		case 0x4dc:
-		case 0x4dd:
-		case 0x4de:
-		case 0x4df:
-		case 0x4e3:
-		case 0x4e4:
-		case 0x4e5:
-		case 0x4e6:
-		case 0x4e7:
-		case 0x4e8:
-		case 0x4e9:
-		case 0x4ea:
-		case 0x4eb:
-		case 0x4ec:
-		case 0x4ed:
-		case 0x4ee:
-		case 0x4ef:
-		case 0x4f0:
-		case 0x4f1:
-		case 0x4f2:
-		case 0x4f3:
-		case 0x4f4:
-		case 0x4f5:
-		case 0x4f6:
-		case 0x4f7:
-		case 0x4f8:
-		case 0x4f9:
-		case 0x4fa:
-		case 0x4fb:
-		case 0x4fc:
-		case 0x4fd:
-		case 0x51f:
-		case 0x52b:
-		case 0x52d:
-		case 0x52e:
-		case 0x52f:
-		case 0x532:
-		case 0x533:
-		case 0x534:
-		case 0x535:
-		case 0x536:
-		case 0x537:
-		case 0x538:
-		case 0x539:
-		case 0x53a:
-		case 0x53b:
-		case 0x53c:
-		case 0x53d:
-		case 0x53e:
-		case 0x53f:
-		case 0x543:
-		case 0x545:
-		case 0x546:
-		case 0x547:
-		case 0x548:
-		case 0x549:
-		case 0x54a:
-		case 0x54b:
-		case 0x54c:
-		case 0x54d:
-		case 0x54e:
-		case 0x54f:
-		case 0x550:
-		case 0x551:
-		case 0x552:
-		case 0x553:
-		case 0x554:
-		case 0x555:
-		case 0x556:
-		case 0x557:
-		case 0x558:
-		case 0x559:
-		case 0x55a:
-		case 0x55b:
-		case 0x55c:
-		case 0x55d:
-		case 0x55e:
-		case 0x55f:
-		case 0x560:
-		case 0x561:
-		case 0x562:
-		case 0x563:
-		case 0x564:
-		case 0x565:
-		case 0x566:
-		case 0x567:
-		case 0x568:
-		case 0x569:
-		case 0x56a:
-		case 0x56b:
-		case 0x56c:
-		case 0x56d:
-		case 0x56e:
-		case 0x56f:
-		case 0x570:
-		case 0x571:
-		case 0x572:
-		case 0x573:
-		case 0x574:
-		case 0x575:
-		case 0x576:
-		case 0x577:
-		case 0x578:
-		case 0x579:
-		case 0x57a:
-		case 0x57b:
-		case 0x57c:
-		case 0x57d:
-		case 0x57e:
-		case 0x580:
-		case 0x581:
-		case 0x582:
-		case 0x583:
-		case 0x584:
-		case 0x585:
-		case 0x586:
-		case 0x587:
-		case 0x588:
-		case 0x589:
-		case 0x58a:
-		case 0x58b:
-		case 0x58c:
-		case 0x58d:
-		case 0x58e:
-		case 0x58f:
-		case 0x590:
-		case 0x591:
-		case 0x592:
-		case 0x593:
-		case 0x594:
-		case 0x595:
-		case 0x596:
-		case 0x597:
-		case 0x598:
-		case 0x599:
-		case 0x59a:
-		case 0x59b:
-		case 0x59c:
-		case 0x59d:
-		case 0x59e:
-		case 0x59f:
-		case 0x5a0:
-		case 0x5a1:
-		case 0x5a2:
-		case 0x5a3:
-		case 0x5a4:
-		case 0x5a5:
-		case 0x5a6:
-		case 0x5a7:
-		case 0x5a8:
-		case 0x5a9:
-		case 0x5aa:
-		case 0x5ab:
-		case 0x5ac:
-		case 0x5ad:
-		case 0x5ae:
-		case 0x5af:
-		case 0x5b0:
-		case 0x5b1:
-		case 0x5b2:
-		case 0x5b3:
-		case 0x5b4:
-		case 0x5b5:
-		case 0x5b6:
-		case 0x5b7:
-		case 0x5b8:
-		case 0x5b9:
-		case 0x5ba:
-		case 0x5c0:
-		case 0x5c1:
-		case 0x5c2:
-		case 0x5c3:
-		case 0x5c4:
-		case 0x5c5:
-		case 0x5c6:
-		case 0x5c7:
-		case 0x5c8:
-		case 0x5c9:
-		case 0x5ca:
-		case 0x5cb:
-		case 0x5cc:
-		case 0x5cd:
-		case 0x5ce:
-		case 0x5d0:
-		case 0x5d1:
-		case 0x5d2:
-		case 0x5d3:
-		case 0x5d4:
-		case 0x5d5:
-		case 0x600:
-		case 0x601:
-		case 0x602:
-		case 0x603:
-		case 0x604:
-		case 0x605:
-		case 0x606:
-		case 0x607:
-		case 0x608:
-		case 0x609:
-		case 0x60a:
-		case 0x60b:
-		case 0x60c:
-		case 0x60d:
-		case 0x60e:
-		case 0x60f:
-		case 0x610:
-		case 0x611:
-		case 0x612:
-		case 0x613:
-		case 0x614:
-		case 0x615:
-		case 0x616:
-		case 0x617:
-		case 0x618:
-		case 0x619:
-		case 0x61a:
-		case 0x61b:
-		case 0x61c:
-		case 0x61d:
-		case 0x61e:
-		case 0x61f:
-		case 0x620:
-		case 0x621:
-		case 0x622:
-		case 0x623:
-		case 0x624:
-		case 0x625:
-		case 0x626:
-		case 0x627:
-		case 0x628:
-		case 0x629:
-		case 0x62a:
-		case 0x62b:
-		case 0x62c:
-		case 0x62d:
-		case 0x62e:
-		case 0x62f:
-		case 0x630:
-		case 0x631:
-		case 0x632:
-		case 0x633:
-		case 0x634:
-		case 0x635:
-		case 0x636:
-		case 0x637:
-		case 0x638:
-		case 0x639:
-		case 0x63a:
-		case 0x63b:
-		case 0x63c:
-		case 0x63d:
-		case 0x640:
-		case 0x641:
-		case 0x642:
-		case 0x643:
-		case 0x644:
-		case 0x645:
-		case 0x646:
-		case 0x647:
-		case 0x648:
-		case 0x649:
-		case 0x64a:
-		case 0x64b:
-		case 0x64c:
-		case 0x64d:
-		case 0x64e:
-		case 0x64f:
-		case 0x650:
-		case 0x651:
-		case 0x652:
-		case 0x653:
-		case 0x654:
-		case 0x655:
-		case 0x656:
-		case 0x658:
-		case 0x659:
-		case 0x660:
-		case 0x661:
-		case 0x662:
-		case 0x664:
-		case 0x680:
-		case 0x681:
-		case 0x682:
-		case 0x683:
-		case 0x684:
-		case 0x685:
-		case 0x689:
-		case 0x977:
-		case 0x97b:
-		case 0x97c:
-		case 0x97d:
-		case 0x97e:
-		case 0x97f:
-		case 0x99b:
-		case 0x99d:
-		case 0x99e:
-		case 0x99f:
-		case 0x9a6:
-		case 0x9a7:
-		case 0x9a9:
-		case 0x9aa:
-		case 0x9ab:
-		case 0x9ac:
-		case 0x9ad:
-		case 0x9ae:
-		case 0x9af:
-		case 0x9b0:
-		case 0x9b1:
-		case 0x9b2:
-		case 0x9b3:
-		case 0x9b4:
-		case 0x9b5:
-		case 0x9b6:
-		case 0x9b7:
-		case 0x9b8:
-		case 0x9b9:
-		case 0x9ba:
-		case 0x9bb:
-		case 0x9bc:
-		case 0x9bd:
-		case 0x9be:
-		case 0x9bf:
-		case 0x9c3:
-		case 0x9c4:
-		case 0x9c5:
-		case 0x9c6:
-		case 0x9c7:
-		case 0x9c8:
-		case 0x9c9:
-		case 0x9ca:
-		case 0x9cb:
-		case 0x9cc:
-		case 0x9cd:
-		case 0x9ce:
-		case 0x9cf:
-		case 0x9d0:
-		case 0x9d1:
-		case 0x9d2:
-		case 0x9d3:
-		case 0x9d4:
-		case 0x9d5:
-		case 0x9d6:
-		case 0x9d7:
-		case 0x9d8:
-		case 0x9d9:
-		case 0x9da:
-		case 0x9db:
-		case 0x9dc:
-		case 0x9dd:
-		case 0x9de:
-		case 0x9df:
-		case 0x9e0:
-		case 0x9e1:
-		case 0x9e2:
-		case 0x9e3:
-		case 0x9e4:
-		case 0x9e5:
-		case 0x9e6:
-		case 0x9e7:
-		case 0x9e8:
-		case 0x9e9:
-		case 0x9ea:
-		case 0x9eb:
-		case 0x9ec:
-		case 0x9ed:
-		case 0x9ee:
-		case 0x9ef:
-		case 0x9f0:
-		case 0x9f1:
-		case 0x9f2:
-		case 0x9f3:
-		case 0x9f4:
-		case 0x9f5:
-		case 0x9f6:
-		case 0x9f7:
-		case 0x9f8:
-		case 0x9f9:
-		case 0x9fa:
-		case 0x9fb:
-		case 0x9fc:
-		case 0x9fd:
-		case 0x9fe:
-		case 0x9ff:
-		case 0xa2b:
-		case 0xa2c:
-		case 0xa2d:
-		case 0xa2e:
-		case 0xa2f:
-		case 0xa31:
-		case 0xa32:
-		case 0xa33:
-		case 0xa34:
-		case 0xa35:
-		case 0xa36:
-		case 0xa37:
-		case 0xa38:
-		case 0xa39:
-		case 0xa3a:
-		case 0xa3b:
-		case 0xa3c:
-		case 0xa3d:
-		case 0xa3e:
-		case 0xa3f:
-		case 0xa45:
-		case 0xa46:
-		case 0xa47:
-		case 0xa48:
-		case 0xa49:
-		case 0xa4a:
-		case 0xa4b:
-		case 0xa4c:
-		case 0xa4d:
-		case 0xa4e:
-		case 0xa4f:
-		case 0xa50:
-		case 0xa51:
-		case 0xa52:
-		case 0xa53:
-		case 0xa54:
-		case 0xa55:
-		case 0xa56:
-		case 0xa57:
-		case 0xa58:
-		case 0xa59:
-		case 0xa5a:
-		case 0xa5b:
-		case 0xa5c:
-		case 0xa5d:
-		case 0xa5e:
-		case 0xa5f:
-		case 0xa60:
-		case 0xa61:
-		case 0xa62:
-		case 0xa63:
-		case 0xa64:
-		case 0xa65:
-		case 0xa66:
-		case 0xa67:
-		case 0xa68:
-		case 0xa69:
-		case 0xa6a:
-		case 0xa6b:
-		case 0xa6c:
-		case 0xa6d:
-		case 0xa6e:
-		case 0xa6f:
-		case 0xa70:
-		case 0xa71:
-		case 0xa72:
-		case 0xa73:
-		case 0xa74:
-		case 0xa75:
-		case 0xa76:
-		case 0xa77:
-		case 0xa78:
-		case 0xa79:
-		case 0xa7a:
-		case 0xa7b:
-		case 0xa7c:
-		case 0xa7d:
-		case 0xa7e:
-		case 0xa7f:
-		case 0xa81:
-		case 0xa82:
-		case 0xa83:
-		case 0xa84:
-		case 0xa85:
-		case 0xa86:
-		case 0xa87:
-		case 0xa88:
-		case 0xa89:
-		case 0xa8a:
-		case 0xa8b:
-		case 0xa8c:
-		case 0xa8d:
-		case 0xa8e:
-		case 0xa8f:
-		case 0xa90:
-		case 0xa91:
-		case 0xa92:
-		case 0xa93:
-		case 0xa94:
-		case 0xa95:
-		case 0xa96:
-		case 0xa97:
-		case 0xa98:
-		case 0xa99:
-		case 0xa9a:
-		case 0xa9b:
-		case 0xa9c:
-		case 0xa9d:
-		case 0xa9e:
-		case 0xa9f:
-		case 0xaa0:
-		case 0xaa1:
-		case 0xaa2:
-		case 0xaa3:
-		case 0xaa4:
-		case 0xaa5:
-		case 0xaa6:
-		case 0xaa7:
-		case 0xaa8:
-		case 0xaa9:
-		case 0xaaa:
-		case 0xaab:
-		case 0xaac:
-		case 0xaad:
-		case 0xaae:
-		case 0xaaf:
-		case 0xab0:
-		case 0xab1:
-		case 0xab2:
-		case 0xab3:
-		case 0xab4:
-		case 0xab5:
-		case 0xab6:
-		case 0xab7:
-		case 0xab8:
-		case 0xab9:
-		case 0xaba:
-		case 0xabc:
-		case 0xac0:
-		case 0xac1:
-		case 0xac2:
-		case 0xac3:
-		case 0xac4:
-		case 0xac5:
-		case 0xac6:
-		case 0xac7:
-		case 0xac8:
-		case 0xac9:
-		case 0xaca:
-		case 0xacb:
-		case 0xacc:
-		case 0xacd:
-		case 0xad0:
-		case 0xad1:
-		case 0xad4:
-		case 0xae0:
-		case 0xae1:
-		case 0xb03:
-		case 0xb04:
-		case 0xb05:
-		case 0xb06:
-		case 0xb07:
-		case 0xb08:
-		case 0xb09:
-		case 0xb0a:
-		case 0xb0b:
-		case 0xb0c:
-		case 0xb0d:
-		case 0xb0e:
-		case 0xb0f:
-		case 0xb10:
-		case 0xb11:
-		case 0xb12:
-		case 0xb13:
-		case 0xb14:
-		case 0xb15:
-		case 0xb16:
-		case 0xb17:
-		case 0xb18:
-		case 0xb19:
-		case 0xb1a:
-		case 0xb1b:
-		case 0xb1c:
-		case 0xb20:
-		case 0xb21:
-		case 0xb22:
-		case 0xb23:
-		case 0xb24:
-		case 0xb28:
-		case 0xb30:
-		case 0xb40:
-		case 0xb41:
-		case 0xb42:
-		case 0xb44:
-		case 0xb80:
-			return 0x80;
-		case 0xff:
-		case 0xf00:
-			return 0x07;
-		case 0x6fb:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-		case 0x900:
-		case 0x901:
-		case 0x902:
-		case 0x904:
-			return 0xdf;
-		case 0x6f7:
-		case 0x6fa:
-		case 0x6fc:
-		case 0x903:
-		case 0x905:
-		case 0x908:
-			return 0xde;
-		case 0xb02:
-			return 0x88;
-		case 0xd02:
-			return 0x4c;
-		case 0x4fe:
-			return 0x8e;
-		case 0x63e:
-		case 0x63f:
-		case 0x657:
-		case 0x65a:
-		case 0x65b:
-		case 0x65c:
-		case 0x65d:
-		case 0x65e:
-		case 0x65f:
-		case 0x663:
-		case 0x665:
-		case 0x666:
-		case 0x667:
-		case 0x668:
-		case 0x669:
-		case 0x66a:
-		case 0x66b:
-		case 0x66c:
-		case 0x66d:
-		case 0x66e:
-		case 0x66f:
-		case 0x670:
-		case 0x671:
-		case 0x672:
-		case 0x673:
-		case 0x674:
-		case 0x675:
-		case 0x676:
-		case 0x677:
-		case 0x678:
-		case 0x679:
-		case 0x67a:
-		case 0x67b:
-		case 0x67c:
-		case 0x67d:
-		case 0x67e:
-		case 0x686:
-		case 0x687:
-		case 0x688:
-		case 0x68a:
-		case 0x68b:
-		case 0x68c:
-		case 0x68d:
-		case 0x68e:
-		case 0x68f:
-		case 0x690:
-		case 0x691:
-		case 0x692:
-		case 0x693:
-		case 0x694:
-		case 0x695:
-		case 0x696:
-		case 0x697:
-		case 0x698:
-		case 0x699:
-		case 0x69a:
-		case 0x69b:
-		case 0x69c:
-		case 0x69d:
-		case 0x69e:
-		case 0x69f:
-		case 0x6a0:
-		case 0x6a1:
-		case 0x6a2:
-		case 0x6a3:
-		case 0x6a4:
-		case 0x6a5:
-		case 0x6a6:
-		case 0x6a7:
-		case 0x6a8:
-		case 0x6a9:
-		case 0x6aa:
-		case 0x6ab:
-		case 0x6ac:
-		case 0x6ad:
-		case 0x6ae:
-		case 0x6af:
-		case 0x6b0:
-		case 0x6b1:
-		case 0x6b2:
-		case 0x6b3:
-		case 0x6b4:
-		case 0x6b5:
-		case 0x6b6:
-		case 0x6b7:
-		case 0x6b8:
-		case 0x6b9:
-		case 0x6ba:
-		case 0x6bb:
-		case 0x6bc:
-		case 0x6bd:
-		case 0x6be:
-		case 0x6c0:
-		case 0x6c1:
-		case 0x6c2:
-		case 0x6c3:
-		case 0x6c4:
-		case 0x6c5:
-		case 0x6c6:
-		case 0x6c7:
-		case 0x6c8:
-		case 0x6c9:
-		case 0x6ca:
-		case 0x6cb:
-		case 0x6cc:
-		case 0x6cd:
-		case 0x6ce:
-		case 0x6cf:
-		case 0x6d0:
-		case 0x6d1:
-		case 0x6d2:
-		case 0x6d3:
-		case 0x6d4:
-		case 0x6d5:
-		case 0x6d6:
-		case 0x6d7:
-		case 0x6d8:
-		case 0x6d9:
-		case 0x6da:
-		case 0x6db:
-		case 0x6dc:
-		case 0x6e0:
-		case 0x6e1:
-		case 0x6e2:
-		case 0x6e3:
-		case 0x6e4:
-		case 0x6e5:
-		case 0x6e6:
-		case 0x6e8:
-		case 0x700:
-		case 0x701:
-		case 0x702:
-		case 0x703:
-		case 0x704:
-		case 0x705:
-		case 0x706:
-		case 0x707:
-		case 0x708:
-		case 0x709:
-		case 0x70a:
-		case 0x70b:
-		case 0x70c:
-		case 0x70d:
-		case 0x70e:
-		case 0x70f:
-		case 0x710:
-		case 0x711:
-		case 0x712:
-		case 0x713:
-		case 0x714:
-		case 0x715:
-		case 0x716:
-		case 0x717:
-		case 0x718:
-		case 0x719:
-		case 0x71a:
-		case 0x71c:
-		case 0x720:
-		case 0x721:
-		case 0x722:
-		case 0x723:
-		case 0x724:
-		case 0x725:
-		case 0x726:
-		case 0x728:
-		case 0x729:
-		case 0x8d6:
-		case 0x8d7:
-		case 0x8d9:
-		case 0x8da:
-		case 0x8db:
-		case 0x8dc:
-		case 0x8dd:
-		case 0x8de:
-		case 0x8df:
-		case 0x8e3:
-		case 0x8e4:
-		case 0x8e5:
-		case 0x8e6:
-		case 0x8e7:
-		case 0x8e8:
-		case 0x8e9:
-		case 0x8ea:
-		case 0x8eb:
-		case 0x8ec:
-		case 0x8ed:
-		case 0x8ee:
-		case 0x8ef:
-		case 0x8f0:
-		case 0x8f1:
-		case 0x8f2:
-		case 0x8f3:
-		case 0x8f4:
-		case 0x8f5:
-		case 0x8f6:
-		case 0x8f7:
-		case 0x8f8:
-		case 0x8f9:
-		case 0x8fa:
-		case 0x8fb:
-		case 0x8fc:
-		case 0x8fd:
-		case 0x8fe:
-		case 0x8ff:
-		case 0x917:
-		case 0x919:
-		case 0x91a:
-		case 0x91b:
-		case 0x91c:
-		case 0x91d:
-		case 0x91e:
-		case 0x91f:
-		case 0x923:
-		case 0x924:
-		case 0x925:
-		case 0x926:
-		case 0x927:
-		case 0x928:
-		case 0x929:
-		case 0x92a:
-		case 0x92b:
-		case 0x92c:
-		case 0x92d:
-		case 0x92e:
-		case 0x92f:
-		case 0x930:
-		case 0x931:
-		case 0x932:
-		case 0x933:
-		case 0x934:
-		case 0x935:
-		case 0x936:
-		case 0x937:
-		case 0x938:
-		case 0x939:
-		case 0x93a:
-		case 0x93b:
-		case 0x93c:
-		case 0x93d:
-		case 0x93e:
-		case 0x93f:
-		case 0x941:
-		case 0x942:
-		case 0x943:
-		case 0x944:
-		case 0x945:
-		case 0x946:
-		case 0x947:
-		case 0x948:
-		case 0x949:
-		case 0x94a:
-		case 0x94b:
-		case 0x94c:
-		case 0x94d:
-		case 0x94e:
-		case 0x94f:
-		case 0x950:
-		case 0x951:
-		case 0x952:
-		case 0x953:
-		case 0x954:
-		case 0x955:
-		case 0x956:
-		case 0x957:
-		case 0x958:
-		case 0x959:
-		case 0x95a:
-		case 0x95b:
-		case 0x95c:
-		case 0x95d:
-		case 0x95e:
-		case 0x95f:
-		case 0x960:
-		case 0x961:
-		case 0x962:
-		case 0x963:
-		case 0x964:
-		case 0x965:
-		case 0x966:
-		case 0x967:
-		case 0x968:
-		case 0x969:
-		case 0x96a:
-		case 0x96b:
-		case 0x96c:
-		case 0x96d:
-		case 0x96e:
-		case 0x96f:
-		case 0x970:
-		case 0x971:
-		case 0x972:
-		case 0x973:
-		case 0x974:
-		case 0x975:
-		case 0x976:
-		case 0x978:
-		case 0x979:
-		case 0x97a:
-		case 0x981:
-		case 0x982:
-		case 0x983:
-		case 0x984:
-		case 0x985:
-		case 0x986:
-		case 0x987:
-		case 0x988:
-		case 0x989:
-		case 0x98a:
-		case 0x98b:
-		case 0x98c:
-		case 0x98d:
-		case 0x98e:
-		case 0x98f:
-		case 0x990:
-		case 0x991:
-		case 0x992:
-		case 0x993:
-		case 0x994:
-		case 0x995:
-		case 0x996:
-		case 0x997:
-		case 0x998:
-		case 0x999:
-		case 0x99a:
-		case 0x99c:
-		case 0x9a0:
-		case 0x9a1:
-		case 0x9a2:
-		case 0x9a3:
-		case 0x9a4:
-		case 0x9a5:
-		case 0x9a8:
-		case 0x9c0:
-		case 0x9c1:
-		case 0x9c2:
-			return 0xc0;
-		case 0x2fd:
-			return 0x0c;
-		case 0x76f:
-		case 0x776:
-		case 0x778:
-		case 0x779:
-		case 0x77a:
-		case 0x885:
-		case 0x886:
-		case 0x889:
-		case 0x890:
-			return 0xec;
-		case 0x57f:
-		case 0xa80:
-			return 0xaf;
-		case 0x77d:
-		case 0x77e:
-		case 0x77f:
-		case 0x880:
-		case 0x881:
-		case 0x882:
-			return 0xef;
-		case 0x777:
-		case 0x77b:
-		case 0x77c:
-		case 0x883:
-		case 0x884:
-		case 0x888:
-			return 0xee;
-		default:
-			return 0;
-	}
-}
-
-RESID_INLINE
-reg12 wave8580__STresolve(reg12 output) {
-	switch (output) {
-		case 0x7f8:
-		case 0x7f9:
-		case 0x7fa:
-		case 0x7fb:
-		case 0x7fc:
-		case 0x7fd:
-		case 0x7fe:
-		case 0x7ff:
-			return 0x7f;
-		case 0xfbf:
-			return 0xf1;
-		case 0xf80:
-		case 0xf81:
-		case 0xf82:
-		case 0xf83:
-		case 0xf84:
-		case 0xf85:
-		case 0xf86:
-		case 0xf87:
-		case 0xf88:
-		case 0xf89:
-		case 0xf8a:
-		case 0xf8b:
-		case 0xf8c:
-		case 0xf8d:
-		case 0xf8e:
-		case 0xf8f:
-		case 0xf90:
-		case 0xf91:
-		case 0xf92:
-		case 0xf93:
-		case 0xf94:
-		case 0xf95:
-		case 0xf96:
-		case 0xf97:
-		case 0xf98:
-		case 0xf99:
-		case 0xf9a:
-		case 0xf9b:
-		case 0xf9c:
-		case 0xf9d:
-		case 0xf9e:
-		case 0xf9f:
-		case 0xfa0:
-		case 0xfa1:
-		case 0xfa2:
-		case 0xfa3:
-		case 0xfa4:
-		case 0xfa5:
-		case 0xfa6:
-		case 0xfa7:
-		case 0xfa8:
-		case 0xfa9:
-		case 0xfaa:
-		case 0xfab:
-		case 0xfac:
-		case 0xfad:
-		case 0xfae:
-		case 0xfaf:
-		case 0xfb0:
-		case 0xfb1:
-		case 0xfb2:
-		case 0xfb3:
-		case 0xfb4:
-		case 0xfb5:
-		case 0xfb6:
-		case 0xfb7:
-		case 0xfb8:
-		case 0xfb9:
-		case 0xfba:
-		case 0xfbb:
-		case 0xfbc:
-		case 0xfbd:
-		case 0xfbe:
-			return 0xf0;
-		case 0x3fa:
-		case 0x3fb:
-		case 0x3fc:
-		case 0x3fd:
-		case 0x3fe:
-		case 0x3ff:
-		case 0x5ff:
-		case 0xbfa:
-		case 0xbfb:
-		case 0xbfc:
-		case 0xbfd:
-		case 0xdfe:
-		case 0xdff:
-			return 0x1f;
-		case 0x3f8:
-		case 0x3f9:
-		case 0xbf8:
-		case 0xbf9:
-			return 0x1e;
-		case 0xbfe:
-		case 0xbff:
-			return 0x3f;
-		case 0x3f0:
-		case 0x3f1:
-		case 0x3f2:
-		case 0x3f3:
-		case 0x3f4:
-		case 0x3f5:
-		case 0x3f6:
-		case 0x3f7:
-		case 0xbf0:
-		case 0xbf1:
-		case 0xbf2:
-		case 0xbf3:
-		case 0xbf4:
-		case 0xbf5:
-		case 0xbf6:
-		case 0xbf7:
-			return 0x1c;
-		case 0x7f7:
-			return 0x3e;
-		case 0xfc0:
-		case 0xfc1:
-		case 0xfc2:
-		case 0xfc3:
-		case 0xfc4:
-		case 0xfc5:
-		case 0xfc6:
-		case 0xfc7:
-		case 0xfc8:
-		case 0xfc9:
-		case 0xfca:
-		case 0xfcb:
-		case 0xfcc:
-		case 0xfcd:
-		case 0xfce:
-		case 0xfcf:
-		case 0xfd0:
-		case 0xfd1:
-		case 0xfd2:
-		case 0xfd3:
-		case 0xfd4:
-		case 0xfd5:
-		case 0xfd6:
-		case 0xfd7:
-		case 0xfd8:
-		case 0xfd9:
-		case 0xfda:
-		case 0xfdb:
-		case 0xfdc:
-		case 0xfdd:
-		case 0xfde:
-		case 0xfdf:
-			return 0xf8;
-		case 0x7f0:
-		case 0x7f1:
-		case 0x7f2:
-		case 0x7f3:
-		case 0x7f4:
-		case 0x7f5:
-		case 0x7f6:
-			return 0x3c;
-		case 0xefc:
-		case 0xefd:
-		case 0xefe:
-			return 0x87;
-		case 0xff0:
-		case 0xff1:
-		case 0xff2:
-		case 0xff3:
-		case 0xff4:
-		case 0xff5:
-		case 0xff6:
-		case 0xff7:
-			return 0xfe;
-		case 0xfe0:
-		case 0xfe1:
-		case 0xfe2:
-		case 0xfe3:
-		case 0xfe4:
-		case 0xfe5:
-		case 0xfe6:
-		case 0xfe7:
-		case 0xfe8:
-		case 0xfe9:
-		case 0xfea:
-		case 0xfeb:
-		case 0xfec:
-		case 0xfed:
-		case 0xfee:
-		case 0xfef:
-			return 0xfc;
-		case 0xe7e:
-		case 0xe7f:
-			return 0x83;
-		case 0xe7c:
-		case 0xe80:
-		case 0xe81:
-		case 0xe82:
-		case 0xe83:
-		case 0xe84:
-		case 0xe85:
-		case 0xe86:
-		case 0xe87:
-		case 0xe88:
-		case 0xe89:
-		case 0xe8a:
-		case 0xe8b:
-		case 0xe8c:
-		case 0xe8d:
-		case 0xe8e:
-		case 0xe8f:
-		case 0xe90:
-		case 0xe91:
-		case 0xe92:
-		case 0xe93:
-		case 0xe94:
-		case 0xe95:
-		case 0xe96:
-		case 0xe97:
-		case 0xe98:
-		case 0xe99:
-		case 0xe9a:
-		case 0xe9b:
-		case 0xe9c:
-		case 0xe9d:
-		case 0xe9e:
-		case 0xe9f:
-		case 0xea0:
-		case 0xea1:
-		case 0xea2:
-		case 0xea3:
-		case 0xea4:
-		case 0xea5:
-		case 0xea6:
-		case 0xea7:
-		case 0xea8:
-		case 0xea9:
-		case 0xeaa:
-		case 0xeab:
-		case 0xeac:
-		case 0xead:
-		case 0xeae:
-		case 0xeaf:
-		case 0xeb0:
-		case 0xeb1:
-		case 0xeb2:
-		case 0xeb3:
-		case 0xeb4:
-		case 0xeb5:
-		case 0xeb6:
-		case 0xeb7:
-		case 0xeb8:
-		case 0xeb9:
-		case 0xeba:
-		case 0xebb:
-		case 0xebc:
-		case 0xebd:
-		case 0xebe:
-		case 0xebf:
-		case 0xec0:
-		case 0xec1:
-		case 0xec2:
-		case 0xec3:
-		case 0xec4:
-		case 0xec5:
-		case 0xec6:
-		case 0xec7:
-		case 0xec8:
-		case 0xec9:
-		case 0xeca:
-		case 0xecb:
-		case 0xecc:
-		case 0xecd:
-		case 0xece:
-		case 0xecf:
-		case 0xed0:
-		case 0xed1:
-		case 0xed2:
-		case 0xed3:
-		case 0xed4:
-		case 0xed5:
-		case 0xed6:
-		case 0xed7:
-		case 0xed8:
-		case 0xed9:
-		case 0xeda:
-		case 0xedb:
-		case 0xedc:
-		case 0xedd:
-		case 0xede:
-		case 0xedf:
-		case 0xee0:
-		case 0xee1:
-		case 0xee2:
-		case 0xee3:
-		case 0xee4:
-		case 0xee5:
-		case 0xee6:
-		case 0xee7:
-		case 0xee8:
-		case 0xee9:
-		case 0xeea:
-		case 0xeeb:
-		case 0xeec:
-		case 0xeed:
-		case 0xeee:
-		case 0xeef:
-		case 0xef0:
-		case 0xef1:
-		case 0xef2:
-		case 0xef3:
-		case 0xef4:
-		case 0xef5:
-		case 0xef6:
-		case 0xef7:
-		case 0xef8:
-		case 0xef9:
-		case 0xefa:
-		case 0xefb:
-			return 0x80;
-		case 0xfc:
-		case 0xfd:
-		case 0xfe:
-		case 0xff:
-		case 0x2fc:
-		case 0x2fd:
-		case 0x2fe:
-		case 0x2ff:
-		case 0x4fc:
-		case 0x4fd:
-		case 0x4fe:
-		case 0x4ff:
-		case 0x6fc:
-		case 0x6fd:
-		case 0x6fe:
-		case 0x6ff:
-		case 0x8fc:
-		case 0x8fd:
-		case 0x8fe:
-		case 0x8ff:
-		case 0xafc:
-		case 0xafd:
-		case 0xafe:
-		case 0xaff:
-		case 0xcfc:
-		case 0xcfd:
-		case 0xcfe:
-		case 0xcff:
-			return 0x07;
-		case 0x7e:
-		case 0x7f:
-		case 0x17e:
-		case 0x17f:
-		case 0x27e:
-		case 0x27f:
-		case 0x37e:
-		case 0x37f:
-		case 0x47e:
-		case 0x47f:
-		case 0x57e:
-		case 0x57f:
-		case 0x67e:
-		case 0x67f:
-		case 0x77e:
-		case 0x77f:
-		case 0x87e:
-		case 0x87f:
-		case 0x97e:
-		case 0x97f:
-		case 0xa7e:
-		case 0xa7f:
-		case 0xb7e:
-		case 0xb7f:
-		case 0xc7e:
-		case 0xc7f:
-		case 0xd7e:
-		case 0xd7f:
-			return 0x03;
-		case 0x3bf:
-		case 0x7bf:
-		case 0xbbf:
-		case 0xdbf:
-			return 0x01;
-		case 0xff8:
-		case 0xff9:
-		case 0xffa:
-		case 0xffb:
-		case 0xffc:
-		case 0xffd:
-		case 0xffe:
-		case 0xfff:
-			return 0xff;
-		case 0xeff:
-			return 0x8f;
-		case 0xf7e:
-		case 0xf7f:
-			return 0xe3;
-		case 0xf00:
-		case 0xf03:
-		case 0xf04:
-		case 0xf09:
-		case 0xf0a:
-		case 0xf0b:
-		case 0xf0c:
-		case 0xf0d:
-		case 0xf0e:
-		case 0xf0f:
-		case 0xf10:
-		case 0xf13:
-		case 0xf14:
-		case 0xf15:
-		case 0xf16:
-		case 0xf17:
-		case 0xf19:
-		case 0xf1a:
-		case 0xf1b:
-		case 0xf1c:
-		case 0xf1d:
-		case 0xf1e:
-		case 0xf1f:
-		case 0xf20:
-		case 0xf23:
-		case 0xf24:
-		case 0xf2b:
-		case 0xf2d:
-			return 0xc0;
-		case 0xf01:
-		case 0xf02:
-		case 0xf05:
-		case 0xf06:
-		case 0xf07:
-		case 0xf08:
-		case 0xf11:
-		case 0xf12:
-		case 0xf18:
-		case 0xf21:
-		case 0xf22:
-		case 0xf25:
-		case 0xf26:
-		case 0xf27:
-		case 0xf28:
-		case 0xf29:
-		case 0xf2a:
-		case 0xf2c:
-		case 0xf2e:
-		case 0xf2f:
-		case 0xf30:
-		case 0xf31:
-		case 0xf32:
-		case 0xf33:
-		case 0xf34:
-		case 0xf35:
-		case 0xf36:
-		case 0xf37:
-		case 0xf38:
-		case 0xf39:
-		case 0xf3a:
-		case 0xf3b:
-		case 0xf3c:
-		case 0xf3d:
-		case 0xf3e:
-		case 0xf3f:
-		case 0xf40:
-		case 0xf41:
-		case 0xf42:
-		case 0xf43:
-		case 0xf44:
-		case 0xf45:
-		case 0xf46:
-		case 0xf47:
-		case 0xf48:
-		case 0xf49:
-		case 0xf4a:
-		case 0xf4b:
-		case 0xf4c:
-		case 0xf4d:
-		case 0xf4e:
-		case 0xf4f:
-		case 0xf50:
-		case 0xf51:
-		case 0xf52:
-		case 0xf53:
-		case 0xf54:
-		case 0xf55:
-		case 0xf56:
-		case 0xf57:
-		case 0xf58:
-		case 0xf59:
-		case 0xf5a:
-		case 0xf5b:
-		case 0xf5c:
-		case 0xf5d:
-		case 0xf5e:
-		case 0xf5f:
-		case 0xf60:
-		case 0xf61:
-		case 0xf62:
-		case 0xf63:
-		case 0xf64:
-		case 0xf65:
-		case 0xf66:
-		case 0xf67:
-		case 0xf68:
-		case 0xf69:
-		case 0xf6a:
-		case 0xf6b:
-		case 0xf6c:
-		case 0xf6d:
-		case 0xf6e:
-		case 0xf6f:
-		case 0xf70:
-		case 0xf71:
-		case 0xf72:
-		case 0xf73:
-		case 0xf74:
-		case 0xf75:
-		case 0xf76:
-		case 0xf77:
-		case 0xf78:
-		case 0xf79:
-		case 0xf7a:
-		case 0xf7b:
-		case 0xf7c:
-		case 0xf7d:
-			return 0xe0;
-		case 0x1fc:
-		case 0x1fd:
-		case 0x1fe:
-		case 0x1ff:
-		case 0x5fc:
-		case 0x5fd:
-		case 0x5fe:
-		case 0x9fc:
-		case 0x9fd:
-		case 0x9fe:
-		case 0x9ff:
-		case 0xdfc:
-		case 0xdfd:
-			return 0x0f;
-		case 0x1f8:
-		case 0x1f9:
-		case 0x1fa:
-		case 0x1fb:
-		case 0x5f8:
-		case 0x5f9:
-		case 0x5fa:
-		case 0x5fb:
-		case 0x9f8:
-		case 0x9f9:
-		case 0x9fa:
-		case 0x9fb:
-		case 0xdf8:
-		case 0xdf9:
-		case 0xdfa:
-		case 0xdfb:
-			return 0x0e;
-		case 0x7e0:
-		case 0x7e1:
-		case 0x7e2:
-		case 0x7e3:
-		case 0x7e4:
-		case 0x7e5:
-		case 0x7e6:
-		case 0x7e7:
-		case 0x7e8:
-		case 0x7e9:
-		case 0x7ea:
-		case 0x7eb:
-		case 0x7ec:
-		case 0x7ed:
-		case 0x7ee:
-		case 0x7ef:
-			return 0x38;
-		default:
-			return 0;
-	}
-}
-
-
 #endif // RESID_INLINING || defined(__WAVE_CC__)
 
 RESID_NAMESPACE_STOP
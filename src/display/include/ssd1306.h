@@ -74,6 +74,11 @@ typedef struct {
     bool external_vcc;    /**< whether display uses external vcc */
     uint8_t *buffer;    /**< display buffer */
     size_t bufsize;        /**< buffer size */
+    uint8_t *shown;    /**< what the display was last sent, to send only what changed */
+    bool shown_valid;    /**< whether the display is known to hold shown */
+    uint32_t show_count;    /**< frames shown since initialization */
+    size_t show_bytes;    /**< bytes sent over i2c for the last frame */
+    uint64_t show_bytes_total;    /**< bytes sent over i2c since initialization */
 } ssd1306_t;
 
 /**
@@ -128,6 +133,9 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	Only the columns of each page that differ from what was last shown are
+	sent, with neighbouring pages sent as one window where that is cheaper
+
 	@param[in] p : instance of display
 
 */
@@ -284,6 +292,13 @@ void ssd1306_deinit(ssd1306_t *p);
 
 void ssd1306_dump_pbm(ssd1306_t *p);
 
+/**
+	@brief print how many bytes ssd1306_show has sent over i2c per frame
+
+	@param[in] p : instance of display
+*/
+void ssd1306_print_stats(ssd1306_t *p);
+
 #ifdef __cplusplus
 }
 #endif
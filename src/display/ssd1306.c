@@ -39,17 +39,17 @@ inline static void swap(int32_t *a, int32_t *b) {
     *b = *t;
 }
 
-inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
+inline static bool fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
     switch (i2c_write_blocking(i2c, addr, src, len, false)) {
         case PICO_ERROR_GENERIC:
             printf("[%s] addr not acknowledged!\n", name);
-            break;
+            return false;
         case PICO_ERROR_TIMEOUT:
             printf("[%s] timeout!\n", name);
-            break;
+            return false;
         default:
             //printf("[%s] wrote successfully %lu bytes!\n", name, len);
-            break;
+            return true;
     }
 }
 
@@ -75,6 +75,16 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
     ++(p->buffer);
 
+    if ((p->shown = malloc(p->bufsize)) == NULL) {
+        free(p->buffer - 1);
+        p->bufsize = 0;
+        return false;
+    }
+    p->shown_valid = false;
+    p->show_count = 0;
+    p->show_bytes = 0;
+    p->show_bytes_total = 0;
+
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[] = {
         SET_DISP,
@@ -117,6 +127,7 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
 inline void ssd1306_deinit(ssd1306_t *p) {
     free(p->buffer - 1);
+    free(p->shown);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -280,19 +291,110 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
-void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[] = {SET_COL_ADDR, 0, p->width - 1, SET_PAGE_ADDR, 0, p->pages - 1};
-    if (p->width == 64) {
-        payload[1] += 32;
-        payload[2] += 32;
+// The address byte, the control byte and the six bytes of SET_COL_ADDR and
+// SET_PAGE_ADDR that open a window.
+#define WINDOW_COMMAND_BYTES 8
+// The address byte and the control byte in front of a run of data.
+#define DATA_HEADER_BYTES 2
+
+static bool ssd1306_changed_columns(const ssd1306_t *p, uint8_t page, uint8_t *first, uint8_t *last) {
+    const uint8_t *drawn = p->buffer + page * p->width;
+    const uint8_t *shown = p->shown + page * p->width;
+    if (!p->shown_valid) {
+        *first = 0;
+        *last = p->width - 1;
+        return true;
     }
+    int32_t left = 0;
+    while (left < p->width && drawn[left] == shown[left])
+        ++left;
+    if (left == p->width)
+        return false;
+    int32_t right = p->width - 1;
+    while (drawn[right] == shown[right])
+        --right;
+    *first = left;
+    *last = right;
+    return true;
+}
 
-    for (size_t i = 0; i < sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+// A window as wide as the display is one run of the buffer and goes in one
+// write, a narrower one takes a write per page.
+static size_t ssd1306_window_bytes(const ssd1306_t *p, uint8_t pages, uint8_t first, uint8_t last) {
+    const size_t width = last - first + 1;
+    if (width == p->width)
+        return WINDOW_COMMAND_BYTES + DATA_HEADER_BYTES + pages * width;
+    return WINDOW_COMMAND_BYTES + pages * (DATA_HEADER_BYTES + width);
+}
 
-    *(p->buffer - 1) = 0x40;
+static bool ssd1306_write_data(ssd1306_t *p, size_t offset, size_t len) {
+    // The byte in front of the run stands in for the control byte while it is
+    // written, as p->buffer - 1 does for the whole buffer.
+    uint8_t *start = p->buffer + offset - 1;
+    const uint8_t covered = *start;
+    *start = 0x40;
+    const bool written = fancy_write(p->i2c_i, p->address, start, len + 1, "ssd1306_show");
+    *start = covered;
+    memcpy(p->shown + offset, p->buffer + offset, len);
+    p->show_bytes += DATA_HEADER_BYTES + len;
+    return written;
+}
+
+static bool ssd1306_send_window(ssd1306_t *p, uint8_t first_page, uint8_t pages, uint8_t first, uint8_t last) {
+    const uint8_t column_offset = p->width == 64 ? 32 : 0;
+    const uint8_t cmds[] = {
+        0x00,
+        SET_COL_ADDR, first + column_offset, last + column_offset,
+        SET_PAGE_ADDR, first_page, first_page + pages - 1
+    };
+    bool written = fancy_write(p->i2c_i, p->address, cmds, sizeof(cmds), "ssd1306_show");
+    p->show_bytes += WINDOW_COMMAND_BYTES;
+    const size_t width = last - first + 1;
+    if (width == p->width)
+        return ssd1306_write_data(p, first_page * width, pages * width) && written;
+    for (uint8_t page = first_page; page < first_page + pages; ++page)
+        written = ssd1306_write_data(p, page * p->width + first, width) && written;
+    return written;
+}
 
-    fancy_write(p->i2c_i, p->address, p->buffer - 1, p->bufsize + 1, "ssd1306_show");
+void ssd1306_show(ssd1306_t *p) {
+    bool written = true;
+    uint8_t run_page = 0, run_pages = 0, run_first = 0, run_last = 0;
+    p->show_bytes = 0;
+    for (uint8_t page = 0; page < p->pages; ++page) {
+        uint8_t first, last;
+        if (!ssd1306_changed_columns(p, page, &first, &last)) {
+            if (run_pages)
+                written = ssd1306_send_window(p, run_page, run_pages, run_first, run_last) && written;
+            run_pages = 0;
+            continue;
+        }
+        if (run_pages) {
+            // Take this page into the window above it if the wider window
+            // costs no more than a window of its own.
+            const uint8_t merged_first = first < run_first ? first : run_first;
+            const uint8_t merged_last = last > run_last ? last : run_last;
+            if (ssd1306_window_bytes(p, run_pages + 1, merged_first, merged_last) <=
+                ssd1306_window_bytes(p, run_pages, run_first, run_last) + ssd1306_window_bytes(p, 1, first, last)) {
+                ++run_pages;
+                run_first = merged_first;
+                run_last = merged_last;
+                continue;
+            }
+            written = ssd1306_send_window(p, run_page, run_pages, run_first, run_last) && written;
+        }
+        run_page = page;
+        run_pages = 1;
+        run_first = first;
+        run_last = last;
+    }
+    if (run_pages)
+        written = ssd1306_send_window(p, run_page, run_pages, run_first, run_last) && written;
+    // After a failed write the display is not known to hold what was sent, so
+    // the next frame is sent whole.
+    p->shown_valid = written;
+    ++p->show_count;
+    p->show_bytes_total += p->show_bytes;
 }
 
 void ssd1306_show_unacked(ssd1306_t *p) {
@@ -310,6 +412,8 @@ void ssd1306_show_unacked(ssd1306_t *p) {
     *(p->buffer - 1) = 0x40;
 
     i2c_write_blocking(p->i2c_i, p->address, p->buffer - 1, p->bufsize + 1, false);
+    memcpy(p->shown, p->buffer, p->bufsize);
+    p->shown_valid = true;
 }
 
 void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
@@ -338,3 +442,10 @@ void ssd1306_dump_pbm(ssd1306_t *p) {
         printf(" \n");
     }
 }
+
+void ssd1306_print_stats(ssd1306_t *p) {
+    printf("Display: %lu frames, %u bytes last frame, %llu bytes per frame on average, %u for a whole frame\n",
+           (unsigned long) p->show_count, (unsigned) p->show_bytes,
+           (unsigned long long) (p->show_count ? p->show_bytes_total / p->show_count : 0),
+           (unsigned) ssd1306_window_bytes(p, p->pages, 0, p->width - 1));
+}
@@ -1,9 +1,15 @@
+#include <string.h>
+#include <hardware/dma.h>
 #include <hardware/sync.h>
-#include <memory.h>
+#include <pico/multicore.h>
 #include "diskio.h"
 #include "ff.h"
 #include "../platform_config.h"
 
+static volatile bool core1_lockout = false;
+/* Both cores read files, so each has a DMA channel of its own. */
+static int read_channels[NUM_CORES] = {-1, -1};
+
 /*-----------------------------------------------------------------------*/
 /* Read Sector(s)                                                        */
 /*-----------------------------------------------------------------------*/
@@ -15,7 +21,22 @@ DRESULT disk_read(
         UINT count        /* Number of sectors to read (1..128) */
 ) {
     (void) pdrv;
-    memcpy(buff, (void *) (FLASH_MMAP_ADDR + sector * FLASH_SECTOR_SIZE), count * FLASH_SECTOR_SIZE);
+    /* Copied through the uncached alias of the flash, so that whole clusters
+       read into a tune's memory don't push the code out of the XIP cache.
+       Sector buffers are word aligned and go by DMA. The destination of a
+       long read may not be, and is left to memcpy. */
+    const void *flash = (const void *) (XIP_NOCACHE_NOALLOC_BASE + FLASH_BASE_ADDR + sector * FLASH_SECTOR_SIZE);
+    const int channel = read_channels[get_core_num()];
+    if (channel < 0 || ((uintptr_t) buff & 3)) {
+        memcpy(buff, flash, count * FLASH_SECTOR_SIZE);
+        return RES_OK;
+    }
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    dma_channel_configure(channel, &c, buff, flash, count * FLASH_SECTOR_SIZE / 4, true);
+    dma_channel_wait_for_finish_blocking(channel);
     return RES_OK;
 }
 
@@ -31,13 +52,32 @@ DRESULT disk_write(
 ) {
     (void) pdrv;
 
+    /* Core1 hands its writes to core0, see System::runOnCore0(). */
+    if (get_core_num() != 0) {
+        return RES_WRPRT;
+    }
+
+    /* The flash can't be read while it is erased or programmed, so core1,
+       which runs from it too, is held in RAM for the duration. A core1 that
+       doesn't answer in time fails the write rather than hang core0. */
+    const bool lockout = core1_lockout;
+    if (lockout && !multicore_lockout_start_timeout_us(FLASH_LOCKOUT_TIMEOUT_US)) {
+        return RES_ERROR;
+    }
     uint32_t ints = save_and_disable_interrupts();
     flash_range_erase(FLASH_BASE_ADDR + sector * FLASH_SECTOR_SIZE, count * FLASH_SECTOR_SIZE);
     flash_range_program(FLASH_BASE_ADDR + sector * FLASH_SECTOR_SIZE, buff, count * FLASH_SECTOR_SIZE);
     restore_interrupts(ints);
+    if (lockout) {
+        multicore_lockout_end_timeout_us(FLASH_LOCKOUT_TIMEOUT_US);
+    }
     return RES_OK;
 }
 
+void disk_enable_core1_lockout(bool enable) {
+    core1_lockout = enable;
+}
+
 
 /*-----------------------------------------------------------------------*/
 /* Miscellaneous Functions                                               */
@@ -47,6 +87,11 @@ DSTATUS disk_initialize(
         BYTE pdrv                /* Physical drive nmuber to identify the drive */
 ) {
     (void) pdrv;
+    if (read_channels[0] < 0) {
+        for (int core = 0; core < NUM_CORES; core++) {
+            read_channels[core] = dma_claim_unused_channel(false);
+        }
+    }
     return RES_OK;
 }
 
@@ -5,6 +5,7 @@
 #ifndef _DISKIO_DEFINED
 #define _DISKIO_DEFINED
 
+#include <stdbool.h>
 #include "ff.h"
 
 #ifdef __cplusplus
@@ -38,6 +39,10 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count);
 
 DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff);
 
+/* Once core1 runs as a multicore lockout victim, writes park it while the
+   flash is erased and programmed. */
+void disk_enable_core1_lockout(bool enable);
+
 
 /* Disk Status Bits (DSTATUS) */
 
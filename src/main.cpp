@@ -3,10 +3,12 @@
 #include <device/usbd.h>
 #include <hardware/watchdog.h>
 #include "platform_config.h"
+#include "audio/AudioStats.h"
 #include "audio/SIDPlayer.h"
 #include "UI.h"
 #include "System.h"
 #include "Catalog.h"
+#include "visualization/RegisterSpectrum.h"
 
 using namespace std;
 
@@ -33,6 +35,31 @@ bool awaitButtonRelease() {
     return c >= LONG_PRESS_DURATION_MS;
 }
 
+// Prints the render statistics or the render trace of the audio core when
+// asked to over stdio, records a SID register stream for the selected tune,
+// fast-forwards the current song, switches the source of the spectrum or
+// prints the display statistics.
+void handleAudioRequest() {
+    const int request = getchar_timeout_us(0);
+    if (request == AUDIO_STATS_DUMP_KEY) {
+        if (SIDPlayer::isPlaying()) {
+            const SidInfo *info = SIDPlayer::getSidInfo();
+            printf("%s - %s, song %d\n", info->author, info->name, SIDPlayer::getCurrentSong() + 1);
+        }
+        AudioStats::print();
+    } else if (request == AUDIO_STATS_TRACE_KEY) {
+        AudioStats::printTrace();
+    } else if (request == SID_STREAM_RECORD_KEY) {
+        SIDPlayer::recordSelectedTune();
+    } else if (request == SEEK_FORWARD_KEY) {
+        SIDPlayer::fastForward(SEEK_STEP_MS);
+    } else if (request == SPECTRUM_SOURCE_KEY) {
+        Visualization::RegisterSpectrum::toggle();
+    } else if (request == DISPLAY_STATS_KEY) {
+        UI::printDisplayStats();
+    }
+}
+
 #if USE_BUDDY
 void initUart() {
     uart_init(UART_ID, 2400);
@@ -72,6 +99,9 @@ void initUart() {
     }
     while (true) {
         UI::updateUI();
+        handleAudioRequest();
+        C64::serviceParallelRendering();
+        System::serviceCore1Jobs();
     }
 }
 #pragma clang diagnostic pop
@@ -2,6 +2,19 @@
 
 #define IS_BIT_SET(value, bit) (((value) & (1 << (bit))) != 0)
 
+// With USE_HOT_SRAM the SID rendering, the mixer and the 6502 core run from
+// SRAM, together with the tables they read on every sample or instruction,
+// so core0 pulling fonts, images or files through the XIP cache can't evict
+// them and stretch the time a buffer takes to render.
+#if USE_HOT_SRAM
+#include "pico/platform.h"
+#define HOT_FUNC(name)                      __not_in_flash("sidpod." #name) name
+#define HOT_DATA                            __not_in_flash("sidpod_data")
+#else
+#define HOT_FUNC(name)                      name
+#define HOT_DATA
+#endif
+
 #ifndef USE_SDCARD
 #include "hardware/flash.h"
 
@@ -15,6 +28,8 @@
 #define SECTOR_COUNT                        (FLASH_STORAGE_BYTES / FLASH_SECTOR_SIZE)
 #define FLASH_BASE_ADDR                     (PICO_FLASH_SIZE_BYTES - FLASH_STORAGE_BYTES)
 #define FLASH_MMAP_ADDR                     (XIP_BASE + FLASH_BASE_ADDR)
+// How long a flash write waits for core1 to be parked, and let go again.
+#define FLASH_LOCKOUT_TIMEOUT_US            100000
 
 #endif
 
@@ -41,20 +56,71 @@
 #define FS_LABEL                            "SIDPOD"
 
 #define AUDIO_RENDERING_STARTED_FIFO_FLAG   124
+#define RENDER_EXTRA_SIDS_FIFO_FLAG         125
 
 #define PSID_HEADER_SIZE                    ((uint8_t) 0x7e)
 #define PSID_MINIMAL_HEADER_SIZE            ((uint8_t) 0x56)
 #define PSID_ID                             0x50534944
 #define RSID_ID                             0x52534944
-#define SID_LOAD_BUFFER_SIZE                ((int) 256)
 #define CPU_JSR_WATCHDOG_ABORT_LIMIT        0xffff
+#define SID_WRITE_QUEUE_SIZE                512
 
+// The output sample rate is picked per tune, from the single or multi SID
+// rate below unless a rate is set for the device in the SAMPLE_RATE_FILE
+// settings file. A buffer holds a 50th of a second at any rate.
 #define SAMPLE_RATE                         ((uint32_t)44100)
-#define MAX_SAMPLES_PER_BUFFER              880
-#define PAL_SPEED_FACTOR                    1.0f
-#define NTSC_SPEED_FACTOR                   0.96f
+#define SINGLE_SID_SAMPLE_RATE              SAMPLE_RATE
+#define MULTI_SID_SAMPLE_RATE               SAMPLE_RATE
+#define MAX_SAMPLE_RATE                     ((uint32_t)48000)
+#define BUFFERS_PER_SECOND                  50
+#define MAX_SAMPLES_PER_BUFFER              ((int) (MAX_SAMPLE_RATE / BUFFERS_PER_SECOND))
+#define SAMPLE_RATE_FILE                    "sample_rate"
+#define PAL_CYCLES_PER_FRAME                19656
+#define NTSC_CYCLES_PER_FRAME               17095
 #define NTSC_CPU_FREQUENCY                  1022730
 #define PAL_CPU_FREQUENCY                   985248
+#define SINGLE_SID_SAMPLING_METHOD          SAMPLE_RESAMPLE
+#define MULTI_SID_SAMPLING_METHOD           SAMPLE_FAST
+// A tune can have a sampling method of its own, for all or some of its songs,
+// in a settings file named after it with SAMPLING_FILE_EXTENSION.
+#define SAMPLING_FILE_EXTENSION             ".sampling"
+#define MAX_SONGS                           256
+
+// The I2S output plays from a queue of AUDIO_I2S_BUFFER_COUNT buffers of
+// AUDIO_I2S_BUFFER_SAMPLES each, which is as far as the audio core can run
+// ahead of it. The producer pool core1 renders into has as many buffers, so
+// taking one never waits on the queue being copied out of.
+// sidpod-render -p tries other depths against a render trace.
+#define AUDIO_I2S_BUFFER_COUNT              6
+#define AUDIO_I2S_BUFFER_SAMPLES            441
+
+#define AUDIO_STATS_DUMP_KEY                's'
+#define AUDIO_STATS_TRACE_KEY               't'
+
+// A tune with a SID register stream next to the settings, recorded for its
+// start song, is played back from the stream instead of through the 6502.
+// SID_STREAM_RECORD_KEY records one while the player is idle.
+#define SID_STREAM_FILE_EXTENSION           ".sidstream"
+#define SID_STREAM_BUFFER_SIZE              512
+#define SID_STREAM_RECORD_SECONDS           300
+#define SID_STREAM_RECORD_KEY               'r'
+
+// The song playing when the SIDPod is put to sleep is saved to the
+// SNAPSHOT_FILE settings file, and carries on from there when it wakes up.
+#define SNAPSHOT_FILE                       "snapshot"
+#define SNAPSHOT_BUFFER_SIZE                512
+#define SNAPSHOT_PARK_TIMEOUT_MS            500
+
+// SEEK_FORWARD_KEY runs the current song forward by SEEK_STEP_MS.
+#define SEEK_FORWARD_KEY                    'f'
+#define SEEK_STEP_MS                        30000
+
+// SPECTRUM_SOURCE_KEY switches the visualization between the FFT of the audio
+// and a spectrum made up from the SID voice registers.
+#define SPECTRUM_SOURCE_KEY                 'v'
+
+// DISPLAY_STATS_KEY prints how many bytes each display update has sent.
+#define DISPLAY_STATS_KEY                   'd'
 
 #define AMP_CONTROL_PIN                     15
 
@@ -90,8 +156,10 @@
 #define SONG_LIST_LEFT_MARGIN               6
 #define NOW_PLAYING_SYMBOL_HEIGHT           5
 #define NOW_PLAYING_SYMBOL_ANIMATION_SPEED  ((float) 0.1)
-#define DEFAULT_SPECTRUM_COMPENSATION       ((double ) 0.00002)
-#define LINE_LEVEL_SPECTRUM_COMPENSATION    ((double ) 0.00000003)
+// Bar heights per unit of spectrum, in 1/65536ths. The FixedFFT bins are the
+// spectrum divided by FFT_SAMPLES, and halved again by the window.
+#define DEFAULT_SPECTRUM_COMPENSATION       2684
+#define LINE_LEVEL_SPECTRUM_COMPENSATION    4
 #define HORIZONTAL_LANDSCAPE_LINES          (DISPLAY_HEIGHT / 2)
 #define SOUND_SPRITE_COUNT                  (DISPLAY_HEIGHT * DISPLAY_WIDTH / 8)
 #define ROUND_SPRITE_COUNT                  (DISPLAY_WIDTH / 2)
@@ -102,7 +170,7 @@
 #define END_SPHERE_SCENE_AFTER              35000
 #define FROM_ALTERNATIVE_TRANSITION_DURATION       8600
 #define SCROLL_LIMIT                        (-1000)
-#define FFT_SAMPLES                         1000
+#define FFT_SAMPLES                         1024
 #define LOW_FREQ_DOMINANCE_COMP_OFFSET      2
 #define SIDPLAYER_STARTUP_GRACE_TIME        800
 #define SONG_NUMBER_DISPLAY_DURATION        3000
@@ -2,10 +2,12 @@
 
 #include "Catalog.h"
 #include "../platform_config.h"
-#include "kiss_fftr.h"
+#include "FixedFFT.h"
+#include "RegisterSpectrum.h"
 #include "../System.h"
 #include "../audio/SIDPlayer.h"
 #include "../audio/C64.h"
+#include "../audio/VisualizationCapture.h"
 #include "../UI.h"
 
 char experience[20];
@@ -18,7 +20,7 @@ namespace Visualization {
         for (int i = 2; i < HORIZONTAL_LANDSCAPE_LINES; i++) {
             fibonacci[i] = fibonacci[i - 1] + fibonacci[i - 2];
         }
-        fft_cfg = kiss_fftr_alloc(FFT_SAMPLES, false, nullptr, nullptr);
+        FixedFFT::init();
     }
 
     void DanceFloor::drawScroller() {
@@ -209,13 +211,11 @@ namespace Visualization {
         if (sphereRotationY > 360) sphereRotationY -= 360;
     }
 
-    void DanceFloor::drawScene(const kiss_fft_cpx *fft_out) {
+    void DanceFloor::drawScene(const SpectrumBin *spectrum) {
         int totalY = 0;
         for (uint8_t x = LOW_FREQ_DOMINANCE_COMP_OFFSET; x < 127 + LOW_FREQ_DOMINANCE_COMP_OFFSET; x++) {
             const int i = static_cast<int>(1.8) * x;
-            int y = static_cast<int>((fft_out[i].r + fft_out[i].i +
-                                      fft_out[i + 1].r + fft_out[i + 1].i + static_cast<float>(i)) *
-                                     compFactor);
+            int y = (spectrum[i].r + spectrum[i].i + spectrum[i + 1].r + spectrum[i + 1].i) * compFactor >> 16;
             if (y > 0) {
                 if (y > 28) y /= 8;
                 totalY += y;
@@ -388,11 +388,16 @@ namespace Visualization {
             compFactor = DEFAULT_SPECTRUM_COMPENSATION;
             if (SIDPlayer::isPlaying()) {
                 freeze = false;
-                int j = 0;
-                for (int i = 0; i < FFT_SAMPLES; i += 1) {
-                    fftIn[j++] = visualizationBuffer[i];
+                if (RegisterSpectrum::isEnabled()) {
+                    RegisterSpectrum::transform(fftOut);
+                } else {
+                    // A window core1 started writing over while it was transformed is taken again.
+                    uint32_t sequence;
+                    while (const short *window = VisualizationCapture::latest(sequence)) {
+                        FixedFFT::transform(window, fftOut);
+                        if (VisualizationCapture::stillValid(sequence)) break;
+                    }
                 }
-                kiss_fftr(fft_cfg, fftIn, fftOut);
 
                 drawScene(fftOut);
             } else if (!SIDPlayer::loadingWasSuccessful()) {
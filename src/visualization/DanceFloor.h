@@ -3,9 +3,8 @@
 
 #include "GL.h"
 #include "../platform_config.h"
-#include "kiss_fft.h"
+#include "FixedFFT.h"
 #include "../Playlist.h"
-#include "kiss_fftr.h"
 #include "System.h"
 
 namespace Visualization {
@@ -85,7 +84,7 @@ namespace Visualization {
 
         void drawStarShip();
 
-        void drawScene(const kiss_fft_cpx *fft_out);
+        void drawScene(const SpectrumBin *spectrum);
 
         static void randomizeExperience(char *experience);
 
@@ -111,8 +110,7 @@ namespace Visualization {
         volatile bool freeze = false;
         volatile bool showScroller = false;
         bool scrollerInitialized = false;
-        kiss_fftr_cfg fft_cfg{};
-        double compFactor = DEFAULT_SPECTRUM_COMPENSATION;
+        int32_t compFactor = DEFAULT_SPECTRUM_COMPENSATION;
         bool alternativeScene = false;
         bool starFieldVisible = false;
         bool sphereScene = false;
@@ -164,8 +162,7 @@ namespace Visualization {
             {127, 10}
         };
         uint16_t fibonacci[HORIZONTAL_LANDSCAPE_LINES]{};
-        kiss_fft_scalar fftIn[FFT_SAMPLES]{};
-        kiss_fft_cpx fftOut[FFT_SAMPLES]{};
+        SpectrumBin fftOut[FFT_BINS]{};
         GL *gl;
     };
 }
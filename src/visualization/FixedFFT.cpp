@@ -0,0 +1,93 @@
+#include "FixedFFT.h"
+
+#include <cmath>
+
+#define HALF_SAMPLES        (FFT_SAMPLES / 2)
+
+static_assert((FFT_SAMPLES & (FFT_SAMPLES - 1)) == 0, "FFT_SAMPLES must be a power of two");
+
+namespace Visualization {
+    int16_t FixedFFT::window[FFT_SAMPLES];
+    int16_t FixedFFT::cosine[HALF_SAMPLES];
+    int16_t FixedFFT::sine[HALF_SAMPLES];
+    uint16_t FixedFFT::reversed[HALF_SAMPLES];
+    SpectrumBin FixedFFT::work[HALF_SAMPLES];
+
+    void FixedFFT::init() {
+        for (int n = 0; n < FFT_SAMPLES; n++) {
+            window[n] = static_cast<int16_t>(lroundf(16383.5f * (1 - cosf(2 * M_PI * n / FFT_SAMPLES))));
+        }
+        for (int k = 0; k < HALF_SAMPLES; k++) {
+            cosine[k] = static_cast<int16_t>(lroundf(32767 * cosf(2 * M_PI * k / FFT_SAMPLES)));
+            sine[k] = static_cast<int16_t>(lroundf(32767 * sinf(2 * M_PI * k / FFT_SAMPLES)));
+        }
+        for (int n = 0; n < HALF_SAMPLES; n++) {
+            int mirrored = 0;
+            for (int bit = 1, mirror = HALF_SAMPLES >> 1; bit < HALF_SAMPLES; bit <<= 1, mirror >>= 1) {
+                if (n & bit) {
+                    mirrored |= mirror;
+                }
+            }
+            reversed[n] = mirrored;
+        }
+    }
+
+    /* The even samples go in as the real parts and the odd ones as the
+       imaginary parts, at half scale, so that no butterfly can take a part
+       past full scale. */
+    void FixedFFT::transform(const short *samples, SpectrumBin *bins) {
+        for (int n = 0; n < HALF_SAMPLES; n++) {
+            work[reversed[n]] = {
+                static_cast<int16_t>(samples[2 * n] * window[2 * n] >> 16),
+                static_cast<int16_t>(samples[2 * n + 1] * window[2 * n + 1] >> 16)
+            };
+        }
+        butterflies();
+        split(bins);
+    }
+
+    // Each twiddle is looked up once per stage and used for every butterfly it belongs to.
+    void FixedFFT::butterflies() {
+        for (int size = 2, step = HALF_SAMPLES; size <= HALF_SAMPLES; size <<= 1, step >>= 1) {
+            const int half = size >> 1;
+            for (int j = 0; j < half; j++) {
+                const int32_t c = cosine[j * step];
+                const int32_t s = sine[j * step];
+                for (int k = j; k < HALF_SAMPLES; k += size) {
+                    SpectrumBin &a = work[k];
+                    SpectrumBin &b = work[k + half];
+                    const int32_t tr = (b.r * c + b.i * s) >> 15;
+                    const int32_t ti = (b.i * c - b.r * s) >> 15;
+                    const int32_t ar = a.r;
+                    const int32_t ai = a.i;
+                    a = {static_cast<int16_t>((ar + tr) >> 1), static_cast<int16_t>((ai + ti) >> 1)};
+                    b = {static_cast<int16_t>((ar - tr) >> 1), static_cast<int16_t>((ai - ti) >> 1)};
+                }
+            }
+        }
+    }
+
+    /* Pulls the spectra of the even and the odd samples out of the complex
+       FFT, and puts them together into bins k and HALF_SAMPLES - k, as
+       kiss_fftr does. Halving the terms first keeps the products in 32 bits. */
+    void FixedFFT::split(SpectrumBin *bins) {
+        const int32_t dcr = work[0].r;
+        const int32_t dci = work[0].i;
+        bins[0] = {static_cast<int16_t>(dcr + dci), 0};
+        bins[HALF_SAMPLES] = {static_cast<int16_t>(dcr - dci), 0};
+        for (int k = 1; k <= HALF_SAMPLES / 2; k++) {
+            const SpectrumBin zk = work[k];
+            const SpectrumBin znk = work[HALF_SAMPLES - k];
+            const int32_t f1r = (zk.r + znk.r) >> 1;
+            const int32_t f1i = (zk.i - znk.i) >> 1;
+            const int32_t f2r = (zk.r - znk.r) >> 1;
+            const int32_t f2i = (zk.i + znk.i) >> 1;
+            const int32_t c = cosine[k];
+            const int32_t s = sine[k];
+            const int32_t twr = (f2i * c - f2r * s) >> 15;
+            const int32_t twi = -(f2r * c + f2i * s) >> 15;
+            bins[k] = {static_cast<int16_t>(f1r + twr), static_cast<int16_t>(f1i + twi)};
+            bins[HALF_SAMPLES - k] = {static_cast<int16_t>(f1r - twr), static_cast<int16_t>(twi - f1i)};
+        }
+    }
+}
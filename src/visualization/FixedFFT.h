@@ -0,0 +1,44 @@
+#ifndef SIDPOD_FIXEDFFT_H
+#define SIDPOD_FIXEDFFT_H
+
+#include <cstdint>
+
+#include "../platform_config.h"
+
+#define FFT_BINS            (FFT_SAMPLES / 2 + 1)
+
+namespace Visualization {
+    struct SpectrumBin {
+        int16_t r;
+        int16_t i;
+    };
+
+    /*
+     * A real FFT of FFT_SAMPLES points in Q15 fixed point, for a core without
+     * an FPU. The samples are Hann windowed and packed in pairs into a complex
+     * FFT of half the length, done in place with radix-2 butterflies, and the
+     * two halves are then pulled apart into the spectrum of the real signal.
+     * Every stage halves what it adds up, so nothing overflows and the bins
+     * come out as the spectrum divided by FFT_SAMPLES. The window, the bit
+     * reversal and the twiddles are worked out once, by init().
+     */
+    class FixedFFT {
+    public:
+        static void init();
+
+        static void transform(const short *samples, SpectrumBin *bins);
+
+    private:
+        static int16_t window[FFT_SAMPLES];
+        static int16_t cosine[FFT_SAMPLES / 2];
+        static int16_t sine[FFT_SAMPLES / 2];
+        static uint16_t reversed[FFT_SAMPLES / 2];
+        static SpectrumBin work[FFT_SAMPLES / 2];
+
+        static void butterflies();
+
+        static void split(SpectrumBin *bins);
+    };
+}
+
+#endif //SIDPOD_FIXEDFFT_H
@@ -0,0 +1,84 @@
+#include "RegisterSpectrum.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "../audio/C64.h"
+
+#define WAVEFORM_TRIANGLE   0x1
+#define WAVEFORM_SAWTOOTH   0x2
+#define WAVEFORM_PULSE      0x4
+#define WAVEFORM_NOISE      0x8
+#define HARMONICS           8
+// Bins of noise shown from the pitch of a noise voice upwards.
+#define NOISE_BINS          32
+
+// Harmonic levels of each waveform in 1/256ths, from the fundamental up: 1/n
+// for a sawtooth, the odd ones of that for a square pulse, and 1/n^2 of the
+// odd ones for a triangle.
+static constexpr uint8_t sawtoothWeights[HARMONICS] = {255, 128, 85, 64, 51, 43, 37, 32};
+static constexpr uint8_t pulseWeights[HARMONICS] = {255, 0, 85, 0, 51, 0, 37, 0};
+static constexpr uint8_t triangleWeights[HARMONICS] = {255, 0, 28, 0, 10, 0, 5, 0};
+
+namespace Visualization {
+    bool RegisterSpectrum::enabled = false;
+
+    static void addToBin(SpectrumBin &bin, int32_t level) {
+        const int32_t sum = bin.r + level;
+        bin.r = static_cast<int16_t>(sum > INT16_MAX ? INT16_MAX : sum);
+    }
+
+    void RegisterSpectrum::transform(SpectrumBin *bins) {
+        memset(bins, 0, FFT_BINS * sizeof(SpectrumBin));
+        VoiceReadout voices[MAX_VOICES];
+        const int count = C64::readVoices(voices);
+        // Bins per step of the frequency register, in 8.24 fixed point.
+        const uint32_t clock = C64::getSidInfo()->isPAL ? PAL_CPU_FREQUENCY : NTSC_CPU_FREQUENCY;
+        const uint32_t binsPerStep = clock * FFT_SAMPLES / C64::getSampleRate();
+        for (int v = 0; v < count; v++) {
+            const VoiceReadout &voice = voices[v];
+            if (!voice.envelope || !voice.freq || !voice.waveform) continue;
+            // The bin of the pitch in 16.16, and a full envelope at about the
+            // level of a full scale sine in the FFT.
+            const uint32_t fundamental = voice.freq * binsPerStep >> 8;
+            const int32_t level = voice.envelope << 4;
+            if (voice.waveform & WAVEFORM_NOISE) {
+                const uint32_t first = fundamental >> 16;
+                for (uint32_t bin = first; bin < first + NOISE_BINS && bin < FFT_BINS; bin++) {
+                    addToBin(bins[bin], level >> 3);
+                }
+            } else if (voice.waveform & WAVEFORM_SAWTOOTH) {
+                addHarmonics(bins, fundamental, level, sawtoothWeights, 0);
+            } else if (voice.waveform & WAVEFORM_PULSE) {
+                if (!voice.pw) continue;
+                // The further the pulse is from square, the stronger the even harmonics.
+                const int32_t offSquare = voice.pw > 0x800 ? voice.pw - 0x800 : 0x800 - voice.pw;
+                addHarmonics(bins, fundamental, level, pulseWeights, offSquare >> 3);
+            } else {
+                addHarmonics(bins, fundamental, level, triangleWeights, 0);
+            }
+        }
+    }
+
+    void RegisterSpectrum::addHarmonics(SpectrumBin *bins, uint32_t fundamental, int32_t level,
+                                        const uint8_t *weights, int32_t evenWeight) {
+        for (int n = 0; n < HARMONICS; n++) {
+            const uint32_t bin = (n + 1) * fundamental >> 16;
+            if (bin >= FFT_BINS) break;
+            int32_t weight = weights[n];
+            if (n & 1) {
+                weight += sawtoothWeights[n] * evenWeight >> 8;
+            }
+            addToBin(bins[bin], level * weight >> 8);
+        }
+    }
+
+    void RegisterSpectrum::toggle() {
+        enabled = !enabled;
+        printf("Spectrum from %s\n", enabled ? "the SID registers" : "the FFT");
+    }
+
+    bool RegisterSpectrum::isEnabled() {
+        return enabled;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SIDPOD_REGISTERSPECTRUM_H
+#define SIDPOD_REGISTERSPECTRUM_H
+
+#include "FixedFFT.h"
+
+namespace Visualization {
+    /*
+     * A stand-in for the FFT, made up from what the SID voices are set to play
+     * rather than from the audio. Every sounding voice puts its envelope level
+     * at the bin of its pitch and of the first few harmonics its waveform has,
+     * at the same scale as the FixedFFT bins, and noise is spread over the
+     * bins above its pitch. It is a few hundred cycles a frame however many
+     * chips the tune uses, and every voice shows at its exact pitch.
+     */
+    class RegisterSpectrum {
+    public:
+        static void transform(SpectrumBin *bins);
+
+        static void toggle();
+
+        static bool isEnabled();
+
+    private:
+        static bool enabled;
+
+        static void addHarmonics(SpectrumBin *bins, uint32_t fundamental, int32_t level, const uint8_t *weights,
+                                 int32_t evenWeight);
+    };
+}
+
+#endif //SIDPOD_REGISTERSPECTRUM_H